@@ -0,0 +1,849 @@
+/*  Microbenchmarks of the container operations on the list, hybrid and matrix backends,
+ *  and of scans over the read-only compact and compressed copies.
+ *
+ *  Build: g++ -std=c++17 -O2 -pthread -Iinclude benchmark/benchmark.cpp -o graph_benchmark
+ *  Usage: graph_benchmark [--format csv|json] [--sizes 256,1024] [--degrees 4,32]
+ *                         [--repeat N] [--filter operation]
+ *
+ *  One record per (backend, weighted, directed, vertices, degree, operation) is written to stdout:
+ *  nanoseconds per operation and throughput of the fastest repetition, and heap allocations
+ *  per operation counted by the global operator new below.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+using namespace smart_graph;
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_allocated_bytes{0};
+
+}  // namespace
+
+namespace {
+
+#if defined(_MSC_VER)
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+// Every replaced operator new ends here, so each form is counted alike; nullptr when out of memory.
+void *Allocate(std::size_t bytes, std::size_t alignment = 0) noexcept
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  if (bytes == 0)
+    bytes = 1;
+  if (alignment <= alignof(std::max_align_t))
+    return std::malloc(bytes);
+
+#if defined(_MSC_VER)
+  return _aligned_malloc(bytes, alignment);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void *AllocateOrThrow(std::size_t bytes, std::size_t alignment = 0)
+{
+  if (void *p = Allocate(bytes, alignment))
+    return p;
+  throw std::bad_alloc();
+}
+
+void Release(void *p, std::size_t alignment = 0) noexcept
+{
+#if defined(_MSC_VER)
+  if (alignment > alignof(std::max_align_t)) {
+    _aligned_free(p);
+    return;
+  }
+#else
+  (void)alignment;
+#endif
+  std::free(p);
+}
+
+}  // namespace
+
+/*  The whole set of replaceable operators, plain, array, nothrow, sized and aligned, goes through
+ *  Allocate and Release. They all stay out of line: inlined on one side only, the compiler would see
+ *  free() called on what operator new returned, or operator delete on what malloc() returned.
+ */
+BENCHMARK_NOINLINE void *operator new(std::size_t bytes)
+{
+  return AllocateOrThrow(bytes);
+}
+
+BENCHMARK_NOINLINE void *operator new[](std::size_t bytes)
+{
+  return AllocateOrThrow(bytes);
+}
+
+BENCHMARK_NOINLINE void *operator new(std::size_t bytes, const std::nothrow_t&) noexcept
+{
+  return Allocate(bytes);
+}
+
+BENCHMARK_NOINLINE void *operator new[](std::size_t bytes, const std::nothrow_t&) noexcept
+{
+  return Allocate(bytes);
+}
+
+BENCHMARK_NOINLINE void *operator new(std::size_t bytes, std::align_val_t alignment)
+{
+  return AllocateOrThrow(bytes, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void *operator new[](std::size_t bytes, std::align_val_t alignment)
+{
+  return AllocateOrThrow(bytes, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void *operator new(std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return Allocate(bytes, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void *operator new[](std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return Allocate(bytes, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p, std::size_t) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p, std::size_t) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p, const std::nothrow_t&) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p, const std::nothrow_t&) noexcept
+{
+  Release(p);
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p, std::align_val_t alignment) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p, std::align_val_t alignment) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p, std::size_t, std::align_val_t alignment) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete(void *p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+BENCHMARK_NOINLINE void operator delete[](void *p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  Release(p, static_cast<std::size_t>(alignment));
+}
+
+namespace {
+
+// Results are folded in here so the optimizer can't drop the measured calls.
+volatile std::size_t g_sink;
+
+// Matrix sizes are template arguments; a weighted 1024 matrix already takes 2 MiB of stack in MakeSubgraph.
+constexpr std::size_t kMatrixSizes[] = {256, 1024};
+constexpr std::size_t kSubgraphVertices = 32;
+constexpr std::size_t kMaxErasedVertices = 256;
+constexpr unsigned kConstructionRounds = 8;
+constexpr unsigned kEdgeSizeRounds = 16;
+
+struct Options
+{
+  std::vector<std::size_t> sizes_ = {256, 1024, 4096};
+  std::vector<std::size_t> degrees_ = {4, 32};
+  unsigned repeat_ = 3;
+  bool json_ = false;
+  std::string filter_;
+};
+
+struct Workload
+{
+  std::size_t vertices_;
+  std::size_t degree_;
+  std::vector<Edge<true>> edges_;
+  std::vector<std::pair<index_t, index_t>> probes_;  // half existing edges, half random pairs
+};
+
+struct Sample
+{
+  double nanoseconds_;
+  std::uint64_t allocations_;
+  std::uint64_t bytes_;
+};
+
+class Stopwatch
+{
+public:
+  void Start() noexcept
+  {
+    allocations_ = g_allocations.load(std::memory_order_relaxed);
+    bytes_ = g_allocated_bytes.load(std::memory_order_relaxed);
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  void Stop() noexcept
+  {
+    auto stop = std::chrono::steady_clock::now();
+    sample_.nanoseconds_ = std::chrono::duration<double, std::nano>(stop - start_).count();
+    sample_.allocations_ = g_allocations.load(std::memory_order_relaxed) - allocations_;
+    sample_.bytes_ = g_allocated_bytes.load(std::memory_order_relaxed) - bytes_;
+  }
+
+  const Sample &Result() const noexcept
+  {
+    return sample_;
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t allocations_ = 0;
+  std::uint64_t bytes_ = 0;
+  Sample sample_{};
+};
+
+class Reporter
+{
+public:
+  explicit Reporter(const Options &options): options_(options)
+  {
+    if (!options_.json_)
+      std::printf("backend,weighted,directed,vertices,degree,operation,ops,ns_per_op,ops_per_sec,"
+                  "allocs_per_op,bytes_per_op\n");
+  }
+
+  bool Enabled(const char *operation) const noexcept
+  {
+    return options_.filter_.empty() || options_.filter_ == operation;
+  }
+
+  /*  body(watch) prepares its own state, then brackets exactly the measured region with
+   *  watch.Start() / watch.Stop(). The fastest of options.repeat_ runs is reported.
+   */
+  template <typename Body>
+  void Measure(const char *backend, bool weighted, bool directed, const Workload &workload,
+               const char *operation, std::size_t ops, Body &&body) const
+  {
+    if (!Enabled(operation) || ops == 0)
+      return;
+
+    Sample best{};
+    for (unsigned round = 0; round < options_.repeat_; ++round)
+    {
+      Stopwatch watch;
+      body(watch);
+      if (round == 0 || watch.Result().nanoseconds_ < best.nanoseconds_)
+        best = watch.Result();
+    }
+
+    double ns = best.nanoseconds_ / static_cast<double>(ops);
+    double throughput = ns > 0 ? 1e9 / ns : 0;
+    double allocs = static_cast<double>(best.allocations_) / static_cast<double>(ops);
+    double bytes = static_cast<double>(best.bytes_) / static_cast<double>(ops);
+    const char *format = options_.json_ ?
+      "{\"backend\":\"%s\",\"weighted\":%d,\"directed\":%d,\"vertices\":%zu,\"degree\":%zu,"
+      "\"operation\":\"%s\",\"ops\":%zu,\"ns_per_op\":%.2f,\"ops_per_sec\":%.0f,"
+      "\"allocs_per_op\":%.3f,\"bytes_per_op\":%.1f}\n" :
+      "%s,%d,%d,%zu,%zu,%s,%zu,%.2f,%.0f,%.3f,%.1f\n";
+    std::printf(format, backend, weighted, directed, workload.vertices_, workload.degree_,
+                operation, ops, ns, throughput, allocs, bytes);
+    std::fflush(stdout);
+  }
+
+private:
+  const Options &options_;
+};
+
+Workload MakeWorkload(std::size_t vertices, std::size_t degree)
+{
+  Workload workload{vertices, degree, {}, {}};
+  std::mt19937_64 random(vertices * 131 + degree);
+  std::uniform_int_distribution<std::size_t> vertex(0, vertices - 1);
+  std::uniform_int_distribution<int> weight(1, 100);
+
+  workload.edges_.reserve(vertices * degree);
+  while (workload.edges_.size() < vertices * degree)
+  {
+    std::size_t start = vertex(random), dest = vertex(random);
+    if (start != dest)
+      workload.edges_.push_back(Edge<true>(static_cast<index_t>(start), static_cast<index_t>(dest),
+                                           static_cast<weight_t>(weight(random))));
+  }
+
+  workload.probes_.reserve(workload.edges_.size());
+  for (std::size_t i = 0; i < workload.edges_.size(); ++i)
+    if (i % 2 == 0)
+      workload.probes_.emplace_back(workload.edges_[i].start_, workload.edges_[i].destination_);
+    else
+      workload.probes_.emplace_back(static_cast<index_t>(vertex(random)), static_cast<index_t>(vertex(random)));
+  return workload;
+}
+
+template <typename G>
+void Populate(G &graph, const Workload &workload, bool edges = true)
+{
+  for (std::size_t v = 0; v < workload.vertices_; ++v)
+    graph.RegisterVertex(static_cast<index_t>(v), static_cast<index_t>(v));
+  if (edges)
+    for (auto &edge : workload.edges_)
+      graph.InsertEdge(edge.start_, edge.destination_, edge.weight_);
+}
+
+template <typename G, std::size_t... Index>
+decltype(auto) SubgraphOfFirst(G &graph, std::index_sequence<Index...>)
+{
+  return MakeSubgraph(graph, Index...);
+}
+
+template <typename Storage, bool Weighted, bool Directed, smart_graph::size_t Size>
+void RunSuite(const Workload &workload, const Reporter &reporter)
+{
+  constexpr bool kList = std::is_same_v<Storage, smart_graph_impl::AdjacentListTag>;
+  constexpr bool kMatrix = std::is_same_v<Storage, smart_graph_impl::AdjacentMatrixTag>;
+  using G = Graph<index_t, Weighted, Directed, kMatrix, Size, Storage>;
+  using EdgeType = typename G::edge_t;
+  const char *backend = kList ? "list" : kMatrix ? "matrix" : "hybrid";
+  const std::size_t n = workload.vertices_;
+  const std::size_t m = workload.edges_.size();
+
+  // matrices are too large for the stack, every graph lives on the heap
+  auto graph = std::make_unique<G>();
+  Populate(*graph, workload);
+
+  auto measure = [&](const char *operation, std::size_t ops, auto &&body) {
+    reporter.Measure(backend, Weighted, Directed, workload, operation, ops, body);
+  };
+
+  measure("RegisterVertex", n, [&](Stopwatch &watch) {
+    auto fresh = std::make_unique<G>();
+    watch.Start();
+    Populate(*fresh, workload, false);
+    watch.Stop();
+  });
+
+  measure("InsertEdge", m, [&](Stopwatch &watch) {
+    auto fresh = std::make_unique<G>();
+    Populate(*fresh, workload, false);
+    watch.Start();
+    for (auto &edge : workload.edges_)
+      g_sink = g_sink + fresh->InsertEdge(edge.start_, edge.destination_, edge.weight_);
+    watch.Stop();
+  });
+
+  measure("HasEdge", m, [&](Stopwatch &watch) {
+    std::size_t found = 0;
+    watch.Start();
+    for (auto &[start, dest] : workload.probes_)
+      found += graph->HasEdge(start, dest);
+    watch.Stop();
+    g_sink = g_sink + found;
+  });
+
+  measure("WeightOfEdge", m, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (auto &[start, dest] : workload.probes_)
+      total += static_cast<std::size_t>(graph->WeightOfEdge(start, dest));
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  // the same probes as one batch, list nodes of 16 probes in flight at once; and 8-step walks
+  // from every vertex one at a time and 16 at a time
+  if constexpr (kList) {
+    measure("WeightOfEdgesInterleaved", m, [&](Stopwatch &watch) {
+      std::vector<weight_t> weights;
+      watch.Start();
+      graph->WeightOfEdges(workload.probes_, weights);
+      watch.Stop();
+      g_sink = g_sink + weights.size();
+    });
+
+    std::vector<index_t> starts(n);
+    std::iota(starts.begin(), starts.end(), index_t{0});
+    for (std::size_t width : {std::size_t{1}, kInterleaveWidth})
+      measure(width == 1 ? "RandomWalks" : "RandomWalksInterleaved", n * 8, [&](Stopwatch &watch) {
+        std::vector<index_t> walks;
+        watch.Start();
+        graph->RandomWalks(starts, 8, 1, walks, width);
+        watch.Stop();
+        g_sink = g_sink + walks.back();
+      });
+  }
+
+  measure("GetEdgeOut", n, [&](Stopwatch &watch) {
+    std::vector<EdgeType> edges;
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t v = 0; v < n; ++v)
+      if (graph->GetEdgeOut(static_cast<index_t>(v), edges))
+        total += edges.size();
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  // lightest out-edge and the four lightest, by a scan and from the weight index; the indexed
+  // insert includes keeping the index sorted
+  if constexpr (Weighted && !kMatrix) {
+    auto indexed = std::make_unique<G>(std::as_const(*graph));
+    indexed->IndexWeights();
+
+    for (G *target : {graph.get(), indexed.get()})
+    {
+      bool index = target->WeightsIndexed();
+      measure(index ? "LightestOutIndexed" : "LightestOut", n, [&](Stopwatch &watch) {
+        std::size_t total = 0;
+        watch.Start();
+        for (std::size_t v = 0; v < n; ++v)
+          total += target->GetEdgeOut(static_cast<index_t>(v), EdgeWeight::MIN).destination_;
+        watch.Stop();
+        g_sink = g_sink + total;
+      });
+
+      measure(index ? "Lightest4OutIndexed" : "Lightest4Out", n, [&](Stopwatch &watch) {
+        std::vector<EdgeType> edges;
+        std::size_t total = 0;
+        watch.Start();
+        for (std::size_t v = 0; v < n; ++v)
+          if (target->GetEdgeOut(static_cast<index_t>(v), EdgeWeight::MIN, 4, edges))
+            total += edges.size();
+        watch.Stop();
+        g_sink = g_sink + total;
+      });
+
+      // the lightest twentieth of the weights, by scanning every row or cutting the indexed ones
+      measure(index ? "EdgesInRangeIndexed" : "EdgesInRange", m, [&](Stopwatch &watch) {
+        std::vector<Edge<true>> edges;
+        watch.Start();
+        target->EdgesInRange(1, 5, edges);
+        watch.Stop();
+        g_sink = g_sink + edges.size();
+      });
+    }
+
+    measure("InsertEdgeIndexed", m, [&](Stopwatch &watch) {
+      auto fresh = std::make_unique<G>();
+      Populate(*fresh, workload, false);
+      fresh->IndexWeights();
+      watch.Start();
+      for (auto &edge : workload.edges_)
+        fresh->InsertEdge(edge.start_, edge.destination_, edge.weight_);
+      watch.Stop();
+      g_sink = g_sink + fresh->EdgeSize();
+    });
+  }
+
+  // the 100 lightest edges of the whole graph, from per-thread heaps
+  if constexpr (Weighted) {
+    measure("TopEdges", m, [&](Stopwatch &watch) {
+      std::vector<Edge<true>> edges;
+      watch.Start();
+      graph->TopEdges(EdgeWeight::MIN, 100, edges);
+      watch.Stop();
+      g_sink = g_sink + edges.size();
+    });
+  }
+
+  measure("Traverse", n, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t v = 0; v < n; ++v)
+      graph->ForEachOut(static_cast<index_t>(v), [&total](index_t dest, weight_t weight) {
+        total += dest + static_cast<std::size_t>(weight);
+      });
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("GetEdgeIn", n, [&](Stopwatch &watch) {
+    std::vector<EdgeType> edges;
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t v = 0; v < n; ++v)
+      if (graph->GetEdgeIn(static_cast<index_t>(v), edges))
+        total += edges.size();
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("Degree", n, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t v = 0; v < n; ++v)
+      total += graph->Degree(static_cast<index_t>(v));
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("EdgeSize", kEdgeSizeRounds, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (unsigned round = 0; round < kEdgeSizeRounds; ++round)
+      total += graph->EdgeSize();
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("CopyConstruct", kConstructionRounds, [&](Stopwatch &watch) {
+    std::vector<std::unique_ptr<G>> copies(kConstructionRounds);
+    // a non-const lvalue would bind to Graph's variadic container constructor instead
+    watch.Start();
+    for (auto &copy : copies)
+      copy = std::make_unique<G>(std::as_const(*graph));
+    watch.Stop();
+  });
+
+  measure("MoveConstruct", kConstructionRounds, [&](Stopwatch &watch) {
+    std::vector<std::unique_ptr<G>> sources(kConstructionRounds), targets(kConstructionRounds);
+    for (auto &source : sources)
+      source = std::make_unique<G>(std::as_const(*graph));
+    watch.Start();
+    for (unsigned round = 0; round < kConstructionRounds; ++round)
+      targets[round] = std::make_unique<G>(std::move(*sources[round]));
+    watch.Stop();
+  });
+
+  measure("MakeSubgraph", kConstructionRounds, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (unsigned round = 0; round < kConstructionRounds; ++round)
+    {
+      auto subgraph = std::make_unique<G>(SubgraphOfFirst(*graph, std::make_index_sequence<kSubgraphVertices>{}));
+      total += subgraph->VerticesSize();
+    }
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  // every other vertex, through the runtime-set path; one operation per vertex taken
+  measure("InducedSubgraph", (n + 1) / 2, [&](Stopwatch &watch) {
+    std::vector<bool> members(n);
+    for (std::size_t i = 0; i < n; i += 2)
+      members[i] = true;
+
+    watch.Start();
+    auto subgraph = std::make_unique<G>(MakeInducedSubgraph(*graph, members));
+    watch.Stop();
+    g_sink = g_sink + subgraph->VerticesSize();
+  });
+
+  measure("MakeTranspose", m, [&](Stopwatch &watch) {
+    watch.Start();
+    auto transposed = std::make_unique<G>(MakeTranspose(*graph));
+    watch.Stop();
+    g_sink = g_sink + transposed->VerticesSize();
+  });
+
+  // the same search on one graph and on four shards of it exchanging messages; one operation per edge
+  if constexpr (kList) {
+    auto sharded = MakeSharded(*graph, 4);
+    measure("ShortestPaths", m, [&](Stopwatch &watch) {
+      std::map<index_t, distance_t> distances;
+      watch.Start();
+      graph->ShortestPaths(0, distances);
+      watch.Stop();
+      g_sink = g_sink + distances.size();
+    });
+
+    measure("ShardedShortestPaths", m, [&](Stopwatch &watch) {
+      std::map<index_t, distance_t> distances;
+      watch.Start();
+      sharded.ShortestPaths(0, distances);
+      watch.Stop();
+      g_sink = g_sink + distances.size();
+    });
+  }
+
+  // snapshots of the versioned form of the graph, to set against CopyConstruct, and an edge erased
+  // right after each snapshot, which pays for copying the chunk table, a chunk and two vertices
+  if constexpr (kList) {
+    VersionedGraph<index_t, Weighted, Directed> versioned(*graph);
+    measure("Snapshot", n, [&](Stopwatch &watch) {
+      std::uint64_t total = 0;
+      watch.Start();
+      for (std::size_t i = 0; i < n; ++i)
+        total += versioned.Snapshot().VersionNumber();
+      watch.Stop();
+      g_sink = g_sink + total;
+    });
+
+    measure("EraseEdgeAfterSnapshot", m, [&](Stopwatch &watch) {
+      VersionedGraph<index_t, Weighted, Directed> copy(*graph);
+      std::vector<GraphSnapshot<index_t, Weighted, Directed>> history;
+      history.reserve(m);
+      watch.Start();
+      for (auto &edge : workload.edges_)
+      {
+        history.push_back(copy.Snapshot());
+        g_sink = g_sink + copy.EraseEdge(edge.start_, edge.destination_);
+      }
+      watch.Stop();
+    });
+  }
+
+  measure("EraseEdge", m, [&](Stopwatch &watch) {
+    auto copy = std::make_unique<G>(std::as_const(*graph));
+    watch.Start();
+    for (auto &edge : workload.edges_)
+      g_sink = g_sink + copy->EraseEdge(edge.start_, edge.destination_);
+    watch.Stop();
+  });
+
+  /*  a list walks the list of each neighbour up to the erased vertex, a hybrid erases it from each
+   *  neighbour's row and a matrix clears a whole row and column; an evenly spaced sample keeps the
+   *  graph around the erased vertices close to the original
+   */
+  std::size_t erased = std::min(n, kMaxErasedVertices);
+  measure("EraseVertex", erased, [&](Stopwatch &watch) {
+    auto copy = std::make_unique<G>(std::as_const(*graph));
+    watch.Start();
+    for (std::size_t i = 0; i < erased; ++i)
+      g_sink = g_sink + copy->EraseVertex(static_cast<index_t>(i * n / erased));
+    watch.Stop();
+  });
+}
+
+// Read-only copies of a list graph, the CSR arrays and their compressed form, scanned the same way.
+template <bool Weighted, bool Directed>
+void RunSnapshots(const Workload &workload, const Reporter &reporter)
+{
+  using G = Graph<index_t, Weighted, Directed, false>;
+  using EdgeType = typename G::edge_t;
+  const std::size_t n = workload.vertices_;
+  const std::size_t m = workload.edges_.size();
+
+  auto graph = std::make_unique<G>();
+  Populate(*graph, workload);
+  smart_graph_impl::CompactAdjacency<Weighted> compact(*graph);
+  CompressedAdjacency<Weighted> compressed(*graph);
+
+  auto measure = [&](const char *backend, const char *operation, std::size_t ops, auto &&body) {
+    reporter.Measure(backend, Weighted, Directed, workload, operation, ops, body);
+  };
+
+  measure("compact", "Traverse", n, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t position = 0; position < compact.VerticesSize(); ++position)
+      for (std::size_t arc = compact.ArcBegin(position), last = arc + compact.Degree(position); arc < last; ++arc)
+        total += compact.Target(arc) + static_cast<std::size_t>(compact.Weight(arc));
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("compact", "Transpose", compact.EdgeSize(), [&](Stopwatch &watch) {
+    auto copy = compact;
+    watch.Start();
+    copy.Transpose();
+    watch.Stop();
+    g_sink = g_sink + copy.EdgeSize();
+  });
+
+  // a PageRank-style pull over the arcs, reading per-vertex state at the targets, before and after RCM
+  auto gather = [](const smart_graph_impl::CompactAdjacency<Weighted> &adjacency) {
+    std::vector<double> state(adjacency.VerticesSize(), 1.0), next(adjacency.VerticesSize(), 0.0);
+    for (std::size_t position = 0; position < adjacency.VerticesSize(); ++position)
+      for (std::size_t arc = adjacency.ArcBegin(position), last = arc + adjacency.Degree(position); arc < last; ++arc)
+        next[position] += state[adjacency.Target(arc)];
+    return next.empty() ? 0.0 : next.back();
+  };
+
+  measure("compact", "OrderRCM", n, [&](Stopwatch &watch) {
+    VertexPermutation permutation;
+    watch.Start();
+    OrderVertices(*graph, VertexOrder::RCM, permutation);
+    watch.Stop();
+    g_sink = g_sink + permutation.Size();
+  });
+
+  VertexPermutation permutation;
+  OrderVertices(*graph, VertexOrder::RCM, permutation);
+  smart_graph_impl::CompactAdjacency<Weighted> reordered(RelabeledView<G>(*graph, permutation));
+
+  measure("compact", "Gather", compact.EdgeSize(), [&](Stopwatch &watch) {
+    watch.Start();
+    double total = gather(compact);
+    watch.Stop();
+    g_sink = g_sink + static_cast<std::size_t>(total);
+  });
+
+  measure("compact-rcm", "Gather", reordered.EdgeSize(), [&](Stopwatch &watch) {
+    watch.Start();
+    double total = gather(reordered);
+    watch.Stop();
+    g_sink = g_sink + static_cast<std::size_t>(total);
+  });
+
+  measure("compressed", "Traverse", n, [&](Stopwatch &watch) {
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t position = 0; position < compressed.VerticesSize(); ++position)
+      compressed.ForEachNeighbor(position, [&total](index_t target, weight_t weight) {
+        total += target + static_cast<std::size_t>(weight);
+      });
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("compressed", "GetEdgeOut", n, [&](Stopwatch &watch) {
+    std::vector<EdgeType> edges;
+    std::size_t total = 0;
+    watch.Start();
+    for (std::size_t v = 0; v < n; ++v)
+      if (compressed.GetEdgeOut(static_cast<index_t>(v), edges))
+        total += edges.size();
+    watch.Stop();
+    g_sink = g_sink + total;
+  });
+
+  measure("compressed", "HasEdge", m, [&](Stopwatch &watch) {
+    std::size_t found = 0;
+    watch.Start();
+    for (auto &[start, dest] : workload.probes_)
+      found += compressed.HasEdge(start, dest);
+    watch.Stop();
+    g_sink = g_sink + found;
+  });
+}
+
+template <typename Storage, smart_graph::size_t Size>
+void RunLayouts(const Workload &workload, const Reporter &reporter)
+{
+  RunSuite<Storage, false, false, Size>(workload, reporter);
+  RunSuite<Storage, false, true, Size>(workload, reporter);
+  RunSuite<Storage, true, false, Size>(workload, reporter);
+  RunSuite<Storage, true, true, Size>(workload, reporter);
+}
+
+void RunMatrix(const Workload &workload, const Reporter &reporter)
+{
+  switch (workload.vertices_)
+  {
+  case kMatrixSizes[0]:
+    RunLayouts<smart_graph_impl::AdjacentMatrixTag, kMatrixSizes[0]>(workload, reporter);
+    break;
+  case kMatrixSizes[1]:
+    RunLayouts<smart_graph_impl::AdjacentMatrixTag, kMatrixSizes[1]>(workload, reporter);
+    break;
+  default:
+    break;  // no matrix instantiated for this size
+  }
+}
+
+std::vector<std::size_t> ParseList(const char *text)
+{
+  std::vector<std::size_t> values;
+  for (const char *p = text; *p;)
+  {
+    char *end = nullptr;
+    unsigned long long value = std::strtoull(p, &end, 10);
+    if (end == p)
+      break;
+    values.push_back(static_cast<std::size_t>(value));
+    p = *end == ',' ? end + 1 : end;
+  }
+  return values;
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    bool has_value = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--format") && has_value)
+      options.json_ = !std::strcmp(argv[++i], "json");
+    else if (!std::strcmp(argv[i], "--sizes") && has_value)
+      options.sizes_ = ParseList(argv[++i]);
+    else if (!std::strcmp(argv[i], "--degrees") && has_value)
+      options.degrees_ = ParseList(argv[++i]);
+    else if (!std::strcmp(argv[i], "--repeat") && has_value)
+      options.repeat_ = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+    else if (!std::strcmp(argv[i], "--filter") && has_value)
+      options.filter_ = argv[++i];
+    else
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--format csv|json] [--sizes 256,1024] [--degrees 4,32] "
+                         "[--repeat N] [--filter operation]\n", argv[0]);
+    return 1;
+  }
+
+  Reporter reporter(options);
+  for (std::size_t vertices : options.sizes_)
+    for (std::size_t degree : options.degrees_)
+    {
+      if (vertices < 2 || vertices > 65535 || degree >= vertices)
+        continue;
+
+      Workload workload = MakeWorkload(vertices, degree);
+      RunLayouts<smart_graph_impl::AdjacentListTag, 0>(workload, reporter);
+      RunLayouts<smart_graph_impl::AdjacentHybridTag, 0>(workload, reporter);
+      RunMatrix(workload, reporter);
+      RunSnapshots<false, false>(workload, reporter);
+      RunSnapshots<true, true>(workload, reporter);
+    }
+  return 0;
+}
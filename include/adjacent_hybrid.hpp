@@ -0,0 +1,259 @@
+#ifndef ADJACENT_HYBRID_HPP_
+#define ADJACENT_HYBRID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <iostream>
+#include <vector>
+#include <queue>
+
+#include "delta.hpp"
+#include "edge.hpp"
+#include "instrumentation.hpp"
+#include "memory_usage.hpp"
+#include "parallel.hpp"
+#include "vertex_column.hpp"
+#include "weight_index.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+struct AdjacentHybridTag { };
+
+template <bool Weighted>
+class HybridRow
+{
+  /*  HybridRow holds the neighbours of one vertex, indexed by vertex id, in one of two layouts:
+   *  sparse, sorted targets with their weights beside them, or dense, a bit per id and for
+   *  weighted graphs a weight per id. Adapt switches the layout when the other one would be
+   *  smaller; a row only goes back to sparse once it takes under half the dense size, so
+   *  alternating inserts and erases at the threshold don't convert it every time.
+   */
+public:
+  bool IsDense() const noexcept;
+
+  std::size_t Degree() const noexcept;
+
+  // Weight of the arc to column, kConnected for non-weighted rows, kDisconnected if absent.
+  weight_t Find(index_t column) const noexcept;
+
+  // Insert the arc or change its weight; true when it is new.
+  bool Insert(index_t column, weight_t weight) noexcept;
+
+  bool Erase(index_t column) noexcept;
+
+  // Remove every arc whose column satisfies doomed(column) in one pass; returns how many went.
+  template <typename Predicate>
+  std::size_t EraseIf(Predicate&& doomed) noexcept;
+
+  /*  Merge a run of delta arcs sorted by column into the row, a single pass over a sparse row.
+   *  Marks applied[sequence_] of the primary arcs and returns the change of the degree.
+   */
+  std::ptrdiff_t Merge(const DeltaArc *first, const DeltaArc *last, std::uint8_t *applied) noexcept;
+
+  // Call visit(column, weight) in ascending column order.
+  template <typename Visitor>
+  void ForEach(Visitor&& visit) const noexcept;
+
+  // Pick the layout for the current degree; width is the number of columns a dense row needs.
+  void Adapt(std::size_t width) noexcept;
+
+  void Account(std::size_t &category, std::size_t &slack) const noexcept;
+
+  static std::size_t SparseBytes(std::size_t degree) noexcept;
+
+  static std::size_t DenseBytes(std::size_t width) noexcept;
+
+private:
+  static constexpr std::size_t kWordBits = 64;
+
+  void MakeDense(std::size_t width);
+
+  void MakeSparse();
+
+  std::vector<index_t> targets_;      // sparse only
+  std::vector<weight_t> weights_;     // beside targets_ when sparse, one per column when dense
+  std::vector<std::uint64_t> bits_;   // dense only
+  std::size_t degree_ = 0;
+  bool dense_ = false;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+class AdjacentHybrid
+{
+  /*  AdjacentHybrid has the interface of AdjacentList and AdjacentMatrix but no size fixed at
+   *  compile time: every vertex keeps its out-edges (and in-edges on directed graphs) in a
+   *  HybridRow, which stays a sorted array while the vertex is sparse and becomes a bit/weight
+   *  row over all ids once it is dense. A graph that fills up thus migrates to matrix storage
+   *  vertex by vertex, and a sparse one never pays for Size x Size cells.
+   */
+public:
+  using ValueType = Ty;
+  using ContainerType = AdjacentHybridTag;
+  using Self = AdjacentHybrid<Ty, Weighted, Directed>;
+  using EdgeType = Edge<Weighted>;
+
+protected:
+  using Row = HybridRow<Weighted>;
+
+  struct Node
+  {
+    Row out_;
+    Row in_;    // directed graphs only, undirected rows hold both directions
+  };
+
+  std::map<index_t, Node> list_;
+
+  // The vertex values, apart from the rows so that walking them never loads a value.
+  VertexColumn<Ty> values_;
+
+  // Off unless IndexWeights() turns it on.
+  WeightIndex<Directed> weight_index_;
+
+  std::size_t arcs_ = 0;
+
+public:
+  AdjacentHybrid();
+
+  ~AdjacentHybrid();
+
+  AdjacentHybrid(const AdjacentHybrid& rhs);
+
+  AdjacentHybrid(AdjacentHybrid&& rhs);
+
+  std::optional<Ty> At(index_t id) const;
+
+  template <typename Arg>
+  bool Emplace(size_t s, Arg&& value) noexcept;
+
+  template <typename... Args>
+  bool RegisterVertex(index_t index, Args &&... args) noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  // Removes the vertex and its edges in O(degree).
+  bool EraseVertex(index_t index) noexcept;
+
+  /*  Removes many vertices at once: they are tombstoned first, then every row is compacted once,
+   *  O(V + E) however many go. Vertices with few edges between them are erased one by one
+   *  instead. Returns how many of them existed.
+   */
+  std::size_t EraseVertices(const std::vector<index_t> &vertices) noexcept;
+
+  size_t VerticesSize() const noexcept;
+
+  // Number of stored arcs, kept up to date by every change: O(1).
+  size_t EdgeSize() const noexcept;
+
+  MemoryFootprint MemoryUsage() const noexcept;
+
+  // Arcs over the V * (V - 1) a complete graph would have.
+  double Density() const noexcept;
+
+  // Whether the out-edges of s are held in a dense row.
+  bool IsDense(index_t s) const noexcept;
+
+  // Number of rows (out and in) currently dense.
+  std::size_t DenseRows() const noexcept;
+
+  size_t Degree(index_t s) const noexcept;
+
+  size_t InDegree(index_t s) const noexcept;
+
+  size_t OutDegree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  bool HasEdge(const EdgeType &edge) const noexcept;
+
+  bool ExistsEdge(const EdgeType &edge) const noexcept;
+
+  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight) noexcept;
+
+  bool InsertEdge(const EdgeType &edge) noexcept;
+
+  bool EraseEdge(index_t start, index_t dest) noexcept;
+
+  // Removes the edges grouped by start, compacting each touched row once. Returns how many existed.
+  std::size_t EraseEdges(const std::vector<EdgeType> &edges) noexcept;
+
+  /*  Applies a batch of edge changes: they are sorted by the vertex whose list they touch and
+   *  merged into each row in one pass, the rows split between threads. Changes of the same
+   *  edge take effect in batch order. applied[i] is set to 1 when change i took effect: an
+   *  INSERT whose vertices exist, an ERASE or SET_WEIGHT of an existing edge. Returns how many did.
+   */
+  std::size_t ApplyDelta(const std::vector<EdgeDelta> &delta, std::vector<std::uint8_t> &applied, unsigned threads = 0) noexcept;
+
+  bool GetEdge(index_t s, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  Edge<true> GetEdgeIn(index_t destination, EdgeWeight type) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeInOrdered(index_t destination, Queue&& queue, bool append = false) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  Edge<true> GetEdgeOut(index_t start, EdgeWeight type) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeOutOrdered(index_t start, Queue&& queue, bool append = false) const noexcept;
+
+  // The k lightest (MIN) or heaviest (MAX) out-edges of start in that order, equal weights by ascending destination.
+  bool GetEdgeOut(index_t start, EdgeWeight type, std::size_t k, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, EdgeWeight type, std::size_t k, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  /*  Keep the edges of every vertex sorted by weight from now on, so GetEdgeOut and GetEdgeIn by
+   *  EdgeWeight take O(1) and their k forms O(k), at O(degree) more per change; false drops it.
+   */
+  void IndexWeights(bool enable = true) noexcept;
+
+  bool WeightsIndexed() const noexcept;
+
+  // Call visit(destination, weight) for every out-edge of start, in ascending destination order.
+  template<typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  // Call visit(start, weight) for every in-edge of dest, O(in-degree) for sparse rows.
+  template<typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  void Print() const noexcept;
+
+  template<bool Ascending>
+  decltype(auto) makeEdgeQueue() const noexcept;
+
+  decltype(auto) begin() const noexcept;
+
+  decltype(auto) end() const noexcept;
+
+protected:
+  // Columns a dense row needs to cover every registered id.
+  std::size_t Width() const noexcept;
+
+  const Row *InRow(index_t dest) const noexcept;
+
+  // Add or remove the arc start -> dest in the out row of start and the in row of dest.
+  bool Link(Node &start, index_t start_id, Node &dest, index_t dest_id, weight_t weight) noexcept;
+
+  bool Unlink(Node &start, index_t start_id, Node &dest, index_t dest_id) noexcept;
+
+  // Remove the sorted (row, column) arcs from the rows picked by row_of; returns how many existed.
+  template <typename RowOf>
+  std::size_t EraseArcs(const std::vector<std::pair<index_t, index_t>> &arcs, RowOf&& row_of) noexcept;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/adjacent_hybrid.inl"
+
+#endif //ADJACENT_HYBRID_HPP_
@@ -1,169 +1,330 @@
-#ifndef ADJACENT_HPP_
-#define ADJACENT_HPP_
-
-#include <map>
-#include <optional>
-#include <iostream>
-#include <string>
-#include <vector>
-#include <queue>
-
-#include "edge.hpp"
-
-namespace smart_graph {
-
-namespace smart_graph_impl {
-
-struct AdjacentListTag { };
-
-template <bool Weighted>
-struct LinkNode
-{
-
-};
-
-template <>
-struct LinkNode<true>
-{
-  index_t destination_;
-
-  weight_t weight_;
-
-  LinkNode *next_;
-
-  LinkNode(index_t i, weight_t w, LinkNode *n = nullptr) : destination_(i), weight_(w), next_(n) {}
-};
-
-template <>
-struct LinkNode<false>
-{
-  index_t destination_;
-
-  LinkNode *next_;
-
-  LinkNode(index_t i, LinkNode *n = nullptr) : destination_(i), next_(n) {}
-};
-
-template<bool Weighted>
-class InternalList
-{
-  /*  InternalList is a helper by which user can use operator[] to find the element in adjacent list
-   *  
-   *
-   */
-  using NodeType = LinkNode<Weighted>;
-  using NodePtr = NodeType*;
-
-  NodePtr head_;
-public:
-  InternalList(NodePtr head_ptr = nullptr);
-
-  InternalList(const InternalList& rhs);
-
-  weight_t operator[](index_t dest) const noexcept;
-
-  bool IsVaild() const noexcept;
-};
-
-template <typename Ty,
-          bool Weighted = false,
-          bool Directed = false>
-class AdjacentList
-{
-public:
-  using ValueType = Ty;
-  using ContainerType = AdjacentListTag;
-  using Self = AdjacentList<Ty, Weighted, Directed>;
-  using EdgeType = Edge<Weighted>;
-
-protected:
-  using LinkType = LinkNode<Weighted>;
-  using Link = LinkType *;
-  using Node = std::pair<Ty, Link>;
-
-  //using Iterator = UncheckedIterator<Self, false>;
-  friend class Iterator;
-
-  std::map<index_t, Node> list_;
-
-public:
-  AdjacentList();
-
-  ~AdjacentList();
-
-  AdjacentList(const AdjacentList& rhs);
-
-  AdjacentList(AdjacentList&& rhs);
-
-  std::optional<Ty> At(index_t id) const;
-
-  InternalList<Weighted> operator[](index_t pos) const noexcept;
-
-  template <typename Arg>
-  bool Emplace(size_t s, Arg&& value) noexcept;
-
-  template <typename... Args>
-  bool RegisterVertex(index_t index, Args &&... args) noexcept;
-
-  bool HasVertex(index_t s) const noexcept;
-
-  bool EraseVertex(index_t index) noexcept;
-
-  size_t VerticesSize() const noexcept;
-
-  size_t EdgeSize() const noexcept;
-
-  size_t Degree(index_t s) const noexcept;
-
-  size_t InDegree(index_t s) const noexcept;
-
-  size_t OutDegree(index_t s) const noexcept;
-
-  bool HasEdge(index_t start, index_t dest) const noexcept;
-
-  bool HasEdge(const EdgeType &edge) const noexcept;
-
-  bool ExistsEdge(const EdgeType &edge) const noexcept;
-
-  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight, bool firstInsert = true) noexcept;
-
-  bool InsertEdge(const EdgeType &edge) noexcept;
-
-  bool EraseEdge(index_t start, index_t dest) noexcept;
-
-  bool GetEdge(index_t s, std::vector<EdgeType> &res, bool append = false) const noexcept;
-
-  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
-
-  Edge<true> GetEdgeIn(index_t destination, EdgeWeight type) const noexcept;
-
-  template<typename Queue>
-  bool GetEdgeInOrdered(index_t destination, Queue&& queue, bool append = false) const noexcept;
-
-  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
-
-  Edge<true> GetEdgeOut(index_t start, EdgeWeight type) const noexcept;
-
-  template<typename Queue>
-  bool GetEdgeOutOrdered(index_t start, Queue&& queue, bool append = false) const noexcept;
-
-  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
-
-  void Print() const noexcept;
-
-  template<bool Ascending>
-  decltype(auto) makeEdgeQueue() const noexcept;
-
-  decltype(auto) begin() const noexcept;
-
-  decltype(auto) end() const noexcept;
-protected:
-  auto FetchEdge(index_t start, index_t dest) const noexcept -> Link;
-};
-
-}  // namespace smart_graph_impl
-}  // namespace smart_graph
-
-#include "detail/adjacent_list.inl"
-
-#endif //ADJACENT_HPP_
+#ifndef ADJACENT_HPP_
+#define ADJACENT_HPP_
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <queue>
+
+#include "delta.hpp"
+#include "edge.hpp"
+#include "generator.hpp"
+#include "instrumentation.hpp"
+#include "interleave.hpp"
+#include "memory_usage.hpp"
+#include "parallel.hpp"
+#include "vertex_column.hpp"
+#include "weight_index.hpp"
+
+namespace smart_graph {
+
+namespace smart_graph_impl {
+
+struct AdjacentListTag { };
+
+template <bool Weighted>
+struct LinkNode
+{
+
+};
+
+template <>
+struct LinkNode<true>
+{
+  index_t destination_;
+
+  weight_t weight_;
+
+  LinkNode *next_;
+
+  LinkNode(index_t i, weight_t w, LinkNode *n = nullptr) : destination_(i), weight_(w), next_(n) {}
+};
+
+template <>
+struct LinkNode<false>
+{
+  index_t destination_;
+
+  LinkNode *next_;
+
+  LinkNode(index_t i, LinkNode *n = nullptr) : destination_(i), next_(n) {}
+};
+
+/*  EdgeNode is the node of an undirected list: one node per edge, linked into the lists of both
+ *  of its ends, so an edge is allocated and weighted once. next_[i] continues the list of ends_[i];
+ *  a self-loop is only in the list of ends_[0].
+ */
+template <bool Weighted>
+struct EdgeNode
+{
+
+};
+
+template <>
+struct EdgeNode<true>
+{
+  index_t ends_[2];
+
+  weight_t weight_;
+
+  EdgeNode *next_[2];
+
+  EdgeNode(index_t s, index_t d, weight_t w) : ends_{s, d}, weight_(w), next_{nullptr, nullptr} {}
+};
+
+template <>
+struct EdgeNode<false>
+{
+  index_t ends_[2];
+
+  EdgeNode *next_[2];
+
+  EdgeNode(index_t s, index_t d) : ends_{s, d}, next_{nullptr, nullptr} {}
+};
+
+// The vertex link leads to from the list of owner, and the slot holding the next node of that list.
+template <bool Weighted>
+index_t LinkTarget(const LinkNode<Weighted> *link, index_t owner) noexcept;
+
+template <bool Weighted>
+LinkNode<Weighted> **LinkNext(LinkNode<Weighted> *link, index_t owner) noexcept;
+
+template <bool Weighted>
+index_t LinkTarget(const EdgeNode<Weighted> *link, index_t owner) noexcept;
+
+template <bool Weighted>
+EdgeNode<Weighted> **LinkNext(EdgeNode<Weighted> *link, index_t owner) noexcept;
+
+template<bool Weighted,
+         bool Directed = true>
+class InternalList
+{
+  /*  InternalList is a helper by which user can use operator[] to find the element in adjacent list
+   *  
+   *
+   */
+  using NodeType = std::tuple_element_t<Directed, std::tuple<EdgeNode<Weighted>, LinkNode<Weighted>>>;
+  using NodePtr = NodeType*;
+
+  NodePtr head_;
+  index_t owner_;
+public:
+  InternalList(NodePtr head_ptr = nullptr, index_t owner = 0);
+
+  InternalList(const InternalList& rhs);
+
+  weight_t operator[](index_t dest) const noexcept;
+
+  bool IsVaild() const noexcept;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+class AdjacentList
+{
+public:
+  using ValueType = Ty;
+  using ContainerType = AdjacentListTag;
+  using Self = AdjacentList<Ty, Weighted, Directed>;
+  using EdgeType = Edge<Weighted>;
+
+protected:
+  // undirected graphs share one node between the lists of both ends of an edge
+  using LinkType = std::tuple_element_t<Directed, std::tuple<EdgeNode<Weighted>, LinkNode<Weighted>>>;
+  using Link = LinkType *;
+
+  //using Iterator = UncheckedIterator<Self, false>;
+  friend class Iterator;
+
+  // Out-edges of every vertex; the values are in values_, so walking the lists never loads them.
+  std::map<index_t, Link> list_;
+
+  // In-edges of a directed graph, sorted by start. destination_ of these nodes holds the start.
+  std::map<index_t, Link> reverse_;
+
+  VertexColumn<Ty> values_;
+
+  // Off unless IndexWeights() turns it on.
+  WeightIndex<Directed> weight_index_;
+
+public:
+  AdjacentList();
+
+  ~AdjacentList();
+
+  AdjacentList(const AdjacentList& rhs);
+
+  AdjacentList(AdjacentList&& rhs);
+
+  std::optional<Ty> At(index_t id) const;
+
+  InternalList<Weighted, Directed> operator[](index_t pos) const noexcept;
+
+  template <typename Arg>
+  bool Emplace(size_t s, Arg&& value) noexcept;
+
+  template <typename... Args>
+  bool RegisterVertex(index_t index, Args &&... args) noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  /*  Removes the vertex with its edges, reaching them through its own out- and in-lists. Each edge is
+   *  unlinked from the sorted list of its other end by walking that list up to the vertex, so the
+   *  cost is O(deg log V) for the lookups plus the length of every neighbour's list.
+   */
+  bool EraseVertex(index_t index) noexcept;
+
+  /*  Removes many vertices at once: they are tombstoned first, then every list is swept once,
+   *  O(V + E) however many go. Vertices whose neighbours' lists are short next to the graph are
+   *  erased one by one instead. Returns how many of them existed.
+   */
+  std::size_t EraseVertices(const std::vector<index_t> &vertices) noexcept;
+
+  size_t VerticesSize() const noexcept;
+
+  size_t EdgeSize() const noexcept;
+
+  // Bytes held by the graph by role, walking every list: O(V + E).
+  MemoryFootprint MemoryUsage() const noexcept;
+
+  size_t Degree(index_t s) const noexcept;
+
+  size_t InDegree(index_t s) const noexcept;
+
+  size_t OutDegree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  bool HasEdge(const EdgeType &edge) const noexcept;
+
+  bool ExistsEdge(const EdgeType &edge) const noexcept;
+
+  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight, bool firstInsert = true) noexcept;
+
+  bool InsertEdge(const EdgeType &edge) noexcept;
+
+  bool EraseEdge(index_t start, index_t dest) noexcept;
+
+  // Removes the edges sorted by start, walking each touched list once. Returns how many existed.
+  std::size_t EraseEdges(const std::vector<EdgeType> &edges) noexcept;
+
+  /*  Applies a batch of edge changes: they are sorted by the vertex whose list they touch and
+   *  merged into each list in one walk, the lists split between threads. Changes of the same
+   *  edge take effect in batch order. applied[i] is set to 1 when change i took effect: an
+   *  INSERT whose vertices exist, an ERASE or SET_WEIGHT of an existing edge. Returns how many did.
+   */
+  std::size_t ApplyDelta(const std::vector<EdgeDelta> &delta, std::vector<std::uint8_t> &applied, unsigned threads = 0) noexcept;
+
+  bool GetEdge(index_t s, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  Edge<true> GetEdgeIn(index_t destination, EdgeWeight type) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeInOrdered(index_t destination, Queue&& queue, bool append = false) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  Edge<true> GetEdgeOut(index_t start, EdgeWeight type) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeOutOrdered(index_t start, Queue&& queue, bool append = false) const noexcept;
+
+  // The k lightest (MIN) or heaviest (MAX) out-edges of start in that order, equal weights by ascending destination.
+  bool GetEdgeOut(index_t start, EdgeWeight type, std::size_t k, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, EdgeWeight type, std::size_t k, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  /*  Keep the edges of every vertex sorted by weight from now on, so GetEdgeOut and GetEdgeIn by
+   *  EdgeWeight take O(1) and their k forms O(k), at O(degree) more per change; false drops it.
+   */
+  void IndexWeights(bool enable = true) noexcept;
+
+  bool WeightsIndexed() const noexcept;
+
+  // Call visit(destination, weight) for every out-edge of start without building a container.
+  template<typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  // Call visit(start, weight) for every in-edge of dest, O(in-degree).
+  template<typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  /*  Batches of queries run by RunInterleaved: up to width of them advance one list node at a
+   *  time in turn, each prefetching its next node, so a batch costs about one miss per node
+   *  over width rather than a miss per node. The list heads are copied to an array indexed by
+   *  id first, O(V), so a batch should hold more than a handful of queries.
+   */
+  // WeightOfEdge of every (start, dest) pair, in order.
+  void WeightOfEdges(const std::vector<std::pair<index_t, index_t>> &queries,
+                     std::vector<weight_t> &res,
+                     std::size_t width = kInterleaveWidth) const noexcept;
+
+  // Number of vertices within hops out-edges of every source, the source included; 0 if it doesn't exist.
+  void NeighborhoodSizes(const std::vector<index_t> &sources,
+                         std::size_t hops,
+                         std::vector<std::size_t> &res,
+                         std::size_t width = kInterleaveWidth) const noexcept;
+
+  /*  A walk of length steps from every start, each step to a uniform out-neighbour. The walk
+   *  of starts[i] is walks[i * (length + 1)] onward; it stays put at a vertex without out-edges.
+   *  Walk i draws from SplitMix64(seed, i), so the walks don't depend on width.
+   */
+  void RandomWalks(const std::vector<index_t> &starts,
+                   std::size_t length,
+                   std::uint64_t seed,
+                   std::vector<index_t> &walks,
+                   std::size_t width = kInterleaveWidth) const noexcept;
+
+  void Print() const noexcept;
+
+  template<bool Ascending>
+  decltype(auto) makeEdgeQueue() const noexcept;
+
+  decltype(auto) begin() const noexcept;
+
+  decltype(auto) end() const noexcept;
+protected:
+  auto FetchEdge(index_t start, index_t dest) const noexcept -> Link;
+
+  // The head of every list by id, nullptr for ids without out-edges, up to the largest id.
+  void Heads(std::vector<Link> &heads) const noexcept;
+
+  // Slot holding the first node of the sorted list of owner whose destination isn't less than dest.
+  static auto LowerBound(Link *head, index_t owner, index_t dest) noexcept -> Link *;
+
+  // Take the node leading to dest out of the list of owner and return it, nullptr if there is none.
+  static auto Detach(Link *head, index_t owner, index_t dest) noexcept -> Link;
+
+  // Link the node into the list of owner at slot.
+  static void Splice(Link *slot, Link link, index_t owner) noexcept;
+
+  /*  Whether the list of owner deletes link when the lists are released in ascending order:
+   *  every node of a directed list, an undirected node from the list of its larger end.
+   */
+  static bool Releases(Link link, index_t owner) noexcept;
+
+  // Delete the nodes of the list of owner it releases.
+  static void Free(Link head, index_t owner) noexcept;
+
+  // Unlink every node of the sorted list whose destination is in [first, last), sorted as well.
+  static std::size_t UnlinkSorted(Link *head, index_t owner, const index_t *first, const index_t *last) noexcept;
+
+  // A node for the list of owner leading to dest, not linked yet.
+  static auto MakeLink(index_t owner, index_t dest, weight_t weight) -> Link;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/adjacent_list.inl"
+
+#endif //ADJACENT_HPP_
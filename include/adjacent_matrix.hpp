@@ -1,134 +1,217 @@
-#ifndef ADJACENT_MATRIX_HPP_
-#define ADJACENT_MATRIX_HPP_
-
-#include <map>
-#include <optional>
-#include <iostream>
-#include <string>
-#include <vector>
-#include <bitset>
-#include <array>
-#include <tuple>
-#include <queue>
-
-#include "edge.hpp"
-
-namespace smart_graph {
-namespace smart_graph_impl {
-
-struct AdjacentMatrixTag { };
-
-template <typename Ty,
-          bool Weighted = false,
-          bool Directed = false,
-          size_t Size = 6>
-class AdjacentMatrix
-{
-public:
-  using ValueType = Ty;
-  using ContainerType = AdjacentMatrixTag;
-  using Self = AdjacentMatrix<Ty, Weighted, Directed, Size>;
-  using EdgeType = Edge<Weighted>;
-
-protected:
-  using BaseLine = std::tuple_element_t<Weighted,std::tuple<std::bitset<Size>,
-                                                            std::array<weight_t, Size>
-                                                           >>;
-  using AdjacentMatrixType = std::array<BaseLine, Size>;
-
-  //using NonWeightedAdjacentMatrix = std::array<std::bitset<Size>, Size>;
-  //using WeightedAdjacentMatrix = std::array<std::array<weight_t, Size>, Size>;
-  //using AdjacentMatrixType = std::tuple_element_t<Weighted,std::tuple<NonWeightedAdjacentMatrix, WeightedAdjacentMatrix>>;
-
-  //using iterator = _Unchecked_Iterator<self, true>;
-  friend class iterator;
-
-  AdjacentMatrixType matrix_;
-  std::map<index_t, Ty> vertices_;
-
-public:
-  AdjacentMatrix();
-
-  ~AdjacentMatrix();
-
-  AdjacentMatrix(const AdjacentMatrix& rhs);
-
-  AdjacentMatrix(AdjacentMatrix&& rhs);
-
-  std::optional<Ty> At(index_t s) const;
-
-  BaseLine& operator[](int pos);
-
-  template <typename Arg>
-  bool Emplace(size_t id, Arg &&value) noexcept;
-
-  template <typename... _Arg>
-  bool RegisterVertex(index_t s, _Arg &&... args) noexcept;
-
-  bool HasVertex(index_t s) const noexcept;
-
-  bool EraseVertex(index_t s) noexcept;
-
-  size_t VerticesSize() const noexcept;
-
-  size_t EdgeSize() const noexcept;
-
-  size_t Degree(index_t id) const noexcept;
-
-  size_t InDegree(index_t id) const noexcept;
-
-  size_t OutDegree(index_t id) const noexcept;
-
-  bool HasEdge(index_t start, index_t dest) const noexcept;
-
-  bool HasEdge(const EdgeType &edge) const noexcept;
-
-  bool ExistsEdge(const EdgeType &edge) const noexcept;
-
-  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight) noexcept;
-
-  bool InsertEdge(const EdgeType &edge) noexcept;
-
-  bool EraseEdge(index_t start, index_t dest) noexcept;
-
-  bool GetEdge(index_t source, std::vector<EdgeType> &res, bool append = false) noexcept;
-
-  bool GetEdgeIn(index_t dest, std::vector<EdgeType> &res, bool append = false) const noexcept;
-
-  template<typename Queue>
-  bool GetEdgeInOrdered(index_t destination, Queue&& queue, bool append = false) const noexcept;
-
-  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
-
-  template<typename Queue>
-  bool GetEdgeOutOrdered(index_t start, Queue&& queue, bool append = false) const noexcept;
-
-  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
-
-  void Print() const noexcept;
-
-  template<bool Ascending>
-  decltype(auto) makeEdgeQueue() const noexcept;
-
-  decltype(auto) begin() const noexcept
-  {
-    return vertices_.begin();
-  }
-
-  decltype(auto) end() const noexcept
-  {
-    return vertices_.end();
-  }
-
-protected:
-  bool IndexCheck(index_t f, index_t s) const noexcept;
-
-  bool IndexCheck(index_t f) const noexcept;
-};
-
-}  //namespace smart_graph_impl
-}  //namespace smart_graph
-
-#include "detail/adjacent_matrix.inl"
-
-#endif //ADJACENT_MATRIX_HPP_
+#ifndef ADJACENT_MATRIX_HPP_
+#define ADJACENT_MATRIX_HPP_
+
+#include <map>
+#include <optional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <bitset>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <queue>
+
+#include "delta.hpp"
+#include "edge.hpp"
+#include "instrumentation.hpp"
+#include "memory_usage.hpp"
+#include "vertex_column.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+struct AdjacentMatrixTag { };
+
+template <bool Weighted,
+          size_t Size>
+class SymmetricMatrix
+{
+  /*  SymmetricMatrix keeps the cells of an undirected AdjacentMatrix once: the upper triangle
+   *  with its diagonal, row after row, Size * (Size + 1) / 2 cells instead of Size * Size.
+   *  matrix[r][c] and matrix[c][r] name the same cell, so code written against the square
+   *  array reads and writes it unchanged, and an edge is a single write.
+   */
+  static constexpr std::size_t kCells = static_cast<std::size_t>(Size) * (Size + 1) / 2;
+
+  using Cells = std::tuple_element_t<Weighted,std::tuple<std::bitset<kCells>,
+                                                         std::array<weight_t, kCells>
+                                                        >>;
+
+public:
+  // One row of the square matrix; operator[] yields the cell like a row of the array would.
+  template <bool Const>
+  class Row
+  {
+    using Owner = std::tuple_element_t<Const, std::tuple<SymmetricMatrix, const SymmetricMatrix>>;
+
+  public:
+    Row(Owner &owner, std::size_t row) noexcept;
+
+    decltype(auto) operator[](std::size_t column) const noexcept;
+
+    // Number of connected cells of the row.
+    std::size_t count() const noexcept;
+
+    // Disconnect every cell of the row, and so of the column.
+    void reset() const noexcept;
+
+  private:
+    Owner &owner_;
+    std::size_t row_;
+  };
+
+  Row<false> operator[](std::size_t row) noexcept;
+
+  Row<true> operator[](std::size_t row) const noexcept;
+
+  // Position of the cell (row, column) in the triangle, in either order.
+  static constexpr std::size_t Cell(std::size_t row, std::size_t column) noexcept;
+
+private:
+  Cells cells_;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false,
+          size_t Size = 6>
+class AdjacentMatrix
+{
+public:
+  using ValueType = Ty;
+  using ContainerType = AdjacentMatrixTag;
+  using Self = AdjacentMatrix<Ty, Weighted, Directed, Size>;
+  using EdgeType = Edge<Weighted>;
+
+protected:
+  using BaseLine = std::tuple_element_t<Weighted,std::tuple<std::bitset<Size>,
+                                                            std::array<weight_t, Size>
+                                                           >>;
+  // undirected graphs keep each edge once, in the packed triangle
+  using AdjacentMatrixType = std::tuple_element_t<Directed,std::tuple<SymmetricMatrix<Weighted, Size>,
+                                                                      std::array<BaseLine, Size>
+                                                                     >>;
+
+  //using NonWeightedAdjacentMatrix = std::array<std::bitset<Size>, Size>;
+  //using WeightedAdjacentMatrix = std::array<std::array<weight_t, Size>, Size>;
+  //using AdjacentMatrixType = std::tuple_element_t<Weighted,std::tuple<NonWeightedAdjacentMatrix, WeightedAdjacentMatrix>>;
+
+  //using iterator = _Unchecked_Iterator<self, true>;
+  friend class iterator;
+
+  AdjacentMatrixType matrix_;
+  VertexColumn<Ty> vertices_;     // the values, apart from the cells
+
+public:
+  AdjacentMatrix();
+
+  ~AdjacentMatrix();
+
+  AdjacentMatrix(const AdjacentMatrix& rhs);
+
+  AdjacentMatrix(AdjacentMatrix&& rhs);
+
+  std::optional<Ty> At(index_t s) const;
+
+  // The row of pos: a BaseLine on directed graphs, a SymmetricMatrix row view on undirected ones.
+  decltype(auto) operator[](int pos);
+
+  template <typename Arg>
+  bool Emplace(size_t id, Arg &&value) noexcept;
+
+  template <typename... _Arg>
+  bool RegisterVertex(index_t s, _Arg &&... args) noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  bool EraseVertex(index_t s) noexcept;
+
+  // Erases each vertex in turn, a row and a column of cells apiece. Returns how many existed.
+  std::size_t EraseVertices(const std::vector<index_t> &vertices) noexcept;
+
+  size_t VerticesSize() const noexcept;
+
+  size_t EdgeSize() const noexcept;
+
+  // Bytes held by the graph by role; the cells take the same space whatever the edges.
+  MemoryFootprint MemoryUsage() const noexcept;
+
+  size_t Degree(index_t id) const noexcept;
+
+  size_t InDegree(index_t id) const noexcept;
+
+  size_t OutDegree(index_t id) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  bool HasEdge(const EdgeType &edge) const noexcept;
+
+  bool ExistsEdge(const EdgeType &edge) const noexcept;
+
+  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight) noexcept;
+
+  bool InsertEdge(const EdgeType &edge) noexcept;
+
+  bool EraseEdge(index_t start, index_t dest) noexcept;
+
+  // Clears the cells of the edges. Returns how many existed.
+  std::size_t EraseEdges(const std::vector<EdgeType> &edges) noexcept;
+
+  // Applies a batch of edge changes in order, each cell being O(1) to change. See AdjacentList::ApplyDelta.
+  std::size_t ApplyDelta(const std::vector<EdgeDelta> &delta, std::vector<std::uint8_t> &applied, unsigned threads = 0) noexcept;
+
+  /*  Reverses every edge in place, swapping the cells across the diagonal a tile at a time so
+   *  both tiles of a swap stay in the cache. Undirected graphs are their own transpose.
+   */
+  void Transpose() noexcept;
+
+  bool GetEdge(index_t source, std::vector<EdgeType> &res, bool append = false) noexcept;
+
+  bool GetEdgeIn(index_t dest, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeInOrdered(index_t destination, Queue&& queue, bool append = false) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  template<typename Queue>
+  bool GetEdgeOutOrdered(index_t start, Queue&& queue, bool append = false) const noexcept;
+
+  // Call visit(destination, weight) for every out-edge of start without building a container.
+  template<typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  // Call visit(start, weight) for every in-edge of dest without building a container.
+  template<typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  void Print() const noexcept;
+
+  template<bool Ascending>
+  decltype(auto) makeEdgeQueue() const noexcept;
+
+  decltype(auto) begin() const noexcept
+  {
+    return vertices_.begin();
+  }
+
+  decltype(auto) end() const noexcept
+  {
+    return vertices_.end();
+  }
+
+protected:
+  bool IndexCheck(index_t f, index_t s) const noexcept;
+
+  bool IndexCheck(index_t f) const noexcept;
+};
+
+}  //namespace smart_graph_impl
+}  //namespace smart_graph
+
+#include "detail/adjacent_matrix.inl"
+
+#endif //ADJACENT_MATRIX_HPP_
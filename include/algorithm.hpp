@@ -1,41 +1,154 @@
-#ifndef ALGORITHM_HPP_
-#define ALGORITHM_HPP_
-
-#include <tuple>
-
-#include "adjacent_list.hpp"
-#include "adjacent_matrix.hpp"
-
-namespace smart_graph {
-namespace smart_graph_impl {
-
-template <typename Ty,
-		  bool Weighted = false,
-		  bool Directed = false,
-		  bool Matrix = true,
-		  size_t Size = 0>
-class GraphAlgorithm : public std::tuple_element_t<Matrix, std::tuple<
-                                  AdjacentList<Ty, Weighted, Directed>,
-                                  AdjacentMatrix<Ty, Weighted, Directed, Size>
->>
-{
-  using Base = std::tuple_element_t<Matrix, std::tuple<AdjacentList<Ty, Weighted, Directed>,
-                                                       AdjacentMatrix<Ty, Weighted, Directed, Size>
-                                                       >>;
-
-protected:
-  //using iterator = typename Base::iterator;
-public:
-  GraphAlgorithm():Base() { }
-
-  GraphAlgorithm(const GraphAlgorithm& rhs):Base(rhs) { }
-
-  GraphAlgorithm(GraphAlgorithm&& rhs):Base(std::forward<GraphAlgorithm>(rhs)) { }
-
-    
-};
-
-}  // namespace smart_graph_impl
-}  // namespace smart_graph
-
-#endif // ALGORITHM_HPP_
+#ifndef ALGORITHM_HPP_
+#define ALGORITHM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "adjacent_hybrid.hpp"
+#include "adjacent_list.hpp"
+#include "adjacent_matrix.hpp"
+#include "compact_adjacency.hpp"
+#include "max_flow.hpp"
+#include "parallel.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+struct SearchSpace
+{
+  /*  Per-thread state of a point-to-point search, indexed by vertex id and reused across queries.
+   *  Only the entries a query touched are reset, so a query costs what it settles.
+   */
+  std::vector<distance_t> distance_;
+  std::vector<index_t> parent_;
+  std::vector<index_t> touched_;
+  std::vector<std::pair<distance_t, index_t>> heap_;
+
+  SearchSpace();
+
+  // Lower the distance of v if it improves, true if it did.
+  bool Relax(index_t v, distance_t distance, index_t parent) noexcept;
+
+  void Push(distance_t key, index_t v) noexcept;
+
+  std::pair<distance_t, index_t> Pop() noexcept;
+
+  distance_t TopKey() const noexcept;
+
+  void Reset() noexcept;
+};
+
+// The storage a graph keeps when none is named: adjacency lists, or a Size x Size matrix.
+template <bool Matrix>
+using DefaultStorage = std::conditional_t<Matrix, AdjacentMatrixTag, AdjacentListTag>;
+
+template <typename Ty,
+		  bool Weighted = false,
+		  bool Directed = false,
+		  bool Matrix = true,
+		  size_t Size = 0,
+		  typename Storage = DefaultStorage<Matrix>>
+class GraphAlgorithm : public std::tuple_element_t<std::is_same_v<Storage, AdjacentMatrixTag> + 2 * std::is_same_v<Storage, AdjacentHybridTag>, std::tuple<
+                                  AdjacentList<Ty, Weighted, Directed>,
+                                  AdjacentMatrix<Ty, Weighted, Directed, Size>,
+                                  AdjacentHybrid<Ty, Weighted, Directed>
+>>
+{
+  // the container Storage tags, Size only sizing the matrix
+  using Base = std::tuple_element_t<std::is_same_v<Storage, AdjacentMatrixTag> + 2 * std::is_same_v<Storage, AdjacentHybridTag>, std::tuple<
+                                        AdjacentList<Ty, Weighted, Directed>,
+                                        AdjacentMatrix<Ty, Weighted, Directed, Size>,
+                                        AdjacentHybrid<Ty, Weighted, Directed>
+                                        >>;
+
+protected:
+  //using iterator = typename Base::iterator;
+  using Compact = CompactAdjacency<Weighted>;
+
+public:
+  GraphAlgorithm():Base() { }
+
+  GraphAlgorithm(const GraphAlgorithm& rhs):Base(rhs) { }
+
+  GraphAlgorithm(GraphAlgorithm&& rhs):Base(std::forward<GraphAlgorithm>(rhs)) { }
+
+  /*  Core number of every vertex (the largest k such that the vertex belongs to the k-core).
+   *  Edge directions are ignored, so a directed graph is peeled by Degree() = in + out.
+   *  Self-loops don't count towards the degree.
+   */
+  void CoreNumbers(std::map<index_t, std::size_t> &res) const noexcept;
+
+  // Same result as CoreNumbers, peeling each level in parallel with atomic degree decrements.
+  void ParallelCoreNumbers(std::map<index_t, std::size_t> &res, unsigned threads = 0) const noexcept;
+
+  /*  Brandes betweenness centrality of every vertex, shortest paths by BFS on non-weighted graphs
+   *  and by Dijkstra on weighted ones. Sources are split between threads, each with its own
+   *  buffers and accumulator. On undirected graphs every pair is counted once. Of the two ends
+   *  of a zero-weight edge, the one Dijkstra settles first is the other's predecessor.
+   */
+  void BetweennessCentrality(std::map<index_t, double> &res, unsigned threads = 0) const noexcept;
+
+  // Estimate from `samples` sources drawn without replacement, scaled by VerticesSize() / samples.
+  void ApproximateBetweennessCentrality(std::map<index_t, double> &res,
+                                        std::size_t samples,
+                                        std::uint64_t seed = 0,
+                                        unsigned threads = 0) const noexcept;
+
+  /*  A* from start to dest. heuristic(v) must never exceed the real distance from v to dest;
+   *  it is called as a template functor so it can be inlined. Returns kUnreachable when dest
+   *  can't be reached, otherwise the distance, with the vertices of the path written to path.
+   */
+  template <typename Heuristic>
+  distance_t AStar(index_t start, index_t dest, Heuristic&& heuristic, std::vector<index_t> &path) const noexcept;
+
+  // Dijkstra from both ends at once, forward on out-edges and backward on in-edges.
+  distance_t BidirectionalDijkstra(index_t start, index_t dest, std::vector<index_t> &path) const noexcept;
+
+  // Distance from source to every vertex it reaches over out-edges, by Dijkstra.
+  void ShortestPaths(index_t source, std::map<index_t, distance_t> &res) const noexcept;
+
+  // Number of edges on a shortest path from source to every vertex it reaches, weights ignored.
+  void BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res) const noexcept;
+
+  /*  Maximum flow from source to sink with edge weights as capacities (1 on non-weighted graphs),
+   *  by push-relabel on a copy of the edges; an undirected edge carries flow either way.
+   *  source_side receives the source side of a minimum cut. Returns 0 when source or sink
+   *  doesn't exist or they are the same vertex.
+   */
+  distance_t MaxFlow(index_t source, index_t sink, std::vector<index_t> &source_side) const noexcept;
+
+  /*  The k lightest (MIN) or heaviest (MAX) edges of the graph, best first, equal weights by
+   *  (start, destination); an undirected edge counts once. The vertices are split between
+   *  threads, each keeping a heap of its k best, merged at the end: O(E log k), O(threads * k) space.
+   */
+  void TopEdges(EdgeWeight type, std::size_t k, std::vector<Edge<Weighted>> &res, unsigned threads = 0) const noexcept;
+
+  /*  Every edge whose weight is in [low, high], grouped by ascending start; an undirected edge
+   *  counts once. With IndexWeights() on, a vertex costs a binary search plus its matches.
+   */
+  void EdgesInRange(weight_t low, weight_t high, std::vector<Edge<Weighted>> &res, unsigned threads = 0) const noexcept;
+
+protected:
+  // Adjacency with directions dropped: out-edges for undirected graphs, out + in otherwise.
+  Compact MakeUndirectedView() const noexcept;
+
+  void AccumulateBetweenness(const Compact &adjacency,
+                             const std::vector<std::size_t> &sources,
+                             double scale,
+                             std::map<index_t, double> &res,
+                             unsigned threads) const noexcept;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/algorithm.inl"
+#endif // ALGORITHM_HPP_
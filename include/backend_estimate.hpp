@@ -0,0 +1,69 @@
+#ifndef BACKEND_ESTIMATE_HPP_
+#define BACKEND_ESTIMATE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+#include "adjacent_hybrid.hpp"
+#include "adjacent_list.hpp"
+#include "adjacent_matrix.hpp"
+#include "compact_adjacency.hpp"
+#include "compressed_adjacency.hpp"
+#include "memory_usage.hpp"
+#include "vertex_column.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class Backend {
+  LIST,
+  MATRIX,
+  COMPACT,
+  HYBRID,
+  COMPRESSED
+};
+
+struct BackendEstimate
+{
+  /*  Expected cost of holding a graph in one backend, from the same node and allocation model
+   *  as MemoryUsage(). Query costs are dependent memory accesses (map levels, list nodes,
+   *  cache lines), which dominate the time of these operations once the graph leaves the cache.
+   */
+  Backend backend_;
+  std::size_t bytes_;         // SIZE_MAX when the backend can't hold the graph
+  double edge_lookup_;        // HasEdge / WeightOfEdge
+  double neighbor_scan_;      // visiting the out-edges of an average vertex
+  bool mutable_;              // supports InsertEdge / EraseEdge
+};
+
+/*  Estimates for every backend, indexed by Backend, for `vertices` vertices with dense ids and
+ *  `edges` calls of InsertEdge. payload is sizeof the vertex value type.
+ */
+std::array<BackendEstimate, 5> EstimateBackends(std::size_t vertices,
+                                                std::size_t edges,
+                                                bool weighted,
+                                                bool directed,
+                                                std::size_t payload = sizeof(index_t)) noexcept;
+
+/*  For read-only use COMPRESSED once it takes at most half the memory of COMPACT, whose lookups
+ *  decode nothing, and COMPACT otherwise. Else MATRIX while it takes at most twice the memory of
+ *  the smaller of LIST and HYBRID, its edge lookups being constant time; beyond that HYBRID, whose
+ *  rows are contiguous, unless LIST takes less memory.
+ */
+Backend RecommendBackend(std::size_t vertices,
+                         std::size_t edges,
+                         bool weighted,
+                         bool directed,
+                         bool read_only = false,
+                         std::size_t payload = sizeof(index_t)) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/backend_estimate.inl"
+#endif // BACKEND_ESTIMATE_HPP_
@@ -0,0 +1,65 @@
+#ifndef BSP_HPP_
+#define BSP_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Message>
+class InProcessTransport
+{
+  /*  InProcessTransport carries the messages of a bulk-synchronous run between peers that are
+   *  threads of one process. A transport has three calls, which RunBsp relies on:
+   *    Peers()                   the number of peers;
+   *    Send(from, to, message)   queue a message, called only by the thread of peer `from`;
+   *    Exchange(self, active, inbox)
+   *                              end the superstep of self: wait for every peer, then receive
+   *                              into inbox what was sent to self during the step. Returns
+   *                              whether any peer was active or sent anything, the same answer
+   *                              for every peer.
+   *  A transport over processes or machines implements the same calls. Here every peer owns one
+   *  outbox per destination, so sending takes no lock; only Exchange synchronizes.
+   */
+public:
+  using MessageType = Message;
+
+  explicit InProcessTransport(unsigned peers);
+
+  unsigned Peers() const noexcept;
+
+  void Send(unsigned from, unsigned to, const Message &message);
+
+  bool Exchange(unsigned self, bool active, std::vector<Message> &inbox);
+
+private:
+  // Wait until every peer has arrived; returns the OR of their flags.
+  bool Barrier(bool flag);
+
+  std::vector<std::vector<std::vector<Message>>> outboxes_;   // [from][to]
+  std::mutex mutex_;
+  std::condition_variable arrived_all_;
+  unsigned arrived_ = 0;
+  std::uint64_t generation_ = 0;
+  bool any_ = false;
+  bool result_ = false;
+};
+
+/*  Run compute(peer, step, inbox) on one thread per peer of transport, superstep after superstep,
+ *  until a step in which no peer returns true (still has work) and none sends a message, or
+ *  after max_steps steps. compute sends through transport.Send(peer, ...); inbox holds what the
+ *  peer received at the end of the previous step, empty in step 0. Returns the number of steps.
+ */
+template <typename Transport, typename Compute>
+std::size_t RunBsp(Transport &transport, Compute&& compute, std::size_t max_steps = SIZE_MAX) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/bsp.inl"
+#endif // BSP_HPP_
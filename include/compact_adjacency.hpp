@@ -0,0 +1,83 @@
+#ifndef COMPACT_ADJACENCY_HPP_
+#define COMPACT_ADJACENCY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "edge.hpp"
+#include "memory_usage.hpp"
+#include "parallel.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class EdgeDirection {
+  OUT,
+  IN,
+  BOTH
+};
+
+template <bool Weighted>
+class CompactAdjacency
+{
+  /*  CompactAdjacency is a read-only CSR copy of a container taken at construction time.
+   *  Vertices are renumbered to dense positions [0, VerticesSize()) in ascending id order,
+   *  so algorithms can keep their state in flat arrays and read degrees in O(1).
+   *  It doesn't follow later changes of the source container.
+   */
+public:
+  static constexpr std::size_t kNoPosition = SIZE_MAX;
+
+  CompactAdjacency() = default;
+
+  template <typename Container>
+  explicit CompactAdjacency(const Container &graph, EdgeDirection direction = EdgeDirection::OUT);
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t EdgeSize() const noexcept;
+
+  MemoryFootprint MemoryUsage() const noexcept;
+
+  std::size_t Degree(std::size_t position) const noexcept;
+
+  index_t IdOf(std::size_t position) const noexcept;
+
+  std::size_t PositionOf(index_t id) const noexcept;
+
+  // Neighbors of a position are the positions in [NeighborBegin, NeighborEnd).
+  const index_t *NeighborBegin(std::size_t position) const noexcept;
+
+  const index_t *NeighborEnd(std::size_t position) const noexcept;
+
+  // Offset of the first arc of a position, for indexing arc-parallel arrays.
+  std::size_t ArcBegin(std::size_t position) const noexcept;
+
+  index_t Target(std::size_t arc) const noexcept;
+
+  weight_t Weight(std::size_t arc) const noexcept;
+
+  /*  Reverse every arc in place by a counting sort on the targets, the sources split between
+   *  `threads` workers that each count and place their own arcs. The arcs of a position stay
+   *  in ascending order of their new targets. Small copies are done on one thread.
+   */
+  void Transpose(unsigned threads = 0);
+
+private:
+  // Arcs a copy needs per worker before Transpose splits it.
+  static constexpr std::size_t kParallelArcs = std::size_t{1} << 16;
+
+  std::vector<index_t> ids_;
+  std::vector<std::size_t> positions_;
+  std::vector<std::size_t> offsets_;
+  std::vector<index_t> targets_;
+  std::vector<weight_t> weights_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/compact_adjacency.inl"
+#endif // COMPACT_ADJACENCY_HPP_
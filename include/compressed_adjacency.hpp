@@ -0,0 +1,95 @@
+#ifndef COMPRESSED_ADJACENCY_HPP_
+#define COMPRESSED_ADJACENCY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "compact_adjacency.hpp"
+#include "edge.hpp"
+#include "memory_usage.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+class CompressedAdjacency
+{
+  /*  CompressedAdjacency is a read-only copy of a container like CompactAdjacency, with the same
+   *  dense positions, that keeps every neighbour list as the gaps between its ascending targets.
+   *  The gaps go in blocks of eight behind a control byte whose bit i tells whether gap i takes
+   *  one byte or two, so a block decodes with a fixed run of loads and shifts and no branch per
+   *  gap. Weights are stored as offsets from the smallest one in 0, 1, 2, 4, 8 or 16 bits, the
+   *  narrowest width holding them all, so none straddles two words.
+   *  It doesn't follow later changes of the source container.
+   */
+public:
+  static constexpr std::size_t kNoPosition = SIZE_MAX;
+
+  CompressedAdjacency() = default;
+
+  template <typename Container>
+  explicit CompressedAdjacency(const Container &graph, EdgeDirection direction = EdgeDirection::OUT);
+
+  explicit CompressedAdjacency(const CompactAdjacency<Weighted> &adjacency);
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t EdgeSize() const noexcept;
+
+  MemoryFootprint MemoryUsage() const noexcept;
+
+  std::size_t Degree(std::size_t position) const noexcept;
+
+  index_t IdOf(std::size_t position) const noexcept;
+
+  std::size_t PositionOf(index_t id) const noexcept;
+
+  // Offset of the first arc of a position, for indexing arc-parallel arrays.
+  std::size_t ArcBegin(std::size_t position) const noexcept;
+
+  weight_t Weight(std::size_t arc) const noexcept;
+
+  // Call visit(target position, weight) for the neighbours of a position in ascending order.
+  template <typename Visitor>
+  void ForEachNeighbor(std::size_t position, Visitor&& visit) const noexcept;
+
+  // The read calls of a container, on vertex ids, over the arcs of the direction it was built with.
+  template <typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<Edge<Weighted>> &res, bool append = false) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+private:
+  static constexpr std::size_t kBlock = 8;
+  static constexpr std::size_t kWordBits = 64;
+  static constexpr std::uint32_t kNoSlot = UINT32_MAX;
+
+  // Decode the neighbours of a position, calling step(target, arc) until it returns false.
+  template <typename Step>
+  void Walk(std::size_t position, Step&& step) const noexcept;
+
+  // Arc from position to target, kNoPosition if there is none.
+  std::size_t FindArc(std::size_t position, std::size_t target) const noexcept;
+
+  std::vector<index_t> ids_;
+  std::vector<std::uint32_t> positions_;
+  std::vector<std::size_t> offsets_;        // first byte of each position's blocks
+  std::vector<std::size_t> arcs_;           // first arc of each position
+  std::vector<std::uint8_t> bytes_;         // one byte of padding, a short gap may read its high byte
+  std::vector<std::uint64_t> weights_;
+  weight_t weight_base_ = 0;
+  unsigned weight_bits_ = 0;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/compressed_adjacency.inl"
+#endif // COMPRESSED_ADJACENCY_HPP_
@@ -0,0 +1,86 @@
+#ifndef CONTRACTION_HIERARCHY_HPP_
+#define CONTRACTION_HIERARCHY_HPP_
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "algorithm.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+class ContractionHierarchy
+{
+  /*  ContractionHierarchy is a point-to-point query index over a weighted (or non-weighted) graph.
+   *  Build orders the vertices by edge difference, contracting an independent set of local minima
+   *  per round in parallel, and keeps the result as two CSR arrays numbered by rank:
+   *  up_ holds arcs towards higher ranks, down_ holds reversed arcs coming from higher ranks.
+   *  A query is a bidirectional Dijkstra that only climbs, which settles a few hundred vertices
+   *  even on large road networks. Like CompactAdjacency it doesn't follow later graph changes.
+   */
+public:
+  ContractionHierarchy() = default;
+
+  template <typename Container>
+  explicit ContractionHierarchy(const Container &graph, unsigned threads = 0);
+
+  template <typename Container>
+  void Build(const Container &graph, unsigned threads = 0) noexcept;
+
+  // Returns kUnreachable when dest can't be reached from start.
+  distance_t Query(index_t start, index_t dest) const noexcept;
+
+  // Same as Query, and writes the vertices of the path with shortcuts unpacked.
+  distance_t Query(index_t start, index_t dest, std::vector<index_t> &path) const noexcept;
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t ArcSize() const noexcept;
+
+  /*  Binary image of the index in host byte order. Load returns false and leaves the index
+   *  empty when the stream doesn't hold an image of this format version.
+   */
+  bool Save(std::ostream &out) const;
+
+  bool Load(std::istream &in);
+
+private:
+  // Path lengths of a 16 bit graph stay below 2^32.
+  using ArcWeight = std::uint32_t;
+
+  struct Arc
+  {
+    ArcWeight weight_;
+    index_t target_;
+    index_t middle_;  // contracted vertex a shortcut skips, target_ for an original arc
+  };
+
+  static constexpr std::size_t kNoRank = SIZE_MAX;
+  static constexpr std::uint32_t kMagic = 0x48434753;  // "SGCH"
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::size_t RankOf(index_t id) const noexcept;
+
+  distance_t Query(index_t start, index_t dest, std::vector<index_t> &path, bool unpack) const noexcept;
+
+  const Arc *FindArc(std::size_t from, std::size_t to) const noexcept;
+
+  void Unpack(std::size_t from, std::size_t to, std::vector<index_t> &path) const noexcept;
+
+  void Clear() noexcept;
+
+  std::vector<index_t> ids_;           // rank -> id
+  std::vector<std::size_t> ranks_;     // id -> rank
+  std::vector<std::size_t> up_offsets_;
+  std::vector<Arc> up_;
+  std::vector<std::size_t> down_offsets_;
+  std::vector<Arc> down_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/contraction_hierarchy.inl"
+#endif // CONTRACTION_HIERARCHY_HPP_
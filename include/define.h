@@ -1,56 +1,86 @@
-#ifndef DEFINE_H_
-#define DEFINE_H_
-
-#include <stdint.h>
-
-namespace smart_graph {
-namespace smart_graph_impl {
-
-#define WEIGHTED_GRAPH if constexpr (Weighted)
-#define NON_WEIGHTED_GRAPH if constexpr (!Weighted)
-
-#define WEIGHTED_GRAPH_BEGIN \
-	if constexpr (Weighted)  \
-	{
-#define NON_WEIGHTED_GRAPH_BEGIN \
-	if constexpr (!Weighted)     \
-	{
-        
-#define WEIGHTED_GRAPH_END }
-#define NON_WEIGHTED_GRAPH_END }
-#define DIRECTED_GRAPH if constexpr (Directed)
-#define NON_DIRECTED_GRAPH if constexpr (!Directed)
-
-#define DIRECTED_GRAPH_BEGIN \
-	if constexpr (Directed)  \
-	{
-
-#define NON_DIRECTED_GRAPH_BEGIN \
-	if constexpr (!Directed)     \
-	{
-
-#define DIRECTED_GRAPH_END }
-#define NON_DIRECTED_GRAPH_END }
-#define ELSE else
-
-
-// Here set the maximum of the graph's size and weight type.
-// Default maximum size is 2^16 - 1 = 65535.
-// Default weight type is 8bit signed integer.
-using size_t = uint16_t;  // 2 Bytes
-using index_t = uint16_t; // 2 Bytes
-using weight_t = int16_t; // 2 Bytes
-
-/*  When the weight is above the value of disconnected, the Edge is assumed as a connected edge
- *  Therefore even if the weight of edge is 0, it will be concerned as a loop pointing to itself
- */
-constexpr weight_t kDefaultWeight = 1;
-constexpr weight_t kWeightMax = INT16_MAX;
-constexpr weight_t kWeightMin = INT16_MIN;
-constexpr weight_t kDisconnected = -1;
-constexpr weight_t kConnected = 1;
-#define WEIGHT_CHECK(x) x > kDisconnected
-
-}  //namespace smart_graph_impl
-}  //namespace smart_graph
-#endif //DEFINE_H_
+#ifndef DEFINE_H_
+#define DEFINE_H_
+
+#include <stdint.h>
+
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+#define WEIGHTED_GRAPH if constexpr (Weighted)
+#define NON_WEIGHTED_GRAPH if constexpr (!Weighted)
+
+#define WEIGHTED_GRAPH_BEGIN \
+	if constexpr (Weighted)  \
+	{
+#define NON_WEIGHTED_GRAPH_BEGIN \
+	if constexpr (!Weighted)     \
+	{
+        
+#define WEIGHTED_GRAPH_END }
+#define NON_WEIGHTED_GRAPH_END }
+#define DIRECTED_GRAPH if constexpr (Directed)
+#define NON_DIRECTED_GRAPH if constexpr (!Directed)
+
+#define DIRECTED_GRAPH_BEGIN \
+	if constexpr (Directed)  \
+	{
+
+#define NON_DIRECTED_GRAPH_BEGIN \
+	if constexpr (!Directed)     \
+	{
+
+#define DIRECTED_GRAPH_END }
+#define NON_DIRECTED_GRAPH_END }
+#define ELSE else
+
+
+// Here set the maximum of the graph's size and weight type.
+// Default maximum size is 2^16 - 1 = 65535.
+// Default weight type is 8bit signed integer.
+using size_t = uint16_t;  // 2 Bytes
+using index_t = uint16_t; // 2 Bytes
+using weight_t = int16_t; // 2 Bytes
+
+/*  When the weight is above the value of disconnected, the Edge is assumed as a connected edge
+ *  Therefore even if the weight of edge is 0, it will be concerned as a loop pointing to itself
+ */
+constexpr weight_t kDefaultWeight = 1;
+constexpr weight_t kWeightMax = INT16_MAX;
+constexpr weight_t kWeightMin = INT16_MIN;
+constexpr weight_t kDisconnected = -1;
+constexpr weight_t kConnected = 1;
+#define WEIGHT_CHECK(x) x > kDisconnected
+
+// Length of a path, wide enough to sum kWeightMax over every vertex.
+using distance_t = int64_t;
+constexpr distance_t kUnreachable = INT64_MAX;
+
+// Index of the lowest set bit of bits, which must not be 0.
+inline unsigned CountTrailingZeros(uint64_t bits) noexcept
+{
+#if defined(__cpp_lib_bitops)
+  return static_cast<unsigned>(std::countr_zero(bits));
+#elif defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return static_cast<unsigned>(index);
+#else
+  unsigned count = 0;
+  for (; !(bits & 1); bits >>= 1)
+    ++count;
+  return count;
+#endif
+}
+
+}  //namespace smart_graph_impl
+}  //namespace smart_graph
+#endif //DEFINE_H_
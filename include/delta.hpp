@@ -0,0 +1,59 @@
+#ifndef DELTA_HPP_
+#define DELTA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "define.h"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class DeltaOperation {
+  INSERT,       // add the edge or change its weight, like InsertEdge
+  ERASE,        // remove the edge
+  SET_WEIGHT    // change the weight of an existing edge, never adds one
+};
+
+struct EdgeDelta
+{
+  DeltaOperation operation_;
+  index_t start_;
+  index_t destination_;
+  weight_t weight_ = kDefaultWeight;
+};
+
+struct DeltaArc
+{
+  /*  One arc touched by a delta, in the order ApplyDelta merges them: by the row (the vertex
+   *  whose list changes), then the column, then the position of the change in the batch,
+   *  so changes of the same edge keep their order.
+   */
+  index_t row_;
+  index_t column_;
+  std::uint32_t sequence_;     // position in the batch
+  DeltaOperation operation_;
+  weight_t weight_;
+  bool in_list_;               // an in-edge list of a directed graph
+  bool primary_;               // the arc the change names, not its mirror or in-edge
+
+  bool operator<(const DeltaArc &rhs) const noexcept;
+};
+
+/*  Expand a batch into sorted arcs: every change gives its arc, and on directed graphs its in-edge,
+ *  on undirected ones its reverse arc unless it is a self-loop. Changes naming a vertex for which
+ *  present(id) is false are left out; present is called once per distinct id.
+ */
+template <typename Present>
+void MakeDeltaArcs(const std::vector<EdgeDelta> &delta, bool directed, Present&& present, std::vector<DeltaArc> &arcs);
+
+// Bounds [groups[i], groups[i + 1]) of the runs of arcs sharing in_list_ and row_.
+void GroupDeltaArcs(const std::vector<DeltaArc> &arcs, std::vector<std::size_t> &groups);
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/delta.inl"
+#endif // DELTA_HPP_
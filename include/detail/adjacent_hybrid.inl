@@ -0,0 +1,1221 @@
+#include "../adjacent_hybrid.hpp"
+
+#include <algorithm>
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+bool HybridRow<Weighted>::IsDense() const noexcept
+{
+  return dense_;
+}
+
+template <bool Weighted>
+std::size_t HybridRow<Weighted>::Degree() const noexcept
+{
+  return degree_;
+}
+
+template <bool Weighted>
+weight_t HybridRow<Weighted>::Find(index_t column) const noexcept
+{
+  if (dense_) {
+    if (column / kWordBits >= bits_.size() || !(bits_[column / kWordBits] >> (column % kWordBits) & 1))
+      return kDisconnected;
+
+    WEIGHTED_GRAPH
+      return weights_[column];
+    ELSE
+      return kConnected;
+  }
+
+  auto iter = std::lower_bound(targets_.begin(), targets_.end(), column);
+  if (iter == targets_.end() || *iter != column)
+    return kDisconnected;
+
+  WEIGHTED_GRAPH
+    return weights_[iter - targets_.begin()];
+  ELSE
+    return kConnected;
+}
+
+template <bool Weighted>
+bool HybridRow<Weighted>::Insert(index_t column, weight_t weight) noexcept
+{
+  if (dense_) {
+    std::size_t word = column / kWordBits;
+    if (word >= bits_.size()) {
+      bits_.resize(word + 1, 0);
+      WEIGHTED_GRAPH
+        weights_.resize(bits_.size() * kWordBits, kDisconnected);
+    }
+
+    WEIGHTED_GRAPH
+      weights_[column] = weight;
+
+    std::uint64_t mask = std::uint64_t(1) << (column % kWordBits);
+    if (bits_[word] & mask)
+      return false;
+
+    bits_[word] |= mask;
+    ++degree_;
+    return true;
+  }
+
+  auto iter = std::lower_bound(targets_.begin(), targets_.end(), column);
+  std::size_t pos = static_cast<std::size_t>(iter - targets_.begin());
+  if (iter != targets_.end() && *iter == column) {
+    WEIGHTED_GRAPH
+      weights_[pos] = weight;
+    return false;
+  }
+
+  targets_.insert(iter, column);
+  WEIGHTED_GRAPH
+    weights_.insert(weights_.begin() + pos, weight);
+  ++degree_;
+  return true;
+}
+
+template <bool Weighted>
+bool HybridRow<Weighted>::Erase(index_t column) noexcept
+{
+  if (dense_) {
+    std::size_t word = column / kWordBits;
+    std::uint64_t mask = std::uint64_t(1) << (column % kWordBits);
+    if (word >= bits_.size() || !(bits_[word] & mask))
+      return false;
+
+    bits_[word] &= ~mask;
+    WEIGHTED_GRAPH
+      weights_[column] = kDisconnected;
+    --degree_;
+    return true;
+  }
+
+  auto iter = std::lower_bound(targets_.begin(), targets_.end(), column);
+  if (iter == targets_.end() || *iter != column)
+    return false;
+
+  WEIGHTED_GRAPH
+    weights_.erase(weights_.begin() + (iter - targets_.begin()));
+  targets_.erase(iter);
+  --degree_;
+  return true;
+}
+
+template <bool Weighted>
+template <typename Predicate>
+std::size_t HybridRow<Weighted>::EraseIf(Predicate&& doomed) noexcept
+{
+  std::size_t before = degree_;
+  if (dense_) {
+    for (std::size_t word = 0; word < bits_.size(); ++word)
+      for (std::uint64_t bits = bits_[word]; bits != 0; bits &= bits - 1)
+      {
+        std::size_t column = word * kWordBits + CountTrailingZeros(bits);
+        if (!doomed(static_cast<index_t>(column)))
+          continue;
+
+        bits_[word] &= ~(std::uint64_t(1) << (column % kWordBits));
+        WEIGHTED_GRAPH
+          weights_[column] = kDisconnected;
+        --degree_;
+      }
+    return before - degree_;
+  }
+
+  // compact targets_ and weights_ together, keeping their order
+  std::size_t kept = 0;
+  for (std::size_t pos = 0; pos < targets_.size(); ++pos)
+  {
+    if (doomed(targets_[pos]))
+      continue;
+
+    targets_[kept] = targets_[pos];
+    WEIGHTED_GRAPH
+      weights_[kept] = weights_[pos];
+    ++kept;
+  }
+  targets_.resize(kept);
+  WEIGHTED_GRAPH
+    weights_.resize(kept);
+  degree_ = kept;
+  return before - degree_;
+}
+
+template <bool Weighted>
+std::ptrdiff_t HybridRow<Weighted>::Merge(const DeltaArc *first, const DeltaArc *last, std::uint8_t *applied) noexcept
+{
+  const std::size_t before = degree_;
+
+  // apply the changes of one column in batch order to its current state
+  auto apply = [applied](const DeltaArc *&arc, const DeltaArc *last, bool &present, weight_t &weight) {
+    index_t column = arc->column_;
+    for (; arc != last && arc->column_ == column; ++arc)
+    {
+      bool done = present;
+      switch (arc->operation_)
+      {
+      case DeltaOperation::INSERT:
+        done = present = true;
+        weight = arc->weight_;
+        break;
+      case DeltaOperation::ERASE:
+        present = false;
+        break;
+      case DeltaOperation::SET_WEIGHT:
+        if (present)
+          weight = arc->weight_;
+        break;
+      }
+
+      if (arc->primary_)
+        applied[arc->sequence_] = done;
+    }
+  };
+
+  if (dense_) {
+    while (first != last)
+    {
+      index_t column = first->column_;
+      weight_t weight = Find(column);
+      bool present = weight != kDisconnected;
+      bool was_present = present;
+      apply(first, last, present, weight);
+
+      if (present)
+        Insert(column, Weighted ? weight : kConnected);
+      else if (was_present)
+        Erase(column);
+    }
+    return static_cast<std::ptrdiff_t>(degree_) - static_cast<std::ptrdiff_t>(before);
+  }
+
+  // sparse: merge the sorted changes with the sorted targets into fresh arrays
+  std::vector<index_t> targets;
+  std::vector<weight_t> weights;
+  targets.reserve(targets_.size() + static_cast<std::size_t>(last - first));
+  WEIGHTED_GRAPH
+    weights.reserve(targets.capacity());
+
+  auto keep = [&](index_t column, weight_t weight) {
+    targets.push_back(column);
+    WEIGHTED_GRAPH
+      weights.push_back(weight);
+  };
+
+  std::size_t pos = 0;
+  while (first != last)
+  {
+    index_t column = first->column_;
+    for (; pos < targets_.size() && targets_[pos] < column; ++pos)
+      keep(targets_[pos], Weighted ? weights_[pos] : kConnected);
+
+    bool present = pos < targets_.size() && targets_[pos] == column;
+    weight_t weight = present && Weighted ? weights_[pos] : kConnected;
+    if (present)
+      ++pos;
+
+    apply(first, last, present, weight);
+    if (present)
+      keep(column, weight);
+  }
+  for (; pos < targets_.size(); ++pos)
+    keep(targets_[pos], Weighted ? weights_[pos] : kConnected);
+
+  targets_.swap(targets);
+  weights_.swap(weights);
+  degree_ = targets_.size();
+  return static_cast<std::ptrdiff_t>(degree_) - static_cast<std::ptrdiff_t>(before);
+}
+
+template <bool Weighted>
+template <typename Visitor>
+void HybridRow<Weighted>::ForEach(Visitor&& visit) const noexcept
+{
+  if (dense_) {
+    for (std::size_t word = 0; word < bits_.size(); ++word)
+      for (std::uint64_t bits = bits_[word]; bits != 0; bits &= bits - 1)
+      {
+        auto column = static_cast<index_t>(word * kWordBits + CountTrailingZeros(bits));
+        WEIGHTED_GRAPH
+          visit(column, weights_[column]);
+        ELSE
+          visit(column, kConnected);
+      }
+    return;
+  }
+
+  for (std::size_t pos = 0; pos < targets_.size(); ++pos)
+  {
+    WEIGHTED_GRAPH
+      visit(targets_[pos], weights_[pos]);
+    ELSE
+      visit(targets_[pos], kConnected);
+  }
+}
+
+template <bool Weighted>
+void HybridRow<Weighted>::Adapt(std::size_t width) noexcept
+{
+  if (!dense_ && SparseBytes(degree_) > DenseBytes(width))
+    MakeDense(width);
+  else if (dense_ && 2 * SparseBytes(degree_) < DenseBytes(bits_.size() * kWordBits))
+    MakeSparse();
+}
+
+template <bool Weighted>
+void HybridRow<Weighted>::Account(std::size_t &category, std::size_t &slack) const noexcept
+{
+  AccountVector(targets_, category, slack);
+  AccountVector(weights_, category, slack);
+  AccountVector(bits_, category, slack);
+}
+
+template <bool Weighted>
+std::size_t HybridRow<Weighted>::SparseBytes(std::size_t degree) noexcept
+{
+  return degree * (sizeof(index_t) + (Weighted ? sizeof(weight_t) : 0));
+}
+
+template <bool Weighted>
+std::size_t HybridRow<Weighted>::DenseBytes(std::size_t width) noexcept
+{
+  std::size_t words = (width + kWordBits - 1) / kWordBits;
+  return words * sizeof(std::uint64_t) + (Weighted ? words * kWordBits * sizeof(weight_t) : 0);
+}
+
+template <bool Weighted>
+void HybridRow<Weighted>::MakeDense(std::size_t width)
+{
+  std::size_t words = (width + kWordBits - 1) / kWordBits;
+  if (!targets_.empty())
+    words = std::max<std::size_t>(words, targets_.back() / kWordBits + 1);
+
+  std::vector<std::uint64_t> bits(words, 0);
+  std::vector<weight_t> weights;
+  WEIGHTED_GRAPH
+    weights.assign(words * kWordBits, kDisconnected);
+
+  for (std::size_t pos = 0; pos < targets_.size(); ++pos)
+  {
+    bits[targets_[pos] / kWordBits] |= std::uint64_t(1) << (targets_[pos] % kWordBits);
+    WEIGHTED_GRAPH
+      weights[targets_[pos]] = weights_[pos];
+  }
+
+  std::vector<index_t>().swap(targets_);  // assigning {} would keep the capacity
+  bits_.swap(bits);
+  weights_.swap(weights);
+  dense_ = true;
+}
+
+template <bool Weighted>
+void HybridRow<Weighted>::MakeSparse()
+{
+  std::vector<index_t> targets;
+  std::vector<weight_t> weights;
+  targets.reserve(degree_);
+  WEIGHTED_GRAPH
+    weights.reserve(degree_);
+
+  ForEach([&](index_t column, weight_t weight) {
+    targets.push_back(column);
+    WEIGHTED_GRAPH
+      weights.push_back(weight);
+  });
+
+  std::vector<std::uint64_t>().swap(bits_);
+  targets_.swap(targets);
+  weights_.swap(weights);
+  dense_ = false;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentHybrid<Ty,Weighted,Directed>::AdjacentHybrid(): list_()
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentHybrid<Ty,Weighted,Directed>::~AdjacentHybrid()
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentHybrid<Ty,Weighted,Directed>::AdjacentHybrid(const AdjacentHybrid& rhs):
+    list_(rhs.list_), values_(rhs.values_), weight_index_(rhs.weight_index_), arcs_(rhs.arcs_)
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentHybrid<Ty,Weighted,Directed>::AdjacentHybrid(AdjacentHybrid&& rhs):
+    list_(std::move(rhs.list_)), values_(std::move(rhs.values_)), weight_index_(std::move(rhs.weight_index_)),
+    arcs_(rhs.arcs_)
+{
+  rhs.list_.clear();
+  rhs.values_.Clear();
+  rhs.arcs_ = 0;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::optional<Ty> AdjacentHybrid<Ty,Weighted,Directed>::At(index_t id) const
+{
+  const Ty *value = values_.Find(id);
+  if (!value)
+    return std::nullopt;
+
+  return *value;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Arg>
+bool AdjacentHybrid<Ty,Weighted,Directed>::Emplace(size_t s, Arg&& value) noexcept
+{
+  return values_.Assign(s, std::forward<Arg>(value));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename... Args>
+bool AdjacentHybrid<Ty,Weighted,Directed>::RegisterVertex(index_t index, Args &&... args) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::REGISTER_VERTEX);
+  Instrumentation::CountLookups(1);
+
+  if (!values_.Emplace(index, std::forward<Args>(args)...))
+    return false;
+
+  list_.emplace(index, Node{Row(), Row()});
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::HasVertex(index_t s) const noexcept
+{
+  Instrumentation::CountLookups(1);
+  return values_.Has(s);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::EraseVertex(index_t index) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::ERASE_VERTEX);
+  auto reindex = weight_index_.TrackVertex(*this, index);
+
+  auto iter = list_.find(index);
+  if (iter == list_.end())
+    return false;
+
+  const std::size_t width = Width();
+  Node &node = iter->second;
+  auto drop = [&](const Row &row, bool out) {
+    row.ForEach([&](index_t other, weight_t) {
+      if (other == index)
+        return;
+
+      Instrumentation::CountLookups(1);
+      Node &neighbor = list_.find(other)->second;
+      Row &mirror = (Directed && out) ? neighbor.in_ : neighbor.out_;
+      mirror.Erase(index);
+      mirror.Adapt(width);
+      NON_DIRECTED_GRAPH
+        --arcs_;
+    });
+  };
+
+  drop(node.out_, true);
+  arcs_ -= node.out_.Degree();
+  DIRECTED_GRAPH_BEGIN
+    drop(node.in_, false);
+    // the in-edges are out-edges of the other vertices, a self-loop was counted above
+    arcs_ -= node.in_.Degree() - (node.out_.Find(index) != kDisconnected ? 1 : 0);
+  DIRECTED_GRAPH_END
+
+  list_.erase(iter);
+  values_.Erase(index);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::EraseVertices(const std::vector<index_t> &vertices) noexcept
+{
+  /*  Erasing one vertex edits the row of each of its neighbours, a sweep compacts every row once
+   *  in sequence: it pays off once the doomed vertices hold as many edges as there are vertices.
+   */
+  constexpr std::size_t kSweepEdgesPerVertex = 1;
+
+  if (list_.empty())
+    return 0;
+
+  std::vector<bool> doomed(Width(), false);
+  std::vector<index_t> erased;
+  std::size_t doomed_edges = 0;
+  for (index_t index : vertices)
+    if (index < doomed.size() && !doomed[index] && list_.count(index)) {
+      doomed[index] = true;
+      erased.push_back(index);
+      doomed_edges += OutDegree(index) + (Directed ? InDegree(index) : 0);
+    }
+
+  if (doomed_edges < kSweepEdgesPerVertex * list_.size()) {
+    for (index_t index : erased)
+      EraseVertex(index);
+    return erased.size();
+  }
+
+  auto reindex = weight_index_.TrackAll(*this);
+  const std::size_t width = Width();
+  auto is_doomed = [&doomed](index_t column) { return doomed[column]; };
+  for (auto iter = list_.begin(); iter != list_.end();)
+  {
+    if (doomed[iter->first]) {
+      arcs_ -= iter->second.out_.Degree();
+      values_.Erase(iter->first);
+      iter = list_.erase(iter);
+      continue;
+    }
+
+    arcs_ -= iter->second.out_.EraseIf(is_doomed);
+    iter->second.out_.Adapt(width);
+    DIRECTED_GRAPH_BEGIN
+      iter->second.in_.EraseIf(is_doomed);
+      iter->second.in_.Adapt(width);
+    DIRECTED_GRAPH_END
+    ++iter;
+  }
+
+  return erased.size();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentHybrid<Ty,Weighted,Directed>::VerticesSize() const noexcept
+{
+  return list_.size();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentHybrid<Ty,Weighted,Directed>::EdgeSize() const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::EDGE_SIZE);
+  return arcs_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+MemoryFootprint AdjacentHybrid<Ty,Weighted,Directed>::MemoryUsage() const noexcept
+{
+  constexpr std::size_t kVertexNode = MapNodeSize<typename std::map<index_t, Node>::value_type>();
+
+  MemoryFootprint usage;
+  usage.vertex_table_ = sizeof(*this) + list_.size() * kVertexNode;
+  usage.slack_ = list_.size() * (AllocationSize(kVertexNode) - kVertexNode);
+  values_.Account(usage);
+  for (auto &entry : list_)
+  {
+    entry.second.out_.Account(usage.adjacency_, usage.slack_);
+    DIRECTED_GRAPH
+      entry.second.in_.Account(usage.indices_, usage.slack_);
+  }
+
+  weight_index_.Account(usage);
+  return usage;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+double AdjacentHybrid<Ty,Weighted,Directed>::Density() const noexcept
+{
+  double vertices = static_cast<double>(list_.size());
+  if (vertices < 2)
+    return 0;
+
+  return static_cast<double>(arcs_) / (vertices * (vertices - 1));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::IsDense(index_t s) const noexcept
+{
+  auto iter = list_.find(s);
+  return iter != list_.end() && iter->second.out_.IsDense();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::DenseRows() const noexcept
+{
+  std::size_t count = 0;
+  for (auto &entry : list_)
+    count += entry.second.out_.IsDense() + entry.second.in_.IsDense();
+  return count;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentHybrid<Ty,Weighted,Directed>::Degree(index_t s) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::DEGREE);
+  Instrumentation::CountLookups(1);
+
+  auto iter = list_.find(s);
+  if (iter == list_.end())
+    return 0;
+
+  DIRECTED_GRAPH
+    return static_cast<size_t>(iter->second.in_.Degree() + iter->second.out_.Degree());
+  ELSE
+    return static_cast<size_t>(iter->second.out_.Degree());
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentHybrid<Ty,Weighted,Directed>::InDegree(index_t s) const noexcept
+{
+  const Row *row = InRow(s);
+  return row ? static_cast<size_t>(row->Degree()) : 0;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentHybrid<Ty,Weighted,Directed>::OutDegree(index_t s) const noexcept
+{
+  auto iter = list_.find(s);
+  return iter == list_.end() ? 0 : static_cast<size_t>(iter->second.out_.Degree());
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::HAS_EDGE);
+  Instrumentation::CountLookups(1);
+
+  auto iter = list_.find(start);
+  return iter != list_.end() && iter->second.out_.Find(dest) != kDisconnected;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::HasEdge(const EdgeType &edge) const noexcept
+{
+  return HasEdge(edge.start_, edge.destination_);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::ExistsEdge(const EdgeType &edge) const noexcept
+{
+  weight_t weight = WeightOfEdge(edge.start_, edge.destination_);
+  if (weight == kDisconnected)
+    return false;
+
+  WEIGHTED_GRAPH
+    return weight == edge.weight_;
+  ELSE
+    return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::InsertEdge(index_t start, index_t dest, weight_t weight) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::INSERT_EDGE);
+  auto reindex = weight_index_.TrackArc(*this, start, dest);
+
+  Instrumentation::CountLookups(1);
+  auto from = list_.find(start);
+  if (from == list_.end())
+    return false;
+
+  Instrumentation::CountLookups(1);
+  auto to = list_.find(dest);
+  if (to == list_.end())
+    return false;
+
+  Link(from->second, start, to->second, dest, weight);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::InsertEdge(const EdgeType &edge) noexcept
+{
+  WEIGHTED_GRAPH
+    return InsertEdge(edge.start_, edge.destination_, edge.weight_);
+  ELSE
+    return InsertEdge(edge.start_, edge.destination_);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::EraseEdge(index_t start, index_t dest) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::ERASE_EDGE);
+  auto reindex = weight_index_.TrackArc(*this, start, dest);
+
+  /* If the edge exists, then remove it and return true
+   * If the edge doesn't exists, return true;
+  */
+  Instrumentation::CountLookups(1);
+  auto from = list_.find(start);
+  if (from == list_.end())
+    return false;
+
+  Instrumentation::CountLookups(1);
+  auto to = list_.find(dest);
+  if (to == list_.end())
+    return false;
+
+  Unlink(from->second, start, to->second, dest);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::EraseEdges(const std::vector<EdgeType> &edges) noexcept
+{
+  auto reindex = weight_index_.TrackArcs(*this, edges);
+
+  // arcs to remove from the out rows, both directions of an undirected edge
+  std::vector<std::pair<index_t, index_t>> arcs;
+  arcs.reserve(Directed ? edges.size() : 2 * edges.size());
+  for (const EdgeType &edge : edges)
+  {
+    arcs.emplace_back(edge.start_, edge.destination_);
+    NON_DIRECTED_GRAPH
+      if (edge.start_ != edge.destination_)
+        arcs.emplace_back(edge.destination_, edge.start_);
+  }
+  std::sort(arcs.begin(), arcs.end());
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+  // an undirected edge is two arcs, a self-loop one
+  std::size_t loops = 0;
+  NON_DIRECTED_GRAPH
+    for (auto &arc : arcs)
+      if (arc.first == arc.second && WeightOfEdge(arc.first, arc.first) != kDisconnected)
+        ++loops;
+
+  std::size_t count = EraseArcs(arcs, [](Node &node) -> Row & { return node.out_; });
+  arcs_ -= count;
+
+  DIRECTED_GRAPH_BEGIN
+    for (auto &arc : arcs)
+      std::swap(arc.first, arc.second);
+    std::sort(arcs.begin(), arcs.end());
+    EraseArcs(arcs, [](Node &node) -> Row & { return node.in_; });
+  DIRECTED_GRAPH_END
+
+  return Directed ? count : (count + loops) / 2;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::ApplyDelta(const std::vector<EdgeDelta> &delta,
+                                                             std::vector<std::uint8_t> &applied,
+                                                             unsigned threads) noexcept
+{
+  auto reindex = weight_index_.TrackArcs(*this, delta);
+  applied.assign(delta.size(), 0);
+
+  std::vector<DeltaArc> arcs;
+  MakeDeltaArcs(delta, Directed, [this](index_t id) { return list_.count(id) != 0; }, arcs);
+  std::vector<std::size_t> groups;
+  GroupDeltaArcs(arcs, groups);
+
+  // find the rows before the workers start, so the map is only read and every row has one writer
+  std::vector<Row *> rows(groups.size() - 1);
+  for (std::size_t group = 0; group < rows.size(); ++group)
+  {
+    const DeltaArc &arc = arcs[groups[group]];
+    Instrumentation::CountLookups(1);
+    Node &node = list_.find(arc.row_)->second;
+    rows[group] = arc.in_list_ ? &node.in_ : &node.out_;
+  }
+
+  const std::size_t width = Width();
+  std::vector<std::ptrdiff_t> added(threads ? threads : DefaultConcurrency(), 0);
+  ParallelFor(0, rows.size(), static_cast<unsigned>(added.size()),
+              [&](unsigned worker, std::size_t first, std::size_t last) {
+    for (std::size_t group = first; group < last; ++group)
+    {
+      std::ptrdiff_t change = rows[group]->Merge(arcs.data() + groups[group], arcs.data() + groups[group + 1], applied.data());
+      rows[group]->Adapt(width);
+      if (!arcs[groups[group]].in_list_)
+        added[worker] += change;
+    }
+  });
+
+  for (std::ptrdiff_t change : added)
+    arcs_ = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(arcs_) + change);
+
+  return static_cast<std::size_t>(std::count(applied.begin(), applied.end(), 1));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdge(index_t s, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  if (!append)
+    res.clear();
+
+  return GetEdgeIn(s, res, true) && GetEdgeOut(s, res, true);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::GET_EDGE_IN);
+
+  if (!list_.count(destination))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, destination, weight);
+    ELSE
+      res.emplace_back(start, destination);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+Edge<true> AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeIn(index_t destination, EdgeWeight type) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::IN, destination)) {
+    const WeightedNeighbor *found = WeightIndex<Directed>::Extreme(*row, type);
+    return found ? Edge<true>(found->neighbor_, destination, found->weight_) : Edge<true>(-1,-1,kDisconnected);
+  }
+
+  index_t current_start = -1;
+  weight_t current_weight = type == EdgeWeight::MIN ? kWeightMax : kWeightMin;
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    if ((type == EdgeWeight::MIN && weight < current_weight) ||
+        (type == EdgeWeight::MAX && weight > current_weight)) {
+      current_start = start;
+      current_weight = weight;
+    }
+  });
+
+  if(current_start == static_cast<index_t>(-1))
+    return Edge<true>(-1,-1,kDisconnected);
+  else
+    return Edge<true>(current_start,destination,current_weight);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Queue>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeInOrdered(index_t destination, Queue&& queue, bool append) const noexcept
+{
+  static_assert(Weighted,"The edges are non-weighted.");
+
+  if (!list_.count(destination))
+    return false;
+
+  if (!append)
+    queue = { };
+
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    queue.emplace(start, destination, weight);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::GET_EDGE_OUT);
+
+  auto iter = list_.find(start);
+  if (iter == list_.end())
+    return false;
+
+  if (!append)
+    res.clear();
+
+  res.reserve(res.size() + iter->second.out_.Degree());
+  iter->second.out_.ForEach([&](index_t dest, weight_t weight) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, dest, weight);
+    ELSE
+      res.emplace_back(start, dest);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+Edge<true> AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeOut(index_t start, EdgeWeight type) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::OUT, start)) {
+    const WeightedNeighbor *found = WeightIndex<Directed>::Extreme(*row, type);
+    return found ? Edge<true>(start, found->neighbor_, found->weight_) : Edge<true>(-1,-1,kDisconnected);
+  }
+
+  index_t current_destination = -1;
+  weight_t current_weight = type == EdgeWeight::MIN ? kWeightMax : kWeightMin;
+  ForEachOut(start, [&](index_t dest, weight_t weight) {
+    if ((type == EdgeWeight::MIN && weight < current_weight) ||
+        (type == EdgeWeight::MAX && weight > current_weight)) {
+      current_destination = dest;
+      current_weight = weight;
+    }
+  });
+
+  if(current_destination == static_cast<index_t>(-1))
+    return Edge<true>(-1,-1,kDisconnected);
+  else
+    return Edge<true>(start,current_destination,current_weight);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeOut(index_t start,
+                                                      EdgeWeight type,
+                                                      std::size_t k,
+                                                      std::vector<EdgeType> &res,
+                                                      bool append) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!list_.count(start))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  auto emit = [&](index_t dest, weight_t weight) { res.emplace_back(start, dest, weight); };
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::OUT, start))
+    WeightIndex<Directed>::Select(*row, type, k, emit);
+  else
+    WeightIndex<Directed>::SelectScan([&](auto &&visit) { ForEachOut(start, visit); }, type, k, emit);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeIn(index_t destination,
+                                                     EdgeWeight type,
+                                                     std::size_t k,
+                                                     std::vector<EdgeType> &res,
+                                                     bool append) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!list_.count(destination))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  auto emit = [&](index_t start, weight_t weight) { res.emplace_back(start, destination, weight); };
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::IN, destination))
+    WeightIndex<Directed>::Select(*row, type, k, emit);
+  else
+    WeightIndex<Directed>::SelectScan([&](auto &&visit) { ForEachIn(destination, visit); }, type, k, emit);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentHybrid<Ty,Weighted,Directed>::IndexWeights(bool enable) noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!enable)
+    weight_index_.Clear();
+  else if (!weight_index_.Enabled())
+    weight_index_.Build(*this);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::WeightsIndexed() const noexcept
+{
+  return weight_index_.Enabled();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Queue>
+bool AdjacentHybrid<Ty,Weighted,Directed>::GetEdgeOutOrdered(index_t start, Queue&& queue, bool append) const noexcept
+{
+  static_assert(Weighted,"The edges are non-weighted.");
+
+  if (!list_.count(start))
+    return false;
+
+  if (!append)
+    queue = { };
+
+  ForEachOut(start, [&](index_t dest, weight_t weight) {
+    queue.emplace(start, dest, weight);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void AdjacentHybrid<Ty,Weighted,Directed>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  auto iter = list_.find(start);
+  if (iter != list_.end())
+    iter->second.out_.ForEach(visit);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void AdjacentHybrid<Ty,Weighted,Directed>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  if (const Row *row = InRow(dest))
+    row->ForEach(visit);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+weight_t AdjacentHybrid<Ty,Weighted,Directed>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::WEIGHT_OF_EDGE);
+  Instrumentation::CountLookups(1);
+
+  auto iter = list_.find(start);
+  if (iter == list_.end())
+    return kDisconnected;
+
+  return iter->second.out_.Find(dest);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentHybrid<Ty,Weighted,Directed>::Print() const noexcept
+{
+  for (auto &iter : list_)
+  {
+    std::cout << "[" << iter.first << "]" << (iter.second.out_.IsDense() ? "(dense)" : "");
+    if (!iter.second.out_.Degree())
+      std::cout << "->[none,none]";
+
+    iter.second.out_.ForEach([](index_t dest, weight_t weight) {
+      WEIGHTED_GRAPH
+        std::cout << "->[" << dest << "," << weight << "]";
+      ELSE
+        std::cout << "->[" << dest << "]";
+    });
+    std::cout << '\n';
+  }
+  std::cout << std::endl;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <bool Ascending>
+decltype(auto) AdjacentHybrid<Ty,Weighted,Directed>::makeEdgeQueue() const noexcept
+{
+  if constexpr (Ascending)
+    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::greater<>>();
+  else
+    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::less<>>();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+decltype(auto) AdjacentHybrid<Ty,Weighted,Directed>::begin() const noexcept
+{
+  return list_.begin();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+decltype(auto) AdjacentHybrid<Ty,Weighted,Directed>::end() const noexcept
+{
+  return list_.end();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::Width() const noexcept
+{
+  return list_.empty() ? 0 : static_cast<std::size_t>(list_.rbegin()->first) + 1;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto AdjacentHybrid<Ty,Weighted,Directed>::InRow(index_t dest) const noexcept -> const Row *
+{
+  auto iter = list_.find(dest);
+  if (iter == list_.end())
+    return nullptr;
+
+  // undirected rows hold both directions, so the in-edges mirror the out-edges
+  DIRECTED_GRAPH
+    return &iter->second.in_;
+  ELSE
+    return &iter->second.out_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::Link(Node &start, index_t start_id, Node &dest, index_t dest_id, weight_t weight) noexcept
+{
+  const std::size_t width = Width();
+  if (!start.out_.Insert(dest_id, weight))
+  {
+    // it already exists: only the weight of the mirror changes
+    WEIGHTED_GRAPH
+      (Directed ? dest.in_ : dest.out_).Insert(start_id, weight);
+    return false;
+  }
+
+  start.out_.Adapt(width);
+  ++arcs_;
+
+  DIRECTED_GRAPH_BEGIN
+    dest.in_.Insert(start_id, weight);
+    dest.in_.Adapt(width);
+  DIRECTED_GRAPH_END
+  NON_DIRECTED_GRAPH_BEGIN
+    if (start_id != dest_id) {
+      dest.out_.Insert(start_id, weight);
+      dest.out_.Adapt(width);
+      ++arcs_;
+    }
+  NON_DIRECTED_GRAPH_END
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentHybrid<Ty,Weighted,Directed>::Unlink(Node &start, index_t start_id, Node &dest, index_t dest_id) noexcept
+{
+  if (!start.out_.Erase(dest_id))
+    return false;
+
+  const std::size_t width = Width();
+  start.out_.Adapt(width);
+  --arcs_;
+
+  DIRECTED_GRAPH_BEGIN
+    dest.in_.Erase(start_id);
+    dest.in_.Adapt(width);
+  DIRECTED_GRAPH_END
+  NON_DIRECTED_GRAPH_BEGIN
+    if (start_id != dest_id) {
+      dest.out_.Erase(start_id);
+      dest.out_.Adapt(width);
+      --arcs_;
+    }
+  NON_DIRECTED_GRAPH_END
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename RowOf>
+std::size_t AdjacentHybrid<Ty,Weighted,Directed>::EraseArcs(const std::vector<std::pair<index_t, index_t>> &arcs,
+                                                            RowOf&& row_of) noexcept
+{
+  const std::size_t width = Width();
+  std::size_t count = 0;
+  for (std::size_t first = 0, last = 0; first < arcs.size(); first = last)
+  {
+    for (last = first; last < arcs.size() && arcs[last].first == arcs[first].first; ++last);
+
+    Instrumentation::CountLookups(1);
+    auto iter = list_.find(arcs[first].first);
+    if (iter == list_.end())
+      continue;
+
+    // the columns of the run are sorted, so membership is a binary search
+    Row &row = row_of(iter->second);
+    count += row.EraseIf([&](index_t column) {
+      auto pos = std::lower_bound(arcs.begin() + first, arcs.begin() + last, std::make_pair(arcs[first].first, column));
+      return pos != arcs.begin() + last && pos->second == column;
+    });
+    row.Adapt(width);
+  }
+  return count;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
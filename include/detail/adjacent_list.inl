@@ -1,690 +1,1556 @@
-#include "../adjacent_list.hpp"
-
-namespace smart_graph {
-namespace smart_graph_impl {
-
-template <bool Weighted>
-InternalList<Weighted>::InternalList(NodePtr head_ptr): head_(head_ptr)
-{
-
-}
-
-template <bool Weighted>
-InternalList<Weighted>::InternalList(const InternalList& rhs)
-{
-  head_ = rhs.head_;
-}
-
-template <bool Weighted>
-weight_t InternalList<Weighted>::operator[](index_t dest) const noexcept
-{
-  if(!IsVaild())
-    return kDisconnected;
-
-  NodePtr current = head_;
-  while(current)
-  {
-    if(current->destination_ == dest) {
-      WEIGHTED_GRAPH
-        return current->weight_;
-      ELSE
-        return kConnected;
-    }
-
-    current = current->next_;
-  }
-
-  return kDisconnected;
-}
-
-template <bool Weighted>
-bool InternalList<Weighted>::IsVaild() const noexcept
-{
-  return head_ != nullptr;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-AdjacentList<Ty,Weighted,Directed>::AdjacentList(): list_()
-{
-
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-AdjacentList<Ty,Weighted,Directed>::~AdjacentList()
-{
-  std::vector<index_t> v;
-  for (auto& [index,ptr] : list_)
-    v.push_back(index);
-  for (auto &i : v)
-    EraseVertex(i);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-AdjacentList<Ty,Weighted,Directed>::AdjacentList(const AdjacentList& rhs)
-{
-  std::vector<EdgeType> tmp;
-  for(auto& [index,node_ptr] : rhs.list_)
-  {
-    RegisterVertex(index,rhs.At(index).value());
-    rhs.GetEdgeOut(index,tmp,true);
-  }
-
-  for(auto& edge : tmp)
-    InsertEdge(edge);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-AdjacentList<Ty,Weighted,Directed>::AdjacentList(AdjacentList&& rhs):
-    list_(std::move(rhs.list_))
-{
-    
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-InternalList<Weighted> AdjacentList<Ty,Weighted,Directed>::operator[](index_t pos) const noexcept
-{
-  typename std::map<index_t,Node>::const_iterator iter = list_.find(pos);
-  if(iter == list_.end())
-    return InternalList<Weighted>();
-  else
-    return InternalList<Weighted>(iter->second.second);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-std::optional<Ty> AdjacentList<Ty,Weighted,Directed>::At(index_t id) const
-{
-  if (!list_.count(id))
-    return std::nullopt;
-
-  return list_.find(id)->second.first;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-template <typename Arg>
-bool AdjacentList<Ty,Weighted,Directed>::Emplace(size_t s, Arg&& value) noexcept
-{
-  if (!list_.count(s))
-    return false;
-
-  list_[s].first = value;
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-template <typename... Args>
-bool AdjacentList<Ty,Weighted,Directed>::RegisterVertex(index_t index, Args &&... args) noexcept
-{
-  auto [elem, success] = list_.try_emplace(index, std::make_pair(
-                                                                std::forward<Args>(args)...,
-                                                                nullptr));
-  return success;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::HasVertex(index_t s) const noexcept
-{
-  return list_.count(s);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::EraseVertex(index_t index) noexcept
-{
-  //cascade delete
-  if (!list_.count(index))
-    return false;
-
-  auto link = list_[index].second;
-  if (!link)
-    return true;
-
-  auto prev = link;
-  while (prev)
-  {
-    link = prev->next_;
-    delete prev;
-    prev = link;
-  }
-  list_[index].second = nullptr;
-
-  bool success = true;
-  for (auto &i : list_)
-    if (!EraseEdge(i.first, index))
-      success = false;
-
-  list_.erase(index);
-  return success;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-size_t AdjacentList<Ty,Weighted,Directed>::VerticesSize() const noexcept
-{
-  return list_.size();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-size_t AdjacentList<Ty,Weighted,Directed>::EdgeSize() const noexcept
-{
-  size_t count = 0;
-  std::vector<EdgeType> cont;
-  for (auto &iter : list_)
-    if (GetEdgeOut(iter.first, cont))
-      count += cont.size();
-
-  return count;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-size_t AdjacentList<Ty,Weighted,Directed>::Degree(index_t s) const noexcept
-{
-  if (!list_.count(s))
-    return 0;
-
-  DIRECTED_GRAPH
-    return InDegree(s) + OutDegree(s);
-  ELSE 
-    return (InDegree(s) + OutDegree(s)) / 2;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-size_t AdjacentList<Ty,Weighted,Directed>::InDegree(index_t s) const noexcept
-{
-  std::vector<EdgeType> v;
-  GetEdgeIn(s, v);
-  return v.size();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-size_t AdjacentList<Ty,Weighted,Directed>::OutDegree(index_t s) const noexcept
-{
-  std::vector<EdgeType> v;
-  GetEdgeOut(s, v);
-  return v.size();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::HasEdge(index_t start, index_t dest) const noexcept
-{
-  if (FetchEdge(start, dest))
-    return true;
-  else
-    return false;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::HasEdge(const EdgeType &edge) const noexcept
-{
-  WEIGHTED_GRAPH_BEGIN
-    const auto &[s, d, weight] = edge;
-    return HasEdge(s, d);
-  WEIGHTED_GRAPH_END
-
-  NON_WEIGHTED_GRAPH_BEGIN
-    const auto &[s, d] = edge;
-    return HasEdge(s, d);
-  NON_WEIGHTED_GRAPH_END
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::ExistsEdge(const EdgeType &edge) const noexcept
-{
-  // Do check first
-  if (Link tg = FetchEdge(edge.start_, edge.destination_); tg)
-  {
-    WEIGHTED_GRAPH
-      return tg->weight_ == edge.weight_;
-    ELSE 
-      return true;
-  }
-
-  return false;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::InsertEdge(index_t start, index_t dest, weight_t weight, bool firstInsert) noexcept
-{
-  if (!list_.count(start) || !list_.count(dest))
-    return false;
-
-  //
-  Link current = list_[start].second;
-
-  if (!current)
-  {
-    WEIGHTED_GRAPH
-      list_[start].second = new LinkType(dest, weight);
-    ELSE
-      list_[start].second = new LinkType(dest);
-
-    NON_DIRECTED_GRAPH
-      if (firstInsert)
-        return InsertEdge(dest, start, weight, false);
-
-    return true;
-  }
-
-  while (current && current->next_ && current->next_->destination_ < dest)
-  {
-    //check if it already exists
-    if (current->destination_ == dest)
-    {
-      // change its weight and return (only in weighted graph)
-      // just return (in non-weighted graph)
-      WEIGHTED_GRAPH
-        current->weight_ = weight;
-
-      NON_DIRECTED_GRAPH
-        if (firstInsert)
-          return InsertEdge(dest, start, weight, false);
-
-      return true;
-    }
-    current = current->next_;
-  }
-
-  WEIGHTED_GRAPH
-    if (current != list_[start].second || current->destination_ < dest)
-      current->next_ = new LinkType(dest, weight, current->next_);
-    else
-      list_[start].second = new LinkType(dest, weight, current);
-  ELSE
-    if (current != list_[start].second || current->destination_ < dest)
-      current->next_ = new LinkType(dest, current->next_);
-    else 
-      list_[start].second = new LinkType(dest, current);
-
-  NON_DIRECTED_GRAPH
-    if (firstInsert)
-      return InsertEdge(dest, start, weight, false);
-
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::InsertEdge(const EdgeType &edge) noexcept
-{
-  WEIGHTED_GRAPH
-    return InsertEdge(edge.start_, edge.destination_, edge.weight_);
-  ELSE 
-    return InsertEdge(edge.start_, edge.destination_);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::EraseEdge(index_t start, index_t dest) noexcept
-{
-  /* If the edge exists, then remove it and return true
-   * If the edge doesn't exists, return true;
-  */
-  if (!list_.count(start) || !list_.count(dest))
-    return false;
-
-  auto current = list_[start].second;
-  if (!current)
-    return true;
-
-  auto prev = current;
-  while (current)
-  {
-    if (current->destination_ == dest) {
-      if (current != list_[start].second)
-        prev->next_ = current->next_;
-      else
-        list_[start].second = current->next_;
-
-      delete current;
-      DIRECTED_GRAPH
-        return true;
-      ELSE 
-        return EraseEdge(dest, start);
-    }
-
-    prev = current;
-    current = current->next_;
-  }
-
-  //not found
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::GetEdge(index_t s, std::vector<EdgeType> &res, bool append) const noexcept
-{
-  if (!append)
-    res.clear();
-
-  return GetEdgeIn(s, res, true) && GetEdgeOut(s, res, true);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
-{
-  if (!list_.count(destination))
-    return false;
-
-  if (!append)
-    res.clear();
-
-  for (auto &[start,node] : list_)
-  {
-    Link current = FetchEdge(start, destination);  
-    if (current) {
-      WEIGHTED_GRAPH
-        res.emplace_back(start, destination, current->weight_);
-      ELSE
-        res.emplace_back(start, destination);
-    }
-  }
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-Edge<true> AdjacentList<Ty,Weighted,Directed>::GetEdgeIn(index_t destination,EdgeWeight type) const noexcept
-{
-  static_assert(Weighted,"Function can't work if the graph is not weighted.");
-
-  typename std::map<index_t,Node>::const_iterator iter = list_.find(destination);
-  if(iter == list_.end() || !iter->second.second)
-    return Edge<true>(-1,-1,kDisconnected);
-  
-  index_t current_start = -1;
-  weight_t current_weight = 0;
-  if(type == EdgeWeight::MIN)
-    current_weight = kWeightMax;
-  else if ( type == EdgeWeight::MAX)
-    current_weight = kWeightMin;
-
-  for(auto& [start,node] : list_)
-  {
-    Link current = FetchEdge(start,destination);
-    if(!current)
-      continue;
-
-    if(type == EdgeWeight::MIN)
-    {
-      if(current->weight_ < current_weight) {
-        current_start = start;
-        current_weight = current->weight_;
-      }
-    } else if (type == EdgeWeight::MAX) {
-        if(current->weight_ > current_weight) {
-        current_start = start;
-        current_weight = current->weight_;
-      }
-    }
-  }
-
-  if(current_start == -1)
-    return Edge<true>(-1,-1,kDisconnected);
-  else
-    return Edge<true>(current_start,destination,current_weight);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-template <typename Queue>
-bool AdjacentList<Ty,Weighted,Directed>::GetEdgeInOrdered(index_t destination, Queue&& queue, bool append) const noexcept
-{
-  static_assert(Weighted,"The edges are non-weighted.");
-
-  if (!list_.count(destination))
-        return false;
-
-  if (!append)
-    queue = { };
-
-  for (auto &iter : list_)
-  {
-    Link current = FetchEdge(iter.first, destination);
-    if (current) {
-      WEIGHTED_GRAPH
-        queue.emplace(iter.first, destination, current->weight_);
-      ELSE
-        queue.emplace(iter.first, destination);
-    }
-  }
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-bool AdjacentList<Ty,Weighted,Directed>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
-{
-  if (!list_.count(start))
-    return false;
-
-  if (!append)
-    res.clear();
-
-  typename std::map<index_t, Node>::const_iterator iter = list_.find(start);
-  auto current = iter->second.second;
-  while (current)
-  {
-    WEIGHTED_GRAPH
-      res.emplace_back(start, current->destination_, current->weight_);
-    ELSE
-      res.emplace_back(start, current->destination_);
-    
-    current = current->next_;
-  }
-
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-Edge<true> AdjacentList<Ty,Weighted,Directed>::GetEdgeOut(index_t start, EdgeWeight type) const noexcept
-{
-  static_assert(Weighted,"Function can't work if the graph is not weighted.");
-	
-  typename std::map<index_t,Node>::const_iterator iter = list_.find(start);
-  if(iter == list_.end() || !iter->second.second)
-    return Edge<true>(-1,-1,kDisconnected);
-
-  auto current = iter->second.second;
-  weight_t current_weight = 0;
-
-  if(type == EdgeWeight::MIN)
-    current_weight = kWeightMax;
-  else if ( type == EdgeWeight::MAX)
-    current_weight = kWeightMin;
-
-  index_t current_destination = -1;
-
-  if(type == EdgeWeight::MIN) {
-    // Get the edge which has the least weight
-    while(current)
-    {
-      if(current->weight_ < current_weight) {
-        current_destination = current->destination_;
-        current_weight = current->weight_;
-      }
-
-      current = current->next_;
-    }
-  } else if (type == EdgeWeight::MAX) {
-    // Get the edge which has the greatest weight
-    while(current)
-    {
-      if(current->weight_ > current_weight) {
-        current_destination = current->destination_;
-	      current_weight = current->weight_;
-      }
-
-      current = current->next_;
-    }
-  }
-
-  if(current_destination == -1)
-    return Edge<true>(-1,-1,kDisconnected);
-  else
-    return Edge<true>(start,current_destination,current_weight);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-template <typename Queue>
-bool AdjacentList<Ty,Weighted,Directed>::GetEdgeOutOrdered(index_t start, Queue&& queue, bool append) const noexcept
-{
-  static_assert(Weighted,"The edges are non-weighted.");
-
-  if (!list_.count(start))
-    return false;
-
-  if (!append)
-    queue = { };
-
-  typename std::map<index_t, Node>::const_iterator iter = list_.find(start);
-  auto current = iter->second.second;
-  while (current)
-  {
-    WEIGHTED_GRAPH
-      queue.emplace(start, current->destination_, current->weight_);
-    ELSE
-      queue.emplace(start, current->destination_);
-
-    current = current->next_;
-  }
-
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-weight_t AdjacentList<Ty,Weighted,Directed>::WeightOfEdge(index_t start, index_t dest) const noexcept
-{
-  if (Link edge = FetchEdge(start, dest); edge != nullptr) {
-    WEIGHTED_GRAPH
-      return edge->weight_;
-    ELSE
-      return kConnected;
-  } else
-    return kDisconnected;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-void AdjacentList<Ty,Weighted,Directed>::Print() const noexcept
-{
-  for (auto &iter : list_)
-  {
-    std::cout << "[" << iter.first << "]";
-    bool has_path = false;
-    for (auto current = iter.second.second; current != nullptr; current = current->next_)
-    {
-      has_path = true;
-      WEIGHTED_GRAPH
-        std::cout << "->[" << current->destination_ << "," << current->weight_ << "]";
-      ELSE
-        std::cout << "->[" << current->destination_ << "]";
-    }
-    if (!has_path)
-      std::cout << "->[none,none]";
-
-    std::cout << '\n';
-  }
-  std::cout << std::endl;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-template <bool Ascending>
-decltype(auto) AdjacentList<Ty,Weighted,Directed>::makeEdgeQueue() const noexcept
-{
-  if constexpr (Ascending)
-    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::greater<>>();
-  else
-    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::less<>>();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-decltype(auto) AdjacentList<Ty,Weighted,Directed>::begin() const noexcept
-{
-  return list_.begin();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-decltype(auto) AdjacentList<Ty,Weighted,Directed>::end() const noexcept
-{
-  return list_.end();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed>
-auto AdjacentList<Ty,Weighted,Directed>::FetchEdge(index_t start, index_t dest) const noexcept ->Link
-{
-  if (!list_.count(start))
-    return nullptr;
-
-  typename std::map<index_t, Node>::const_iterator iter = list_.find(start);
-  Link current = iter->second.second;
-  while (current)
-  {
-    if (current->destination_ == dest)
-      return current;
-
-     current = current->next_;
-  }
-
-  return nullptr;
-}
-}  // namespace smart_graph_impl
-}  // namespace smart_graph
+#include "../adjacent_list.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+index_t LinkTarget(const LinkNode<Weighted> *link, index_t) noexcept
+{
+  return link->destination_;
+}
+
+template <bool Weighted>
+LinkNode<Weighted> **LinkNext(LinkNode<Weighted> *link, index_t) noexcept
+{
+  return &link->next_;
+}
+
+template <bool Weighted>
+index_t LinkTarget(const EdgeNode<Weighted> *link, index_t owner) noexcept
+{
+  return link->ends_[link->ends_[0] == owner];
+}
+
+template <bool Weighted>
+EdgeNode<Weighted> **LinkNext(EdgeNode<Weighted> *link, index_t owner) noexcept
+{
+  return &link->next_[link->ends_[0] != owner];
+}
+
+template <bool Weighted,
+          bool Directed>
+InternalList<Weighted,Directed>::InternalList(NodePtr head_ptr, index_t owner): head_(head_ptr), owner_(owner)
+{
+
+}
+
+template <bool Weighted,
+          bool Directed>
+InternalList<Weighted,Directed>::InternalList(const InternalList& rhs)
+{
+  head_ = rhs.head_;
+  owner_ = rhs.owner_;
+}
+
+template <bool Weighted,
+          bool Directed>
+weight_t InternalList<Weighted,Directed>::operator[](index_t dest) const noexcept
+{
+  if(!IsVaild())
+    return kDisconnected;
+
+  NodePtr current = head_;
+  while(current)
+  {
+    if(LinkTarget(current, owner_) == dest) {
+      WEIGHTED_GRAPH
+        return current->weight_;
+      ELSE
+        return kConnected;
+    }
+
+    current = *LinkNext(current, owner_);
+  }
+
+  return kDisconnected;
+}
+
+template <bool Weighted,
+          bool Directed>
+bool InternalList<Weighted,Directed>::IsVaild() const noexcept
+{
+  return head_ != nullptr;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentList<Ty,Weighted,Directed>::AdjacentList(): list_()
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentList<Ty,Weighted,Directed>::~AdjacentList()
+{
+  // ascending, so each undirected node is deleted by the second of its lists
+  for (auto &entry : list_)
+    Free(entry.second, entry.first);
+  for (auto &entry : reverse_)
+    Free(entry.second, entry.first);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentList<Ty,Weighted,Directed>::AdjacentList(const AdjacentList& rhs)
+{
+  std::vector<EdgeType> tmp;
+  for(auto& [index,node_ptr] : rhs.list_)
+  {
+    RegisterVertex(index,rhs.At(index).value());
+    rhs.GetEdgeOut(index,tmp,true);
+  }
+
+  for(auto& edge : tmp)
+    InsertEdge(edge);
+
+  // copied once the edges are in, the inserts above would track them a second time
+  weight_index_ = rhs.weight_index_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+AdjacentList<Ty,Weighted,Directed>::AdjacentList(AdjacentList&& rhs):
+    list_(std::move(rhs.list_)), reverse_(std::move(rhs.reverse_)), values_(std::move(rhs.values_)),
+    weight_index_(std::move(rhs.weight_index_))
+{
+  rhs.values_.Clear();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+InternalList<Weighted,Directed> AdjacentList<Ty,Weighted,Directed>::operator[](index_t pos) const noexcept
+{
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(pos);
+  if(iter == list_.end())
+    return InternalList<Weighted,Directed>();
+  else
+    return InternalList<Weighted,Directed>(iter->second, pos);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::optional<Ty> AdjacentList<Ty,Weighted,Directed>::At(index_t id) const
+{
+  const Ty *value = values_.Find(id);
+  if (!value)
+    return std::nullopt;
+
+  return *value;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Arg>
+bool AdjacentList<Ty,Weighted,Directed>::Emplace(size_t s, Arg&& value) noexcept
+{
+  return values_.Assign(s, std::forward<Arg>(value));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename... Args>
+bool AdjacentList<Ty,Weighted,Directed>::RegisterVertex(index_t index, Args &&... args) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::REGISTER_VERTEX);
+  Instrumentation::CountLookups(1);
+
+  if (!values_.Emplace(index, std::forward<Args>(args)...))
+    return false;
+
+  list_.try_emplace(index, nullptr);
+  DIRECTED_GRAPH
+    reverse_.try_emplace(index, nullptr);
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::HasVertex(index_t s) const noexcept
+{
+  Instrumentation::CountLookups(1);
+  return values_.Has(s);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::EraseVertex(index_t index) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::ERASE_VERTEX);
+  Instrumentation::CountLookups(1);
+  auto reindex = weight_index_.TrackVertex(*this, index);
+
+  auto iter = list_.find(index);
+  if (iter == list_.end())
+    return false;
+
+  //cascade delete: the out-edges are unlinked from the lists of their destinations
+  for (Link link = iter->second; link != nullptr;)
+  {
+    Instrumentation::CountLookups(1);
+    index_t dest = LinkTarget(link, index);
+    Link next = *LinkNext(link, index);
+    DIRECTED_GRAPH
+      delete Detach(&reverse_.find(dest)->second, dest, index);
+    ELSE
+      if (dest != index)
+        Detach(&list_.find(dest)->second, dest, index);
+
+    delete link;
+    link = next;
+  }
+
+  // and the in-edges of a directed graph from the lists of their starts
+  DIRECTED_GRAPH_BEGIN
+    auto in = reverse_.find(index);
+    for (Link link = in->second; link != nullptr; link = *LinkNext(link, index))
+    {
+      Instrumentation::CountLookups(1);
+      index_t start = LinkTarget(link, index);
+      delete Detach(&list_.find(start)->second, start, index);
+    }
+
+    Free(in->second, index);
+    reverse_.erase(in);
+  DIRECTED_GRAPH_END
+
+  list_.erase(iter);
+  values_.Erase(index);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentList<Ty,Weighted,Directed>::EraseVertices(const std::vector<index_t> &vertices) noexcept
+{
+  /*  Erasing one vertex walks the list of each of its neighbours up to it, a hub next door costing
+   *  its whole list; a sweep walks every list once. The neighbours' lists are measured first, and
+   *  the sweep is taken as soon as they add up to a few nodes per vertex of the graph.
+   */
+  constexpr std::size_t kSweepHopsPerVertex = 4;
+
+  if (list_.empty())
+    return 0;
+
+  std::vector<bool> doomed(static_cast<std::size_t>(list_.rbegin()->first) + 1, false);
+  std::vector<index_t> erased;
+  for (index_t index : vertices)
+    if (index < doomed.size() && !doomed[index] && list_.count(index)) {
+      doomed[index] = true;
+      erased.push_back(index);
+    }
+
+  // the nodes erasing one by one would walk, counted no further than the budget
+  const std::size_t budget = kSweepHopsPerVertex * list_.size();
+  std::size_t hops = 0;
+  auto walk = [&hops, budget](Link head, index_t owner) {
+    for (Link link = head; link && hops < budget; link = *LinkNext(link, owner))
+      ++hops;
+  };
+
+  for (std::size_t i = 0; i < erased.size() && hops < budget; ++i)
+  {
+    index_t index = erased[i];
+    for (Link link = list_.find(index)->second; link && hops < budget; link = *LinkNext(link, index))
+    {
+      index_t dest = LinkTarget(link, index);
+      walk(Directed ? reverse_.find(dest)->second : list_.find(dest)->second, dest);
+    }
+
+    DIRECTED_GRAPH
+      for (Link link = reverse_.find(index)->second; link && hops < budget; link = *LinkNext(link, index))
+      {
+        index_t start = LinkTarget(link, index);
+        walk(list_.find(start)->second, start);
+      }
+  }
+
+  if (hops < budget) {
+    for (index_t index : erased)
+      EraseVertex(index);
+    return erased.size();
+  }
+
+  auto reindex = weight_index_.TrackAll(*this);
+
+  /*  drop the lists of the tombstoned vertices, then the nodes pointing at them from the others;
+   *  the lists go in ascending order, so an undirected node is deleted by the second list to let it go
+   */
+  auto sweep = [&doomed](Link *head, index_t owner) {
+    while (*head)
+    {
+      Link link = *head;
+      if (doomed[LinkTarget(link, owner)]) {
+        *head = *LinkNext(link, owner);
+        if (Releases(link, owner))
+          delete link;
+      } else {
+        head = LinkNext(link, owner);
+      }
+    }
+  };
+
+  for (auto iter = list_.begin(); iter != list_.end();)
+  {
+    if (doomed[iter->first]) {
+      Free(iter->second, iter->first);
+      values_.Erase(iter->first);
+      iter = list_.erase(iter);
+    } else {
+      sweep(&iter->second, iter->first);
+      ++iter;
+    }
+  }
+
+  DIRECTED_GRAPH
+    for (auto iter = reverse_.begin(); iter != reverse_.end();)
+    {
+      if (doomed[iter->first]) {
+        Free(iter->second, iter->first);
+        iter = reverse_.erase(iter);
+      } else {
+        sweep(&iter->second, iter->first);
+        ++iter;
+      }
+    }
+
+  return erased.size();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentList<Ty,Weighted,Directed>::VerticesSize() const noexcept
+{
+  return list_.size();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentList<Ty,Weighted,Directed>::EdgeSize() const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::EDGE_SIZE);
+
+  size_t count = 0;
+  std::vector<EdgeType> cont;
+  for (auto &iter : list_)
+    if (GetEdgeOut(iter.first, cont))
+      count += cont.size();
+
+  return count;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+MemoryFootprint AdjacentList<Ty,Weighted,Directed>::MemoryUsage() const noexcept
+{
+  constexpr std::size_t kVertexNode = MapNodeSize<typename std::map<index_t, Link>::value_type>();
+  constexpr std::size_t kLinkNode = sizeof(LinkType);
+
+  MemoryFootprint usage;
+  usage.vertex_table_ = sizeof(*this);
+  values_.Account(usage);
+  for (auto &entry : list_)
+  {
+    usage.vertex_table_ += kVertexNode;
+    usage.slack_ += AllocationSize(kVertexNode) - kVertexNode;
+    for (Link link = entry.second; link; link = *LinkNext(link, entry.first))
+      if (Releases(link, entry.first))   // an undirected node is in two lists, count it once
+      {
+        usage.adjacency_ += kLinkNode;
+        usage.slack_ += AllocationSize(kLinkNode) - kLinkNode;
+      }
+  }
+
+  DIRECTED_GRAPH_BEGIN
+    for (auto &entry : reverse_)
+    {
+      usage.indices_ += kVertexNode;
+      usage.slack_ += AllocationSize(kVertexNode) - kVertexNode;
+      for (Link link = entry.second; link; link = *LinkNext(link, entry.first))
+      {
+        usage.indices_ += kLinkNode;
+        usage.slack_ += AllocationSize(kLinkNode) - kLinkNode;
+      }
+    }
+  DIRECTED_GRAPH_END
+
+  weight_index_.Account(usage);
+  return usage;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentList<Ty,Weighted,Directed>::Degree(index_t s) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::DEGREE);
+  Instrumentation::CountLookups(1);
+
+  if (!list_.count(s))
+    return 0;
+
+  DIRECTED_GRAPH
+    return InDegree(s) + OutDegree(s);
+  ELSE 
+    return (InDegree(s) + OutDegree(s)) / 2;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentList<Ty,Weighted,Directed>::InDegree(index_t s) const noexcept
+{
+  size_t count = 0;
+  ForEachIn(s, [&count](index_t, weight_t) { ++count; });
+  return count;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+size_t AdjacentList<Ty,Weighted,Directed>::OutDegree(index_t s) const noexcept
+{
+  size_t count = 0;
+  ForEachOut(s, [&count](index_t, weight_t) { ++count; });
+  return count;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::HAS_EDGE);
+
+  if (FetchEdge(start, dest))
+    return true;
+  else
+    return false;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::HasEdge(const EdgeType &edge) const noexcept
+{
+  WEIGHTED_GRAPH_BEGIN
+    const auto &[s, d, weight] = edge;
+    return HasEdge(s, d);
+  WEIGHTED_GRAPH_END
+
+  NON_WEIGHTED_GRAPH_BEGIN
+    const auto &[s, d] = edge;
+    return HasEdge(s, d);
+  NON_WEIGHTED_GRAPH_END
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::ExistsEdge(const EdgeType &edge) const noexcept
+{
+  // Do check first
+  if (Link tg = FetchEdge(edge.start_, edge.destination_); tg)
+  {
+    WEIGHTED_GRAPH
+      return tg->weight_ == edge.weight_;
+    ELSE 
+      return true;
+  }
+
+  return false;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::InsertEdge(index_t start, index_t dest, weight_t weight, bool firstInsert) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::INSERT_EDGE, firstInsert);
+  auto reindex = weight_index_.TrackArc(*this, start, dest);
+
+  Instrumentation::CountLookups(1);
+  auto from = list_.find(start);
+  if (from == list_.end())
+    return false;
+
+  Instrumentation::CountLookups(1);
+  auto to = list_.find(dest);
+  if (to == list_.end())
+    return false;
+
+  // the first node whose destination isn't less than dest, the list stays sorted
+  Link *slot = LowerBound(&from->second, start, dest);
+
+  if (*slot && LinkTarget(*slot, start) == dest) {
+    // it already exists: change its weight (only in weighted graph), an undirected node is shared
+    WEIGHTED_GRAPH_BEGIN
+      (*slot)->weight_ = weight;
+      DIRECTED_GRAPH_BEGIN
+        Instrumentation::CountLookups(1);
+        (*LowerBound(&reverse_[dest], dest, start))->weight_ = weight;
+      DIRECTED_GRAPH_END
+    WEIGHTED_GRAPH_END
+  } else {
+    Link link = MakeLink(start, dest, weight);
+    Splice(slot, link, start);
+    // a directed in-edge is a node of its own, an undirected edge links the same node into the list of dest
+    DIRECTED_GRAPH_BEGIN
+      Instrumentation::CountLookups(1);
+      Splice(LowerBound(&reverse_[dest], dest, start), MakeLink(dest, start, weight), dest);
+    DIRECTED_GRAPH_END
+    NON_DIRECTED_GRAPH
+      if (start != dest)
+        Splice(LowerBound(&to->second, dest, start), link, dest);
+  }
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::InsertEdge(const EdgeType &edge) noexcept
+{
+  WEIGHTED_GRAPH
+    return InsertEdge(edge.start_, edge.destination_, edge.weight_);
+  ELSE 
+    return InsertEdge(edge.start_, edge.destination_);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::EraseEdge(index_t start, index_t dest) noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::ERASE_EDGE);
+  auto reindex = weight_index_.TrackArc(*this, start, dest);
+
+  /* If the edge exists, then remove it and return true
+   * If the edge doesn't exists, return true;
+  */
+  Instrumentation::CountLookups(1);
+  auto from = list_.find(start);
+  if (from == list_.end())
+    return false;
+
+  Instrumentation::CountLookups(1);
+  auto to = list_.find(dest);
+  if (to == list_.end())
+    return false;
+
+  Link found = Detach(&from->second, start, dest);
+  if (!found)
+    return true; //not found
+
+  DIRECTED_GRAPH_BEGIN
+    Instrumentation::CountLookups(1);
+    delete Detach(&reverse_[dest], dest, start);
+  DIRECTED_GRAPH_END
+  NON_DIRECTED_GRAPH
+    if (start != dest)
+      Detach(&to->second, dest, start);
+
+  delete found;
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentList<Ty,Weighted,Directed>::EraseEdges(const std::vector<EdgeType> &edges) noexcept
+{
+  auto reindex = weight_index_.TrackArcs(*this, edges);
+
+  // arcs to remove from the out-lists, both directions of an undirected edge
+  std::vector<std::pair<index_t, index_t>> arcs;
+  arcs.reserve(Directed ? edges.size() : 2 * edges.size());
+  for (const EdgeType &edge : edges)
+  {
+    arcs.emplace_back(edge.start_, edge.destination_);
+    NON_DIRECTED_GRAPH
+      if (edge.start_ != edge.destination_)
+        arcs.emplace_back(edge.destination_, edge.start_);
+  }
+  std::sort(arcs.begin(), arcs.end());
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+  // every run of arcs with the same start is one merge walk over that start's list
+  auto unlink_runs = [](auto &lists, auto &&head_of, const std::vector<std::pair<index_t, index_t>> &sorted) {
+    std::size_t count = 0;
+    std::vector<index_t> run;
+    for (std::size_t first = 0, last = 0; first < sorted.size(); first = last)
+    {
+      run.clear();
+      for (last = first; last < sorted.size() && sorted[last].first == sorted[first].first; ++last)
+        run.push_back(sorted[last].second);
+
+      Instrumentation::CountLookups(1);
+      auto iter = lists.find(sorted[first].first);
+      if (iter != lists.end())
+        count += UnlinkSorted(head_of(*iter), iter->first, run.data(), run.data() + run.size());
+    }
+    return count;
+  };
+
+  // an undirected edge is two arcs, a self-loop one; its node goes with the second
+  std::size_t loops = 0;
+  NON_DIRECTED_GRAPH
+    for (auto &arc : arcs)
+      if (arc.first == arc.second && FetchEdge(arc.first, arc.first))
+        ++loops;
+
+  std::size_t count = unlink_runs(list_, [](auto &entry) { return &entry.second; }, arcs);
+
+  DIRECTED_GRAPH_BEGIN
+    for (auto &arc : arcs)
+      std::swap(arc.first, arc.second);
+    std::sort(arcs.begin(), arcs.end());
+    unlink_runs(reverse_, [](auto &entry) { return &entry.second; }, arcs);
+  DIRECTED_GRAPH_END
+
+  return Directed ? count : (count + loops) / 2;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentList<Ty,Weighted,Directed>::ApplyDelta(const std::vector<EdgeDelta> &delta,
+                                                           std::vector<std::uint8_t> &applied,
+                                                           unsigned threads) noexcept
+{
+  auto reindex = weight_index_.TrackArcs(*this, delta);
+  applied.assign(delta.size(), 0);
+
+  std::vector<DeltaArc> arcs;
+  MakeDeltaArcs(delta, Directed, [this](index_t id) { return list_.count(id) != 0; }, arcs);
+
+  /*  An undirected edge is one node in the lists of both of its ends: its arcs are merged into the
+   *  list of the smaller end first, then the node made or dropped there is linked into or out of
+   *  the list of the larger end, those arcs going last like the in-edges of a directed graph.
+   */
+  NON_DIRECTED_GRAPH_BEGIN
+    for (DeltaArc &arc : arcs)
+      arc.in_list_ = arc.row_ > arc.column_;
+    std::stable_partition(arcs.begin(), arcs.end(), [](const DeltaArc &arc) { return !arc.in_list_; });
+  NON_DIRECTED_GRAPH_END
+
+  std::vector<std::size_t> groups;
+  GroupDeltaArcs(arcs, groups);
+
+  // find the heads before the workers start, so the maps are only read and every list has one writer
+  std::vector<Link *> heads(groups.size() - 1);
+  for (std::size_t group = 0; group < heads.size(); ++group)
+  {
+    const DeltaArc &arc = arcs[groups[group]];
+    Instrumentation::CountLookups(1);
+    heads[group] = Directed && arc.in_list_ ? &reverse_.find(arc.row_)->second : &list_.find(arc.row_)->second;
+  }
+
+  DIRECTED_GRAPH_BEGIN
+    ParallelFor(0, heads.size(), threads, [&](unsigned, std::size_t first, std::size_t last) {
+      for (std::size_t group = first; group < last; ++group)
+      {
+        // the arcs of a group ascend by column, so each search resumes where the previous one stopped
+        Link *slot = heads[group];
+        for (std::size_t index = groups[group]; index < groups[group + 1]; ++index)
+        {
+          const DeltaArc &arc = arcs[index];
+          slot = LowerBound(slot, arc.row_, arc.column_);
+          bool found = *slot && LinkTarget(*slot, arc.row_) == arc.column_;
+          bool done = found;
+
+          switch (arc.operation_)
+          {
+          case DeltaOperation::INSERT:
+            done = true;
+            if (!found)
+              Splice(slot, MakeLink(arc.row_, arc.column_, arc.weight_), arc.row_);
+            WEIGHTED_GRAPH
+              (*slot)->weight_ = arc.weight_;
+            break;
+          case DeltaOperation::ERASE:
+            if (found)
+              delete Detach(slot, arc.row_, arc.column_);
+            break;
+          case DeltaOperation::SET_WEIGHT:
+            WEIGHTED_GRAPH
+              if (found)
+                (*slot)->weight_ = arc.weight_;
+            break;
+          }
+
+          if (arc.primary_)
+            applied[arc.sequence_] = done;
+        }
+      }
+    });
+  DIRECTED_GRAPH_END
+
+  NON_DIRECTED_GRAPH_BEGIN
+    // the node of an edge after the first pass, filed under the sequence of its last change
+    struct Outcome
+    {
+      Link link_ = nullptr;
+      bool before_ = false;
+      bool after_ = false;
+    };
+    std::vector<Outcome> outcomes(delta.size());
+
+    std::size_t smaller = 0;
+    while (smaller < heads.size() && !arcs[groups[smaller]].in_list_)
+      ++smaller;
+
+    // the changes of an edge are folded first, so its node is kept, made or dropped once
+    ParallelFor(0, smaller, threads, [&](unsigned, std::size_t first, std::size_t last) {
+      for (std::size_t group = first; group < last; ++group)
+      {
+        Link *slot = heads[group];
+        for (std::size_t index = groups[group], next = index; index < groups[group + 1]; index = next)
+        {
+          const index_t row = arcs[index].row_;
+          const index_t column = arcs[index].column_;
+          slot = LowerBound(slot, row, column);
+          Link link = *slot && LinkTarget(*slot, row) == column ? *slot : nullptr;
+          bool present = link != nullptr;
+          weight_t weight = kDefaultWeight;
+          WEIGHTED_GRAPH
+            if (link)
+              weight = link->weight_;
+
+          for (; next < groups[group + 1] && arcs[next].column_ == column; ++next)
+          {
+            const DeltaArc &arc = arcs[next];
+            bool done = present;
+            switch (arc.operation_)
+            {
+            case DeltaOperation::INSERT:
+              done = present = true;
+              weight = arc.weight_;
+              break;
+            case DeltaOperation::ERASE:
+              present = false;
+              break;
+            case DeltaOperation::SET_WEIGHT:
+              if (present)
+                weight = arc.weight_;
+              break;
+            }
+            applied[arc.sequence_] = done;
+          }
+
+          bool before = link != nullptr;
+          if (present && !before) {
+            link = MakeLink(row, column, weight);
+            Splice(slot, link, row);
+          } else if (!present && before) {
+            *slot = *LinkNext(link, row);
+          }
+          WEIGHTED_GRAPH
+            if (present)
+              link->weight_ = weight;
+
+          if (row != column)
+            outcomes[arcs[next - 1].sequence_] = Outcome{link, before, present};
+          else if (before && !present)
+            delete link;    // a self-loop is in one list only
+        }
+      }
+    });
+
+    ParallelFor(smaller, heads.size(), threads, [&](unsigned, std::size_t first, std::size_t last) {
+      for (std::size_t group = first; group < last; ++group)
+      {
+        Link *slot = heads[group];
+        for (std::size_t index = groups[group], next = index; index < groups[group + 1]; index = next)
+        {
+          const index_t row = arcs[index].row_;
+          const index_t column = arcs[index].column_;
+          while (next < groups[group + 1] && arcs[next].column_ == column)
+            ++next;
+
+          const Outcome &outcome = outcomes[arcs[next - 1].sequence_];
+          if (outcome.before_ == outcome.after_)
+            continue;
+
+          slot = LowerBound(slot, row, column);
+          if (outcome.after_) {
+            Splice(slot, outcome.link_, row);
+          } else {
+            *slot = *LinkNext(outcome.link_, row);
+            delete outcome.link_;
+          }
+        }
+      }
+    });
+  NON_DIRECTED_GRAPH_END
+
+  return static_cast<std::size_t>(std::count(applied.begin(), applied.end(), 1));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdge(index_t s, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  if (!append)
+    res.clear();
+
+  return GetEdgeIn(s, res, true) && GetEdgeOut(s, res, true);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::GET_EDGE_IN);
+
+  if (!list_.count(destination))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, destination, weight);
+    ELSE
+      res.emplace_back(start, destination);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+Edge<true> AdjacentList<Ty,Weighted,Directed>::GetEdgeIn(index_t destination,EdgeWeight type) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::IN, destination)) {
+    const WeightedNeighbor *found = WeightIndex<Directed>::Extreme(*row, type);
+    return found ? Edge<true>(found->neighbor_, destination, found->weight_) : Edge<true>(-1,-1,kDisconnected);
+  }
+
+  // the in-edges don't depend on the out-list of destination being empty
+  if(!list_.count(destination))
+    return Edge<true>(-1,-1,kDisconnected);
+  
+  index_t current_start = -1;
+  weight_t current_weight = 0;
+  if(type == EdgeWeight::MIN)
+    current_weight = kWeightMax;
+  else if ( type == EdgeWeight::MAX)
+    current_weight = kWeightMin;
+
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    if(type == EdgeWeight::MIN)
+    {
+      if(weight < current_weight) {
+        current_start = start;
+        current_weight = weight;
+      }
+    } else if (type == EdgeWeight::MAX) {
+        if(weight > current_weight) {
+        current_start = start;
+        current_weight = weight;
+      }
+    }
+  });
+
+  if(current_start == static_cast<index_t>(-1))
+    return Edge<true>(-1,-1,kDisconnected);
+  else
+    return Edge<true>(current_start,destination,current_weight);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Queue>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeInOrdered(index_t destination, Queue&& queue, bool append) const noexcept
+{
+  static_assert(Weighted,"The edges are non-weighted.");
+
+  if (!list_.count(destination))
+        return false;
+
+  if (!append)
+    queue = { };
+
+  ForEachIn(destination, [&](index_t start, weight_t weight) {
+    WEIGHTED_GRAPH
+      queue.emplace(start, destination, weight);
+    ELSE
+      queue.emplace(start, destination);
+  });
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::GET_EDGE_OUT);
+
+  if (!list_.count(start))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(start);
+  auto current = iter->second;
+  while (current)
+  {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, LinkTarget(current, start), current->weight_);
+    ELSE
+      res.emplace_back(start, LinkTarget(current, start));
+    
+    current = *LinkNext(current, start);
+  }
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+Edge<true> AdjacentList<Ty,Weighted,Directed>::GetEdgeOut(index_t start, EdgeWeight type) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::OUT, start)) {
+    const WeightedNeighbor *found = WeightIndex<Directed>::Extreme(*row, type);
+    return found ? Edge<true>(start, found->neighbor_, found->weight_) : Edge<true>(-1,-1,kDisconnected);
+  }
+	
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(start);
+  if(iter == list_.end() || !iter->second)
+    return Edge<true>(-1,-1,kDisconnected);
+
+  auto current = iter->second;
+  weight_t current_weight = 0;
+
+  if(type == EdgeWeight::MIN)
+    current_weight = kWeightMax;
+  else if ( type == EdgeWeight::MAX)
+    current_weight = kWeightMin;
+
+  index_t current_destination = -1;
+
+  if(type == EdgeWeight::MIN) {
+    // Get the edge which has the least weight
+    while(current)
+    {
+      if(current->weight_ < current_weight) {
+        current_destination = LinkTarget(current, start);
+        current_weight = current->weight_;
+      }
+
+      current = *LinkNext(current, start);
+    }
+  } else if (type == EdgeWeight::MAX) {
+    // Get the edge which has the greatest weight
+    while(current)
+    {
+      if(current->weight_ > current_weight) {
+        current_destination = LinkTarget(current, start);
+	      current_weight = current->weight_;
+      }
+
+      current = *LinkNext(current, start);
+    }
+  }
+
+  if(current_destination == static_cast<index_t>(-1))
+    return Edge<true>(-1,-1,kDisconnected);
+  else
+    return Edge<true>(start,current_destination,current_weight);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeOut(index_t start,
+                                                    EdgeWeight type,
+                                                    std::size_t k,
+                                                    std::vector<EdgeType> &res,
+                                                    bool append) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!list_.count(start))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  auto emit = [&](index_t dest, weight_t weight) { res.emplace_back(start, dest, weight); };
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::OUT, start))
+    WeightIndex<Directed>::Select(*row, type, k, emit);
+  else
+    WeightIndex<Directed>::SelectScan([&](auto &&visit) { ForEachOut(start, visit); }, type, k, emit);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeIn(index_t destination,
+                                                   EdgeWeight type,
+                                                   std::size_t k,
+                                                   std::vector<EdgeType> &res,
+                                                   bool append) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!list_.count(destination))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  auto emit = [&](index_t start, weight_t weight) { res.emplace_back(start, destination, weight); };
+  if (const auto *row = weight_index_.RowOf(EdgeDirection::IN, destination))
+    WeightIndex<Directed>::Select(*row, type, k, emit);
+  else
+    WeightIndex<Directed>::SelectScan([&](auto &&visit) { ForEachIn(destination, visit); }, type, k, emit);
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::IndexWeights(bool enable) noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  if (!enable)
+    weight_index_.Clear();
+  else if (!weight_index_.Enabled())
+    weight_index_.Build(*this);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::WeightsIndexed() const noexcept
+{
+  return weight_index_.Enabled();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Queue>
+bool AdjacentList<Ty,Weighted,Directed>::GetEdgeOutOrdered(index_t start, Queue&& queue, bool append) const noexcept
+{
+  static_assert(Weighted,"The edges are non-weighted.");
+
+  if (!list_.count(start))
+    return false;
+
+  if (!append)
+    queue = { };
+
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(start);
+  auto current = iter->second;
+  while (current)
+  {
+    WEIGHTED_GRAPH
+      queue.emplace(start, LinkTarget(current, start), current->weight_);
+    ELSE
+      queue.emplace(start, LinkTarget(current, start));
+
+    current = *LinkNext(current, start);
+  }
+
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void AdjacentList<Ty,Weighted,Directed>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(start);
+  if (iter == list_.end())
+    return;
+
+  for (Link current = iter->second; current != nullptr; current = *LinkNext(current, start))
+  {
+    WEIGHTED_GRAPH
+      visit(LinkTarget(current, start), current->weight_);
+    ELSE
+      visit(LinkTarget(current, start), kConnected);
+  }
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void AdjacentList<Ty,Weighted,Directed>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  NON_DIRECTED_GRAPH_BEGIN
+    // every edge is in the lists of both of its ends, so the in-edges mirror the out-edges
+    ForEachOut(dest, std::forward<Visitor>(visit));
+    return;
+  NON_DIRECTED_GRAPH_END
+
+  DIRECTED_GRAPH_BEGIN
+    typename std::map<index_t, Link>::const_iterator iter = reverse_.find(dest);
+    if (iter == reverse_.end())
+      return;
+
+    for (Link current = iter->second; current != nullptr; current = *LinkNext(current, dest))
+    {
+      WEIGHTED_GRAPH
+        visit(LinkTarget(current, dest), current->weight_);
+      ELSE
+        visit(LinkTarget(current, dest), kConnected);
+    }
+  DIRECTED_GRAPH_END
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+weight_t AdjacentList<Ty,Weighted,Directed>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  Instrumentation::Scope trace(GraphOperation::WEIGHT_OF_EDGE);
+
+  if (Link edge = FetchEdge(start, dest); edge != nullptr) {
+    WEIGHTED_GRAPH
+      return edge->weight_;
+    ELSE
+      return kConnected;
+  } else
+    return kDisconnected;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::WeightOfEdges(const std::vector<std::pair<index_t, index_t>> &queries,
+                                                       std::vector<weight_t> &res,
+                                                       std::size_t width) const noexcept
+{
+  res.assign(queries.size(), kDisconnected);
+
+  std::vector<Link> heads;
+  Heads(heads);
+
+  struct Lookup
+  {
+    std::size_t query_ = 0;
+    index_t owner_ = 0;
+    index_t dest_ = 0;
+    Link link_ = nullptr;
+  };
+
+  auto start = [&](Lookup &state, std::size_t query) -> const void * {
+    auto [owner, dest] = queries[query];
+    if (owner >= heads.size())
+      return nullptr;
+
+    state = Lookup{query, owner, dest, nullptr};
+    return &heads[owner];
+  };
+
+  // the first step reads the head, every later one a node, stopping past dest in the sorted list
+  auto step = [&](Lookup &state) -> const void * {
+    if (state.link_ == nullptr)
+      state.link_ = heads[state.owner_];
+    else if (index_t target = LinkTarget(state.link_, state.owner_); target < state.dest_)
+      state.link_ = *LinkNext(state.link_, state.owner_);
+    else {
+      if (target == state.dest_) {
+        WEIGHTED_GRAPH
+          res[state.query_] = state.link_->weight_;
+        ELSE
+          res[state.query_] = kConnected;
+      }
+      return nullptr;
+    }
+    return state.link_;
+  };
+
+  RunInterleaved<Lookup>(queries.size(), width, start, step);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::NeighborhoodSizes(const std::vector<index_t> &sources,
+                                                           std::size_t hops,
+                                                           std::vector<std::size_t> &res,
+                                                           std::size_t width) const noexcept
+{
+  res.assign(sources.size(), 0);
+
+  std::vector<Link> heads;
+  Heads(heads);
+
+  // the queue holds every vertex found, level after level, and so the bits to clear at the end
+  struct Search
+  {
+    std::size_t query_ = 0;
+    std::vector<std::uint64_t> seen_;
+    std::vector<index_t> queue_;
+    std::size_t next_ = 0;        // position of owner_ in queue_
+    std::size_t level_end_ = 0;
+    std::size_t level_ = 0;
+    index_t owner_ = 0;
+    Link link_ = nullptr;
+    bool head_ = false;           // the next step reads the head of owner_
+  };
+
+  const std::size_t words = heads.size() / 64 + 1;
+
+  auto mark = [](Search &state, index_t v) {
+    if (state.seen_[v / 64] >> (v % 64) & 1)
+      return;
+
+    state.seen_[v / 64] |= std::uint64_t{1} << (v % 64);
+    state.queue_.push_back(v);
+  };
+
+  // move on to the next vertex to expand, or finish the search
+  auto advance = [&](Search &state) -> const void * {
+    if (++state.next_ == state.level_end_) {
+      ++state.level_;
+      state.level_end_ = state.queue_.size();
+    }
+
+    if (state.level_ == hops || state.next_ == state.queue_.size()) {
+      res[state.query_] = state.queue_.size();
+      for (index_t v : state.queue_)
+        state.seen_[v / 64] = 0;
+      return nullptr;
+    }
+
+    state.owner_ = state.queue_[state.next_];
+    state.head_ = true;
+    return &heads[state.owner_];
+  };
+
+  auto start = [&](Search &state, std::size_t query) -> const void * {
+    index_t source = sources[query];
+    if (!HasVertex(source))
+      return nullptr;
+
+    if (hops == 0) {
+      res[query] = 1;
+      return nullptr;
+    }
+
+    state.seen_.resize(words);
+    state.query_ = query;
+    state.queue_.clear();
+    mark(state, source);
+    state.next_ = 0;
+    state.level_end_ = 1;
+    state.level_ = 0;
+    state.owner_ = source;
+    state.head_ = true;
+    return &heads[source];
+  };
+
+  auto step = [&](Search &state) -> const void * {
+    if (state.head_) {
+      state.head_ = false;
+      state.link_ = heads[state.owner_];
+    } else {
+      mark(state, LinkTarget(state.link_, state.owner_));
+      state.link_ = *LinkNext(state.link_, state.owner_);
+    }
+    return state.link_ ? state.link_ : advance(state);
+  };
+
+  RunInterleaved<Search>(sources.size(), width, start, step);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::RandomWalks(const std::vector<index_t> &starts,
+                                                     std::size_t length,
+                                                     std::uint64_t seed,
+                                                     std::vector<index_t> &walks,
+                                                     std::size_t width) const noexcept
+{
+  const std::size_t stride = length + 1;
+  walks.resize(starts.size() * stride);
+  for (std::size_t i = 0; i < starts.size(); ++i)
+    std::fill_n(walks.begin() + i * stride, stride, starts[i]);
+
+  std::vector<Link> heads;
+  Heads(heads);
+
+  // a step of the walk reads the list of the current vertex once, keeping a uniform pick of it
+  struct Walk
+  {
+    std::size_t query_ = 0;
+    std::size_t steps_ = 0;
+    index_t owner_ = 0;
+    index_t pick_ = 0;
+    std::size_t seen_ = 0;
+    Link link_ = nullptr;
+    SplitMix64 random_{0};
+  };
+
+  auto begin = [&](Walk &state) -> const void * {
+    state.seen_ = 0;
+    state.link_ = nullptr;
+    return &heads[state.owner_];
+  };
+
+  auto start = [&](Walk &state, std::size_t query) -> const void * {
+    if (length == 0 || starts[query] >= heads.size() || !heads[starts[query]])
+      return nullptr;
+
+    state = Walk{query, 0, starts[query], starts[query], 0, nullptr, SplitMix64(seed, query)};
+    return begin(state);
+  };
+
+  auto step = [&](Walk &state) -> const void * {
+    if (state.link_ == nullptr && state.seen_ == 0)
+      state.link_ = heads[state.owner_];
+    else {
+      if (state.random_.Below(++state.seen_) == 0)
+        state.pick_ = LinkTarget(state.link_, state.owner_);
+      state.link_ = *LinkNext(state.link_, state.owner_);
+    }
+
+    if (state.link_)
+      return state.link_;
+
+    // the list is done: move to the pick, which stays for the rest when it has no out-edges
+    std::fill(walks.begin() + state.query_ * stride + state.steps_ + 1, walks.begin() + (state.query_ + 1) * stride, state.pick_);
+    state.owner_ = state.pick_;
+    if (++state.steps_ == length || !heads[state.owner_])
+      return nullptr;
+
+    return begin(state);
+  };
+
+  RunInterleaved<Walk>(starts.size(), width, start, step);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::Print() const noexcept
+{
+  for (auto &iter : list_)
+  {
+    std::cout << "[" << iter.first << "]";
+    bool has_path = false;
+    for (auto current = iter.second; current != nullptr; current = *LinkNext(current, iter.first))
+    {
+      has_path = true;
+      WEIGHTED_GRAPH
+        std::cout << "->[" << LinkTarget(current, iter.first) << "," << current->weight_ << "]";
+      ELSE
+        std::cout << "->[" << LinkTarget(current, iter.first) << "]";
+    }
+    if (!has_path)
+      std::cout << "->[none,none]";
+
+    std::cout << '\n';
+  }
+  std::cout << std::endl;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <bool Ascending>
+decltype(auto) AdjacentList<Ty,Weighted,Directed>::makeEdgeQueue() const noexcept
+{
+  if constexpr (Ascending)
+    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::greater<>>();
+  else
+    return std::priority_queue<EdgeType,std::vector<EdgeType>,std::less<>>();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+decltype(auto) AdjacentList<Ty,Weighted,Directed>::begin() const noexcept
+{
+  return list_.begin();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+decltype(auto) AdjacentList<Ty,Weighted,Directed>::end() const noexcept
+{
+  return list_.end();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto AdjacentList<Ty,Weighted,Directed>::FetchEdge(index_t start, index_t dest) const noexcept ->Link
+{
+  Instrumentation::CountLookups(1);
+  typename std::map<index_t, Link>::const_iterator iter = list_.find(start);
+  if (iter == list_.end())
+    return nullptr;
+
+  std::size_t hops = 0;
+  Link current = iter->second;
+  while (current)
+  {
+    ++hops;
+    if (LinkTarget(current, start) == dest)
+      break;
+
+     current = *LinkNext(current, start);
+  }
+
+  Instrumentation::CountHops(hops);
+  return current;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::Heads(std::vector<Link> &heads) const noexcept
+{
+  heads.assign(list_.empty() ? 0 : static_cast<std::size_t>(list_.rbegin()->first) + 1, nullptr);
+  for (const auto &[id, head] : list_)
+    heads[id] = head;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto AdjacentList<Ty,Weighted,Directed>::LowerBound(Link *head, index_t owner, index_t dest) noexcept -> Link *
+{
+  std::size_t hops = 0;
+  while (*head && LinkTarget(*head, owner) < dest)
+  {
+    head = LinkNext(*head, owner);
+    ++hops;
+  }
+
+  Instrumentation::CountHops(hops);
+  return head;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto AdjacentList<Ty,Weighted,Directed>::Detach(Link *head, index_t owner, index_t dest) noexcept -> Link
+{
+  Link *slot = LowerBound(head, owner, dest);
+  if (!*slot || LinkTarget(*slot, owner) != dest)
+    return nullptr;
+
+  Link found = *slot;
+  *slot = *LinkNext(found, owner);
+  return found;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::Splice(Link *slot, Link link, index_t owner) noexcept
+{
+  *LinkNext(link, owner) = *slot;
+  *slot = link;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool AdjacentList<Ty,Weighted,Directed>::Releases(Link link, index_t owner) noexcept
+{
+  DIRECTED_GRAPH
+    return true;
+  ELSE
+    return LinkTarget(link, owner) <= owner;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void AdjacentList<Ty,Weighted,Directed>::Free(Link head, index_t owner) noexcept
+{
+  while (head)
+  {
+    Link next = *LinkNext(head, owner);
+    if (Releases(head, owner))
+      delete head;
+    head = next;
+  }
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t AdjacentList<Ty,Weighted,Directed>::UnlinkSorted(Link *head, index_t owner, const index_t *first, const index_t *last) noexcept
+{
+  std::size_t count = 0;
+  for (; first != last; ++first)
+  {
+    // the destinations ascend, so each search resumes where the previous one stopped
+    head = LowerBound(head, owner, *first);
+    if (*head && LinkTarget(*head, owner) == *first) {
+      Link found = *head;
+      *head = *LinkNext(found, owner);
+      if (Releases(found, owner))
+        delete found;
+      ++count;
+    }
+  }
+  return count;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto AdjacentList<Ty,Weighted,Directed>::MakeLink(index_t owner, index_t dest, weight_t weight) -> Link
+{
+  Instrumentation::CountAllocation(sizeof(LinkType));
+  WEIGHTED_GRAPH_BEGIN
+    DIRECTED_GRAPH
+      return new LinkType(dest, weight);
+    ELSE
+      return new LinkType(owner, dest, weight);
+  WEIGHTED_GRAPH_END
+  ELSE
+  {
+    DIRECTED_GRAPH
+      return new LinkType(dest);
+    ELSE
+      return new LinkType(owner, dest);
+  }
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -1,559 +1,794 @@
-#include "../adjacent_matrix.hpp"
-
-namespace smart_graph {
-namespace smart_graph_impl {
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix() : vertices_(), matrix_()
-{
-  WEIGHTED_GRAPH
-    for (size_t i = 0; i < Size; ++i)
-      for (size_t j = 0; j < Size; ++j)
-        matrix_[i][j] = kDisconnected;
-  ELSE 
-    for (size_t i = 0; i < Size; ++i)
-      matrix_[i].reset();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-AdjacentMatrix<Ty,Weighted,Directed,Size>::~AdjacentMatrix()
-{
-
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix(const AdjacentMatrix& rhs)
-{
-    vertices_ = rhs.vertices_;
-    matrix_ = rhs.matrix_;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix(AdjacentMatrix&& rhs):
-    matrix_(std::move(rhs.matrix_)),vertices_(std::move(rhs.vertices_))
-{
-
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-typename AdjacentMatrix<Ty,Weighted,Directed,Size>::BaseLine& 
-AdjacentMatrix<Ty,Weighted,Directed,Size>::operator[](int pos)
-{
-  if(pos < Size)
-    return matrix_[pos];
-}
-
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-std::optional<Ty> AdjacentMatrix<Ty,Weighted,Directed,Size>::At(index_t s) const
-{
-  if (!IndexCheck(s))
-    return std::nullopt;
-
-    return vertices_.find(s)->second;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-template <typename Arg>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::Emplace(size_t id, Arg &&value) noexcept
-{
-  if (!IndexCheck(id))
-    return false;
-
-  vertices_[id] = value;
-  return true;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          size_t Size>
-template <typename... _Arg>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::RegisterVertex(index_t s, _Arg &&... args) noexcept
-{
-    if (s >= Size)
-        return false;
-
-    auto [elem, success] = vertices_.try_emplace(s, std::forward<_Arg>(args)...);
-    return success;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasVertex(index_t s) const noexcept
-{
-    return vertices_.count(s);
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseVertex(index_t s) noexcept
-{
-    if (!IndexCheck(s))
-        return false;
-
-    //cascade delete
-    WEIGHTED_GRAPH_BEGIN
-        for (index_t d = 0; d < Size; ++d)
-        {
-            matrix_[s][d] = kDisconnected;
-            matrix_[d][s] = kDisconnected;
-        }
-    WEIGHTED_GRAPH_END
-    ELSE 
-        for (index_t d = 0; d < Size; ++d)
-        {
-            matrix_[s][d] = 0;
-            matrix_[d][s] = 0;
-        }
-
-    vertices_.erase(s);
-    return true;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::VerticesSize() const noexcept
-{
-    return vertices_.size();
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::EdgeSize() const noexcept
-{
-    // Edge = Degree / 2
-    size_t edge = 0;
-    for (size_t i = 0; i < Size; ++i)
-        edge += Degree(i);
-    return edge / 2;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::Degree(index_t id) const noexcept
-{
-    if (!IndexCheck(id))
-        return 0;
-
-    if constexpr (Directed || Weighted)
-    {
-        DIRECTED_GRAPH
-            return InDegree(id) + OutDegree(id);
-        ELSE 
-            return (InDegree(id) + OutDegree(id)) / 2;
-    }
-    else
-        return matrix_[id].count();
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::InDegree(index_t id) const noexcept
-{
-    if (!IndexCheck(id))
-        return 0;
-
-    if constexpr (!Weighted && !Directed)
-        return matrix_[id].count();
-    else
-    {
-        size_t count = 0;
-        for (size_t i = 0; i < Size; ++i)
-        {
-            WEIGHTED_GRAPH_BEGIN
-                if (WEIGHT_CHECK(matrix_[i][id]))
-                    ++count;
-            WEIGHTED_GRAPH_END
-            ELSE
-                count += static_cast<size_t>(matrix_[i][id]);
-        }
-        return count;
-    }
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::OutDegree(index_t id) const noexcept
-{
-    if (!IndexCheck(id))
-        return 0;
-
-    if constexpr (!Weighted && !Directed)
-        return matrix_[id].count();
-    else
-    {
-        size_t count = 0;
-        for (size_t i = 0; i < Size; ++i)
-            WEIGHTED_GRAPH_BEGIN
-                if (WEIGHT_CHECK(matrix_[id][i]))
-                    ++count;
-            WEIGHTED_GRAPH_END
-            ELSE
-                count += static_cast<size_t>(matrix_[id][i]);
-
-        return count;
-    }
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasEdge(index_t start, index_t dest) const noexcept
-{
-    if (!IndexCheck(start, dest))
-        return false;
-
-    WEIGHTED_GRAPH
-        return WEIGHT_CHECK(matrix_[start][dest]);
-    ELSE 
-        return matrix_[start][dest];
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasEdge(const EdgeType &edge) const noexcept
-{
-    WEIGHTED_GRAPH_BEGIN
-        const auto &[start, dest, weight] = edge;
-        return HasEdge(start, dest);
-    WEIGHTED_GRAPH_END
-
-    NON_WEIGHTED_GRAPH_BEGIN
-        const auto &[start, dest] = edge;
-        return HasEdge(start, dest);
-    NON_WEIGHTED_GRAPH_END
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::ExistsEdge(const EdgeType &edge) const noexcept
-{
-    // Do check first
-    if (!IndexCheck(edge.start_, edge.destination_))
-        return false;
-
-    WEIGHTED_GRAPH_BEGIN
-        const auto &[start, dest, weight] = edge;
-        return matrix_[start][dest] == weight;
-    WEIGHTED_GRAPH_END
-
-    NON_WEIGHTED_GRAPH_BEGIN
-        const auto &[start, dest] = edge;
-        return matrix_[start][dest];
-    NON_WEIGHTED_GRAPH_END
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::InsertEdge(index_t start, index_t dest, weight_t weight) noexcept
-{
-    //make sure that start_ and destination_ is vaild
-    if (!IndexCheck(start, dest))
-        return false;
-
-    WEIGHTED_GRAPH_BEGIN
-        matrix_[start][dest] = weight;
-        DIRECTED_GRAPH
-            return true;
-    ELSE
-    {
-        matrix_[dest][start] = weight;
-        return true;
-    }
-    WEIGHTED_GRAPH_END
-    ELSE
-    {
-        matrix_[start][dest] = 1;
-        DIRECTED_GRAPH
-            return true;
-        ELSE
-        {
-            matrix_[dest][start] = 1;
-            return true;
-        }
-    }
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::InsertEdge(const EdgeType &edge) noexcept
-{
-    WEIGHTED_GRAPH
-        return InsertEdge(edge.start_, edge.destination_, edge.weight_);
-    ELSE 
-        return InsertEdge(edge.start_, edge.destination_);
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseEdge(index_t start, index_t dest) noexcept
-{
-    if (!IndexCheck(start, dest))
-        return false;
-
-    WEIGHTED_GRAPH
-        return InsertEdge(start, dest, kDisconnected);
-    
-    NON_WEIGHTED_GRAPH_BEGIN
-        matrix_[start][dest] = 0;
-        DIRECTED_GRAPH
-            return true;
-        NON_DIRECTED_GRAPH_BEGIN
-            matrix_[dest][start] = 0;
-            return true;
-        NON_DIRECTED_GRAPH_END
-    NON_WEIGHTED_GRAPH_END
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdge(index_t source, std::vector<EdgeType> &res, bool append) noexcept
-{
-    if (!append)
-        res.clear();
-
-    return GetEdgeIn(source, res, true) && GetEdgeOut(source, res, true);
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeIn(index_t dest, std::vector<EdgeType> &res, bool append) const noexcept
-{
-    if (!IndexCheck(dest))
-        return false;
-
-    if (!append)
-        res.clear();
-
-    for (index_t start = 0; start < Size; ++start)
-    {
-        WEIGHTED_GRAPH_BEGIN
-            if (WEIGHT_CHECK(matrix_[start][dest]))
-                res.emplace_back(start, dest, matrix_[start][dest]);
-        WEIGHTED_GRAPH_END
-        ELSE 
-            if (matrix_[start][dest])
-                res.emplace_back(start, dest);
-    }
-    return true;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-template <typename Queue>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeInOrdered(index_t destination, Queue&& queue, bool append) const noexcept
-{
-    static_assert(Weighted,"The edges are non-weighted.");
-
-    if (!IndexCheck(destination))
-        return false;
-
-    if (!append)
-        queue = { };
-
-    for (index_t start = 0; start < Size; ++start)
-    {
-        WEIGHTED_GRAPH_BEGIN
-            if (WEIGHT_CHECK(matrix_[start][destination]))
-                queue.emplace(start, destination, matrix_[start][destination]);
-        WEIGHTED_GRAPH_END
-        ELSE 
-            if (matrix_[start][destination])
-                queue.emplace(start, destination);
-    }
-    return true;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
-{
-    if (!IndexCheck(start))
-        return false;
-
-    if (!append)
-        res.clear();
-
-    for (index_t dest = 0; dest < Size; ++dest)
-    {
-        WEIGHTED_GRAPH_BEGIN
-            if (WEIGHT_CHECK(matrix_[start][dest]))
-                res.emplace_back(start, dest, matrix_[start][dest]);
-        WEIGHTED_GRAPH_END
-        ELSE 
-            if (matrix_[start][dest])
-                res.emplace_back(start, dest);
-    }
-    return true;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-template <typename Queue>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeOutOrdered(index_t start, Queue&& queue, bool append) const noexcept
-{
-    static_assert(Weighted,"The edges are non-weighted.");
-
-    if (!IndexCheck(start))
-        return false;
-
-    if (!append)
-        queue = { };
-
-    for (index_t dest = 0; dest < Size; ++dest)
-    {
-        WEIGHTED_GRAPH_BEGIN
-            if (WEIGHT_CHECK(matrix_[start][dest]))
-                queue.emplace(start, dest, matrix_[start][dest]);
-        WEIGHTED_GRAPH_END
-        ELSE 
-            if (matrix_[start][dest])
-                queue.emplace(start, dest);
-    }
-    return true;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-weight_t AdjacentMatrix<Ty,Weighted,Directed,Size>::WeightOfEdge(index_t start, index_t dest) const noexcept
-{
-    if (!IndexCheck(start, dest))
-        return matrix_[start][dest];
-    else
-        return kDisconnected;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-void AdjacentMatrix<Ty,Weighted,Directed,Size>::Print() const noexcept
-{
-    for (auto &iter : vertices_)
-    {
-        bool has_path = false;
-        index_t start = iter.first;
-
-        std::cout << "[" << iter.first << "]";
-        for (index_t dest = 0; dest < Size; ++dest)
-        {
-            WEIGHTED_GRAPH_BEGIN
-                if (WEIGHT_CHECK(matrix_[start][dest]))
-                {
-                    has_path = true;
-                    std::cout << "->[" << dest << "," << matrix_[start][dest] << "]";
-                }
-            WEIGHTED_GRAPH_END
-
-            NON_WEIGHTED_GRAPH_BEGIN
-                if (matrix_[start][dest])
-                {
-                    has_path = true;
-                        std::cout << "->[" << dest << "]";
-                }
-            NON_WEIGHTED_GRAPH_END
-        }
-        if (!has_path)
-            std::cout << "->[none,none]";
-
-        std::cout << '\n';
-    }
-    std::cout << std::endl;
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-template <bool Ascending>
-decltype(auto) AdjacentMatrix<Ty,Weighted,Directed,Size>::makeEdgeQueue() const noexcept
-{
-    if constexpr (Ascending)
-        return std::priority_queue<EdgeType,std::vector<EdgeType>,std::greater<>>();
-    else
-        return std::priority_queue<EdgeType,std::vector<EdgeType>,std::less<>>();
-}
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::IndexCheck(index_t f, index_t s) const noexcept
-{
-    return vertices_.count(f) && vertices_.count(s) && f < Size && s < Size;
-}
-
-
-template <typename Ty,
-		  bool Weighted,
-		  bool Directed,
-		  size_t Size>	
-bool AdjacentMatrix<Ty,Weighted,Directed,Size>::IndexCheck(index_t f) const noexcept
-{
-    return vertices_.count(f) && f < Size;
-}
-
-
-
-
-}  // namespace smart_graph_impl
-}  // namespace smart_graph
+#include "../adjacent_matrix.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted,
+		  size_t Size>
+template <bool Const>
+SymmetricMatrix<Weighted,Size>::Row<Const>::Row(Owner &owner, std::size_t row) noexcept : owner_(owner), row_(row)
+{
+
+}
+
+template <bool Weighted,
+		  size_t Size>
+template <bool Const>
+decltype(auto) SymmetricMatrix<Weighted,Size>::Row<Const>::operator[](std::size_t column) const noexcept
+{
+    return owner_.cells_[Cell(row_, column)];
+}
+
+template <bool Weighted,
+		  size_t Size>
+template <bool Const>
+std::size_t SymmetricMatrix<Weighted,Size>::Row<Const>::count() const noexcept
+{
+    std::size_t count = 0;
+    for (std::size_t column = 0; column < Size; ++column)
+        WEIGHTED_GRAPH
+            count += WEIGHT_CHECK(owner_.cells_[Cell(row_, column)]);
+        ELSE
+            count += owner_.cells_[Cell(row_, column)];
+    return count;
+}
+
+template <bool Weighted,
+		  size_t Size>
+template <bool Const>
+void SymmetricMatrix<Weighted,Size>::Row<Const>::reset() const noexcept
+{
+    for (std::size_t column = 0; column < Size; ++column)
+        WEIGHTED_GRAPH
+            owner_.cells_[Cell(row_, column)] = kDisconnected;
+        ELSE
+            owner_.cells_[Cell(row_, column)] = false;
+}
+
+template <bool Weighted,
+		  size_t Size>
+auto SymmetricMatrix<Weighted,Size>::operator[](std::size_t row) noexcept -> Row<false>
+{
+    return Row<false>(*this, row);
+}
+
+template <bool Weighted,
+		  size_t Size>
+auto SymmetricMatrix<Weighted,Size>::operator[](std::size_t row) const noexcept -> Row<true>
+{
+    return Row<true>(*this, row);
+}
+
+template <bool Weighted,
+		  size_t Size>
+constexpr std::size_t SymmetricMatrix<Weighted,Size>::Cell(std::size_t row, std::size_t column) noexcept
+{
+    // row r of the triangle starts after the Size + (Size - 1) + ... + (Size - r + 1) cells above it
+    if (row > column)
+        std::swap(row, column);
+    return row * (2 * static_cast<std::size_t>(Size) - row + 1) / 2 + (column - row);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix() : vertices_(), matrix_()
+{
+  WEIGHTED_GRAPH
+    for (size_t i = 0; i < Size; ++i)
+      for (size_t j = 0; j < Size; ++j)
+        matrix_[i][j] = kDisconnected;
+  ELSE 
+    for (size_t i = 0; i < Size; ++i)
+      matrix_[i].reset();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+AdjacentMatrix<Ty,Weighted,Directed,Size>::~AdjacentMatrix()
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix(const AdjacentMatrix& rhs)
+{
+    vertices_ = rhs.vertices_;
+    matrix_ = rhs.matrix_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+AdjacentMatrix<Ty,Weighted,Directed,Size>::AdjacentMatrix(AdjacentMatrix&& rhs):
+    matrix_(std::move(rhs.matrix_)),vertices_(std::move(rhs.vertices_))
+{
+    rhs.vertices_.Clear();
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+decltype(auto) AdjacentMatrix<Ty,Weighted,Directed,Size>::operator[](int pos)
+{
+  if(pos < Size)
+    return matrix_[pos];
+}
+
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+std::optional<Ty> AdjacentMatrix<Ty,Weighted,Directed,Size>::At(index_t s) const
+{
+  if (!IndexCheck(s))
+    return std::nullopt;
+
+    return *vertices_.Find(s);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+template <typename Arg>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::Emplace(size_t id, Arg &&value) noexcept
+{
+  if (!IndexCheck(id))
+    return false;
+
+  return vertices_.Assign(id, std::forward<Arg>(value));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          size_t Size>
+template <typename... _Arg>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::RegisterVertex(index_t s, _Arg &&... args) noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::REGISTER_VERTEX);
+    Instrumentation::CountLookups(1);
+
+    if (s >= Size)
+        return false;
+
+    return vertices_.Emplace(s, std::forward<_Arg>(args)...);
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasVertex(index_t s) const noexcept
+{
+    Instrumentation::CountLookups(1);
+    return vertices_.Has(s);
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseVertex(index_t s) noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::ERASE_VERTEX);
+
+    if (!IndexCheck(s))
+        return false;
+
+    //cascade delete, the column of an undirected graph being its row
+    WEIGHTED_GRAPH_BEGIN
+        for (index_t d = 0; d < Size; ++d)
+        {
+            matrix_[s][d] = kDisconnected;
+            DIRECTED_GRAPH
+                matrix_[d][s] = kDisconnected;
+        }
+    WEIGHTED_GRAPH_END
+    ELSE 
+        for (index_t d = 0; d < Size; ++d)
+        {
+            matrix_[s][d] = 0;
+            DIRECTED_GRAPH
+                matrix_[d][s] = 0;
+        }
+
+    vertices_.Erase(s);
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+std::size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseVertices(const std::vector<index_t> &vertices) noexcept
+{
+    std::size_t count = 0;
+    for (index_t s : vertices)
+        if (EraseVertex(s))
+            ++count;
+    return count;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::VerticesSize() const noexcept
+{
+    return vertices_.Size();
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::EdgeSize() const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::EDGE_SIZE);
+
+    // Edge = Degree / 2
+    size_t edge = 0;
+    for (size_t i = 0; i < Size; ++i)
+        edge += Degree(i);
+    return edge / 2;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+MemoryFootprint AdjacentMatrix<Ty,Weighted,Directed,Size>::MemoryUsage() const noexcept
+{
+    MemoryFootprint usage;
+    usage.vertex_table_ = sizeof(*this) - sizeof(matrix_);
+    usage.adjacency_ = sizeof(matrix_);
+    vertices_.Account(usage);
+    return usage;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::Degree(index_t id) const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::DEGREE);
+
+    if (!IndexCheck(id))
+        return 0;
+
+    if constexpr (Directed || Weighted)
+    {
+        DIRECTED_GRAPH
+            return InDegree(id) + OutDegree(id);
+        ELSE 
+            return (InDegree(id) + OutDegree(id)) / 2;
+    }
+    else
+        return matrix_[id].count();
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::InDegree(index_t id) const noexcept
+{
+    if (!IndexCheck(id))
+        return 0;
+
+    if constexpr (!Weighted && !Directed)
+        return matrix_[id].count();
+    else
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < Size; ++i)
+        {
+            WEIGHTED_GRAPH_BEGIN
+                if (WEIGHT_CHECK(matrix_[i][id]))
+                    ++count;
+            WEIGHTED_GRAPH_END
+            ELSE
+                count += static_cast<size_t>(matrix_[i][id]);
+        }
+        return count;
+    }
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::OutDegree(index_t id) const noexcept
+{
+    if (!IndexCheck(id))
+        return 0;
+
+    if constexpr (!Weighted && !Directed)
+        return matrix_[id].count();
+    else
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < Size; ++i)
+            WEIGHTED_GRAPH_BEGIN
+                if (WEIGHT_CHECK(matrix_[id][i]))
+                    ++count;
+            WEIGHTED_GRAPH_END
+            ELSE
+                count += static_cast<size_t>(matrix_[id][i]);
+
+        return count;
+    }
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasEdge(index_t start, index_t dest) const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::HAS_EDGE);
+
+    if (!IndexCheck(start, dest))
+        return false;
+
+    WEIGHTED_GRAPH
+        return WEIGHT_CHECK(matrix_[start][dest]);
+    ELSE 
+        return matrix_[start][dest];
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::HasEdge(const EdgeType &edge) const noexcept
+{
+    WEIGHTED_GRAPH_BEGIN
+        const auto &[start, dest, weight] = edge;
+        return HasEdge(start, dest);
+    WEIGHTED_GRAPH_END
+
+    NON_WEIGHTED_GRAPH_BEGIN
+        const auto &[start, dest] = edge;
+        return HasEdge(start, dest);
+    NON_WEIGHTED_GRAPH_END
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::ExistsEdge(const EdgeType &edge) const noexcept
+{
+    // Do check first
+    if (!IndexCheck(edge.start_, edge.destination_))
+        return false;
+
+    WEIGHTED_GRAPH_BEGIN
+        const auto &[start, dest, weight] = edge;
+        return matrix_[start][dest] == weight;
+    WEIGHTED_GRAPH_END
+
+    NON_WEIGHTED_GRAPH_BEGIN
+        const auto &[start, dest] = edge;
+        return matrix_[start][dest];
+    NON_WEIGHTED_GRAPH_END
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::InsertEdge(index_t start, index_t dest, weight_t weight) noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::INSERT_EDGE);
+
+    //make sure that start_ and destination_ is vaild
+    if (!IndexCheck(start, dest))
+        return false;
+
+    // an undirected edge is a single cell of the triangle, there is no mirror to write
+    WEIGHTED_GRAPH
+        matrix_[start][dest] = weight;
+    ELSE
+        matrix_[start][dest] = 1;
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::InsertEdge(const EdgeType &edge) noexcept
+{
+    WEIGHTED_GRAPH
+        return InsertEdge(edge.start_, edge.destination_, edge.weight_);
+    ELSE 
+        return InsertEdge(edge.start_, edge.destination_);
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseEdge(index_t start, index_t dest) noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::ERASE_EDGE);
+
+    if (!IndexCheck(start, dest))
+        return false;
+
+    WEIGHTED_GRAPH
+        return InsertEdge(start, dest, kDisconnected);
+    
+    NON_WEIGHTED_GRAPH_BEGIN
+        matrix_[start][dest] = 0;
+        return true;
+    NON_WEIGHTED_GRAPH_END
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+std::size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::EraseEdges(const std::vector<EdgeType> &edges) noexcept
+{
+    std::size_t count = 0;
+    for (const EdgeType &edge : edges)
+        if (HasEdge(edge.start_, edge.destination_) && EraseEdge(edge.start_, edge.destination_))
+            ++count;
+    return count;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+std::size_t AdjacentMatrix<Ty,Weighted,Directed,Size>::ApplyDelta(const std::vector<EdgeDelta> &delta,
+                                                                   std::vector<std::uint8_t> &applied,
+                                                                   unsigned) noexcept
+{
+    applied.assign(delta.size(), 0);
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < delta.size(); ++i)
+    {
+        const EdgeDelta &change = delta[i];
+        bool done = false;
+        switch (change.operation_)
+        {
+        case DeltaOperation::INSERT:
+            done = InsertEdge(change.start_, change.destination_, change.weight_);
+            break;
+        case DeltaOperation::ERASE:
+            done = HasEdge(change.start_, change.destination_) && EraseEdge(change.start_, change.destination_);
+            break;
+        case DeltaOperation::SET_WEIGHT:
+            done = HasEdge(change.start_, change.destination_) &&
+                   (!Weighted || InsertEdge(change.start_, change.destination_, change.weight_));
+            break;
+        }
+
+        applied[i] = done;
+        count += done;
+    }
+    return count;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+void AdjacentMatrix<Ty,Weighted,Directed,Size>::Transpose() noexcept
+{
+    constexpr std::size_t kTile = 64;
+
+    NON_DIRECTED_GRAPH
+        return;
+
+    DIRECTED_GRAPH_BEGIN
+        for (std::size_t row = 0; row < Size; row += kTile)
+            for (std::size_t column = row; column < Size; column += kTile)
+            {
+                const std::size_t row_end = std::min(row + kTile, std::size_t{Size});
+                const std::size_t column_end = std::min(column + kTile, std::size_t{Size});
+                for (std::size_t i = row; i < row_end; ++i)
+                    for (std::size_t j = std::max(column, i + 1); j < column_end; ++j)
+                    {
+                        WEIGHTED_GRAPH_BEGIN
+                            std::swap(matrix_[i][j], matrix_[j][i]);
+                        WEIGHTED_GRAPH_END
+                        ELSE
+                        {
+                            bool cell = matrix_[i][j];
+                            matrix_[i][j] = matrix_[j][i];
+                            matrix_[j][i] = cell;
+                        }
+                    }
+            }
+    DIRECTED_GRAPH_END
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdge(index_t source, std::vector<EdgeType> &res, bool append) noexcept
+{
+    if (!append)
+        res.clear();
+
+    return GetEdgeIn(source, res, true) && GetEdgeOut(source, res, true);
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeIn(index_t dest, std::vector<EdgeType> &res, bool append) const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::GET_EDGE_IN);
+
+    if (!IndexCheck(dest))
+        return false;
+
+    if (!append)
+        res.clear();
+
+    for (index_t start = 0; start < Size; ++start)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][dest]))
+                res.emplace_back(start, dest, matrix_[start][dest]);
+        WEIGHTED_GRAPH_END
+        ELSE 
+            if (matrix_[start][dest])
+                res.emplace_back(start, dest);
+    }
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+template <typename Queue>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeInOrdered(index_t destination, Queue&& queue, bool append) const noexcept
+{
+    static_assert(Weighted,"The edges are non-weighted.");
+
+    if (!IndexCheck(destination))
+        return false;
+
+    if (!append)
+        queue = { };
+
+    for (index_t start = 0; start < Size; ++start)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][destination]))
+                queue.emplace(start, destination, matrix_[start][destination]);
+        WEIGHTED_GRAPH_END
+        ELSE 
+            if (matrix_[start][destination])
+                queue.emplace(start, destination);
+    }
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::GET_EDGE_OUT);
+
+    if (!IndexCheck(start))
+        return false;
+
+    if (!append)
+        res.clear();
+
+    for (index_t dest = 0; dest < Size; ++dest)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][dest]))
+                res.emplace_back(start, dest, matrix_[start][dest]);
+        WEIGHTED_GRAPH_END
+        ELSE 
+            if (matrix_[start][dest])
+                res.emplace_back(start, dest);
+    }
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+template <typename Queue>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::GetEdgeOutOrdered(index_t start, Queue&& queue, bool append) const noexcept
+{
+    static_assert(Weighted,"The edges are non-weighted.");
+
+    if (!IndexCheck(start))
+        return false;
+
+    if (!append)
+        queue = { };
+
+    for (index_t dest = 0; dest < Size; ++dest)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][dest]))
+                queue.emplace(start, dest, matrix_[start][dest]);
+        WEIGHTED_GRAPH_END
+        ELSE 
+            if (matrix_[start][dest])
+                queue.emplace(start, dest);
+    }
+    return true;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+template <typename Visitor>
+void AdjacentMatrix<Ty,Weighted,Directed,Size>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+    if (!IndexCheck(start))
+        return;
+
+    for (index_t dest = 0; dest < Size; ++dest)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][dest]))
+                visit(dest, matrix_[start][dest]);
+        WEIGHTED_GRAPH_END
+        ELSE
+            if (matrix_[start][dest])
+                visit(dest, kConnected);
+    }
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+template <typename Visitor>
+void AdjacentMatrix<Ty,Weighted,Directed,Size>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+    if (!IndexCheck(dest))
+        return;
+
+    for (index_t start = 0; start < Size; ++start)
+    {
+        WEIGHTED_GRAPH_BEGIN
+            if (WEIGHT_CHECK(matrix_[start][dest]))
+                visit(start, matrix_[start][dest]);
+        WEIGHTED_GRAPH_END
+        ELSE
+            if (matrix_[start][dest])
+                visit(start, kConnected);
+    }
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+weight_t AdjacentMatrix<Ty,Weighted,Directed,Size>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+    Instrumentation::Scope trace(GraphOperation::WEIGHT_OF_EDGE);
+
+    if (!IndexCheck(start, dest))
+        return kDisconnected;
+
+    WEIGHTED_GRAPH
+        return matrix_[start][dest];
+    ELSE
+        return matrix_[start][dest] ? kConnected : kDisconnected;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+void AdjacentMatrix<Ty,Weighted,Directed,Size>::Print() const noexcept
+{
+    for (auto &iter : vertices_)
+    {
+        bool has_path = false;
+        index_t start = iter.first;
+
+        std::cout << "[" << iter.first << "]";
+        for (index_t dest = 0; dest < Size; ++dest)
+        {
+            WEIGHTED_GRAPH_BEGIN
+                if (WEIGHT_CHECK(matrix_[start][dest]))
+                {
+                    has_path = true;
+                    std::cout << "->[" << dest << "," << matrix_[start][dest] << "]";
+                }
+            WEIGHTED_GRAPH_END
+
+            NON_WEIGHTED_GRAPH_BEGIN
+                if (matrix_[start][dest])
+                {
+                    has_path = true;
+                        std::cout << "->[" << dest << "]";
+                }
+            NON_WEIGHTED_GRAPH_END
+        }
+        if (!has_path)
+            std::cout << "->[none,none]";
+
+        std::cout << '\n';
+    }
+    std::cout << std::endl;
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+template <bool Ascending>
+decltype(auto) AdjacentMatrix<Ty,Weighted,Directed,Size>::makeEdgeQueue() const noexcept
+{
+    if constexpr (Ascending)
+        return std::priority_queue<EdgeType,std::vector<EdgeType>,std::greater<>>();
+    else
+        return std::priority_queue<EdgeType,std::vector<EdgeType>,std::less<>>();
+}
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::IndexCheck(index_t f, index_t s) const noexcept
+{
+    if (f >= Size || s >= Size)
+        return false;
+
+    Instrumentation::CountLookups(1);
+    if (!vertices_.Has(f))
+        return false;
+
+    Instrumentation::CountLookups(1);
+    return vertices_.Has(s);
+}
+
+
+template <typename Ty,
+		  bool Weighted,
+		  bool Directed,
+		  size_t Size>	
+bool AdjacentMatrix<Ty,Weighted,Directed,Size>::IndexCheck(index_t f) const noexcept
+{
+    if (f >= Size)
+        return false;
+
+    Instrumentation::CountLookups(1);
+    return vertices_.Has(f);
+}
+
+
+
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,793 @@
+#include "../algorithm.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline SearchSpace::SearchSpace():
+    distance_(static_cast<std::size_t>(UINT16_MAX) + 1, kUnreachable),
+    parent_(static_cast<std::size_t>(UINT16_MAX) + 1, 0)
+{
+
+}
+
+inline bool SearchSpace::Relax(index_t v, distance_t distance, index_t parent) noexcept
+{
+  if (distance >= distance_[v])
+    return false;
+
+  if (distance_[v] == kUnreachable)
+    touched_.push_back(v);
+
+  distance_[v] = distance;
+  parent_[v] = parent;
+  return true;
+}
+
+inline void SearchSpace::Push(distance_t key, index_t v) noexcept
+{
+  heap_.emplace_back(key, v);
+  std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+}
+
+inline std::pair<distance_t, index_t> SearchSpace::Pop() noexcept
+{
+  std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+  auto top = heap_.back();
+  heap_.pop_back();
+  return top;
+}
+
+inline distance_t SearchSpace::TopKey() const noexcept
+{
+  return heap_.empty() ? kUnreachable : heap_.front().first;
+}
+
+inline void SearchSpace::Reset() noexcept
+{
+  for (index_t v : touched_)
+    distance_[v] = kUnreachable;
+  touched_.clear();
+  heap_.clear();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::CoreNumbers(std::map<index_t, std::size_t> &res) const noexcept
+{
+  // Batagelj-Zaversnik bucket peeling, O(V + E)
+  res.clear();
+
+  Compact adjacency = MakeUndirectedView();
+  std::size_t n = adjacency.VerticesSize();
+  if (n == 0)
+    return;
+
+  std::vector<std::size_t> degree(n, 0);
+  std::size_t max_degree = 0;
+  for (std::size_t v = 0; v < n; ++v)
+  {
+    for (auto u = adjacency.NeighborBegin(v); u != adjacency.NeighborEnd(v); ++u)
+      if (*u != v)
+        ++degree[v];
+    max_degree = std::max(max_degree, degree[v]);
+  }
+
+  // bin[d] is the first slot of degree d in the sorted vertex array
+  std::vector<std::size_t> bin(max_degree + 1, 0);
+  for (std::size_t v = 0; v < n; ++v)
+    ++bin[degree[v]];
+  for (std::size_t d = 0, start = 0; d <= max_degree; ++d)
+  {
+    std::size_t count = bin[d];
+    bin[d] = start;
+    start += count;
+  }
+
+  std::vector<std::size_t> vertex(n), position(n);
+  for (std::size_t v = 0; v < n; ++v)
+  {
+    position[v] = bin[degree[v]]++;
+    vertex[position[v]] = v;
+  }
+  for (std::size_t d = max_degree; d > 0; --d)
+    bin[d] = bin[d - 1];
+  bin[0] = 0;
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::size_t v = vertex[i];
+    for (auto it = adjacency.NeighborBegin(v); it != adjacency.NeighborEnd(v); ++it)
+    {
+      std::size_t u = *it;
+      if (u == v || degree[u] <= degree[v])
+        continue;
+
+      // move u to the front of its bucket, then shrink the bucket past it
+      std::size_t du = degree[u];
+      std::size_t pu = position[u];
+      std::size_t pw = bin[du];
+      std::size_t w = vertex[pw];
+      if (u != w) {
+        position[u] = pw;
+        vertex[pu] = w;
+        position[w] = pu;
+        vertex[pw] = u;
+      }
+      ++bin[du];
+      --degree[u];
+    }
+  }
+
+  for (std::size_t v = 0; v < n; ++v)
+    res.emplace_hint(res.end(), adjacency.IdOf(v), degree[v]);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::ParallelCoreNumbers(std::map<index_t, std::size_t> &res, unsigned threads) const noexcept
+{
+  /*  Level-synchronous peeling: for k = 0, 1, ... remove every vertex whose degree is <= k,
+   *  decrement its neighbours atomically, and keep removing the neighbours whose degree
+   *  crosses from k + 1 to k. Exactly one decrement observes that crossing, so each vertex
+   *  enters a frontier once.
+   */
+  res.clear();
+
+  Compact adjacency = MakeUndirectedView();
+  std::size_t n = adjacency.VerticesSize();
+  if (n == 0)
+    return;
+
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  std::vector<std::atomic<std::size_t>> degree(n);
+  std::vector<std::size_t> core(n, 0);
+  std::vector<char> removed(n, 0);
+  std::vector<std::vector<std::size_t>> buckets(threads);
+
+  auto gather = [&buckets](std::vector<std::size_t> &out) {
+    out.clear();
+    for (auto &bucket : buckets)
+    {
+      out.insert(out.end(), bucket.begin(), bucket.end());
+      bucket.clear();
+    }
+  };
+
+  ParallelFor(0, n, threads, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t v = first; v < last; ++v)
+    {
+      std::size_t count = 0;
+      for (auto u = adjacency.NeighborBegin(v); u != adjacency.NeighborEnd(v); ++u)
+        if (*u != v)
+          ++count;
+      degree[v].store(count, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<std::size_t> remaining(n), frontier, rest;
+  for (std::size_t v = 0; v < n; ++v)
+    remaining[v] = v;
+
+  std::size_t k = 0;
+  while (!remaining.empty())
+  {
+    // skip empty levels
+    std::size_t lowest = SIZE_MAX;
+    for (std::size_t v : remaining)
+      lowest = std::min(lowest, degree[v].load(std::memory_order_relaxed));
+    k = std::max(k, lowest);
+
+    frontier.clear();
+    rest.clear();
+    for (std::size_t v : remaining)
+      (degree[v].load(std::memory_order_relaxed) <= k ? frontier : rest).push_back(v);
+
+    while (!frontier.empty())
+    {
+      for (std::size_t v : frontier)
+      {
+        removed[v] = 1;
+        core[v] = k;
+      }
+
+      // a frontier vertex costs its degree, so hubs are spread by the adaptive chunks
+      ParallelForAdaptive(0, frontier.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+        auto &next = buckets[worker];
+        for (std::size_t i = first; i < last; ++i)
+        {
+          std::size_t v = frontier[i];
+          for (auto it = adjacency.NeighborBegin(v); it != adjacency.NeighborEnd(v); ++it)
+          {
+            std::size_t u = *it;
+            if (u == v || removed[u])
+              continue;
+
+            if (degree[u].fetch_sub(1, std::memory_order_relaxed) == k + 1)
+              next.push_back(u);
+          }
+        }
+      });
+
+      gather(frontier);
+    }
+
+    remaining.clear();
+    for (std::size_t v : rest)
+      if (!removed[v])
+        remaining.push_back(v);
+    ++k;
+  }
+
+  for (std::size_t v = 0; v < n; ++v)
+    res.emplace_hint(res.end(), adjacency.IdOf(v), core[v]);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::BetweennessCentrality(std::map<index_t, double> &res, unsigned threads) const noexcept
+{
+  Compact adjacency(*this);
+
+  std::vector<std::size_t> sources(adjacency.VerticesSize());
+  std::iota(sources.begin(), sources.end(), 0);
+
+  AccumulateBetweenness(adjacency, sources, 1.0, res, threads);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::ApproximateBetweennessCentrality(std::map<index_t, double> &res,
+                                                                                         std::size_t samples,
+                                                                                         std::uint64_t seed,
+                                                                                         unsigned threads) const noexcept
+{
+  Compact adjacency(*this);
+  std::size_t n = adjacency.VerticesSize();
+
+  std::vector<std::size_t> sources(n);
+  std::iota(sources.begin(), sources.end(), 0);
+
+  if (samples == 0 || samples >= n) {
+    AccumulateBetweenness(adjacency, sources, 1.0, res, threads);
+    return;
+  }
+
+  // partial Fisher-Yates: the first `samples` slots become the sample
+  std::mt19937_64 engine(seed);
+  for (std::size_t i = 0; i < samples; ++i)
+  {
+    std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+    std::swap(sources[i], sources[pick(engine)]);
+  }
+  sources.resize(samples);
+
+  AccumulateBetweenness(adjacency, sources, static_cast<double>(n) / samples, res, threads);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+auto GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::MakeUndirectedView() const noexcept -> Compact
+{
+  DIRECTED_GRAPH
+    return Compact(*this, EdgeDirection::BOTH);
+  ELSE
+    return Compact(*this, EdgeDirection::OUT);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::AccumulateBetweenness(const Compact &adjacency,
+                                                                              const std::vector<std::size_t> &sources,
+                                                                              double scale,
+                                                                              std::map<index_t, double> &res,
+                                                                              unsigned threads) const noexcept
+{
+  res.clear();
+
+  std::size_t n = adjacency.VerticesSize();
+  if (n == 0)
+    return;
+
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  static constexpr std::size_t kUnsettled = std::numeric_limits<std::size_t>::max();
+
+  /*  Buffers of one worker, sized once and reset only on the vertices a source reached,
+   *  so a source costs O(reached vertices + their arcs) and never allocates.
+   */
+  struct Workspace
+  {
+    std::vector<distance_t> distance;
+    std::vector<double> paths;
+    std::vector<double> dependency;
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> position;    // index in order, kUnsettled until then
+    std::vector<std::pair<distance_t, std::size_t>> heap;
+    std::vector<double> centrality;
+
+    explicit Workspace(std::size_t n):
+        distance(n, kUnreachable), paths(n, 0), dependency(n, 0), position(n, kUnsettled), centrality(n, 0)
+    {
+      order.reserve(n);
+    }
+  };
+
+  std::vector<Workspace> workspaces;
+  workspaces.reserve(threads);
+  for (unsigned i = 0; i < threads; ++i)
+    workspaces.emplace_back(n);
+
+  ParallelFor(0, sources.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+    Workspace &space = workspaces[worker];
+    auto &distance = space.distance;
+    auto &paths = space.paths;
+    auto &dependency = space.dependency;
+    auto &order = space.order;
+    auto &position = space.position;
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+      std::size_t source = sources[i];
+      distance[source] = 0;
+      paths[source] = 1;
+
+      WEIGHTED_GRAPH_BEGIN
+        /*  order collects vertices as they are settled. Paths only flow from a settled vertex to an
+         *  unsettled one, so over a zero-weight edge the end settled first is the predecessor and
+         *  the other never adds its count back.
+         */
+        auto &heap = space.heap;
+        auto later = [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; };
+        heap.emplace_back(0, source);
+        while (!heap.empty())
+        {
+          std::pop_heap(heap.begin(), heap.end(), later);
+          auto [dist, v] = heap.back();
+          heap.pop_back();
+          if (position[v] != kUnsettled)
+            continue;
+
+          position[v] = order.size();
+          order.push_back(v);
+          for (std::size_t arc = adjacency.ArcBegin(v); arc < adjacency.ArcBegin(v) + adjacency.Degree(v); ++arc)
+          {
+            std::size_t w = adjacency.Target(arc);
+            if (position[w] != kUnsettled)
+              continue;
+
+            distance_t candidate = dist + adjacency.Weight(arc);
+            if (candidate < distance[w]) {
+              distance[w] = candidate;
+              paths[w] = paths[v];
+              heap.emplace_back(candidate, w);
+              std::push_heap(heap.begin(), heap.end(), later);
+            } else if (candidate == distance[w]) {
+              paths[w] += paths[v];
+            }
+          }
+        }
+      WEIGHTED_GRAPH_END
+      NON_WEIGHTED_GRAPH_BEGIN
+        // order doubles as the BFS queue
+        position[source] = 0;
+        order.push_back(source);
+        for (std::size_t head = 0; head < order.size(); ++head)
+        {
+          std::size_t v = order[head];
+          for (auto it = adjacency.NeighborBegin(v); it != adjacency.NeighborEnd(v); ++it)
+          {
+            std::size_t w = *it;
+            if (distance[w] == kUnreachable) {
+              distance[w] = distance[v] + 1;
+              position[w] = order.size();
+              order.push_back(w);
+            }
+            if (distance[w] == distance[v] + 1)
+              paths[w] += paths[v];
+          }
+        }
+      NON_WEIGHTED_GRAPH_END
+
+      /*  walk back in settle order. w is a successor of v when it settled after v over a tight
+       *  arc: exactly the arcs that added v's paths to w above.
+       */
+      for (auto it = order.rbegin(); it != order.rend(); ++it)
+      {
+        std::size_t v = *it;
+        for (std::size_t arc = adjacency.ArcBegin(v); arc < adjacency.ArcBegin(v) + adjacency.Degree(v); ++arc)
+        {
+          std::size_t w = adjacency.Target(arc);
+          if (position[w] > position[v] && distance[w] == distance[v] + adjacency.Weight(arc))
+            dependency[v] += paths[v] / paths[w] * (1 + dependency[w]);
+        }
+        if (v != source)
+          space.centrality[v] += dependency[v];
+      }
+
+      for (std::size_t v : order)
+      {
+        distance[v] = kUnreachable;
+        paths[v] = 0;
+        dependency[v] = 0;
+        position[v] = kUnsettled;
+      }
+      order.clear();
+    }
+  });
+
+  NON_DIRECTED_GRAPH
+    scale /= 2;
+
+  for (std::size_t v = 0; v < n; ++v)
+  {
+    double total = 0;
+    for (auto &space : workspaces)
+      total += space.centrality[v];
+    res.emplace_hint(res.end(), adjacency.IdOf(v), total * scale);
+  }
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+template <typename Heuristic>
+distance_t GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::AStar(index_t start,
+                                                                  index_t dest,
+                                                                  Heuristic&& heuristic,
+                                                                  std::vector<index_t> &path) const noexcept
+{
+  path.clear();
+  if (!this->HasVertex(start) || !this->HasVertex(dest))
+    return kUnreachable;
+
+  static thread_local SearchSpace space;
+  space.Reset();
+
+  space.Relax(start, 0, start);
+  space.Push(static_cast<distance_t>(heuristic(start)), start);
+
+  while (!space.heap_.empty())
+  {
+    auto [key, v] = space.Pop();
+    distance_t dist = space.distance_[v];
+    if (key > dist + static_cast<distance_t>(heuristic(v)))
+      continue;  // stale entry
+
+    if (v == dest)
+      break;
+
+    this->ForEachOut(v, [&](index_t w, weight_t weight) {
+      if (space.Relax(w, dist + weight, v))
+        space.Push(dist + weight + static_cast<distance_t>(heuristic(w)), w);
+    });
+  }
+
+  distance_t result = space.distance_[dest];
+  if (result == kUnreachable)
+    return kUnreachable;
+
+  for (index_t v = dest; v != start; v = space.parent_[v])
+    path.push_back(v);
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  return result;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+distance_t GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::BidirectionalDijkstra(index_t start,
+                                                                                  index_t dest,
+                                                                                  std::vector<index_t> &path) const noexcept
+{
+  path.clear();
+  if (!this->HasVertex(start) || !this->HasVertex(dest))
+    return kUnreachable;
+
+  static thread_local SearchSpace forward, backward;
+  forward.Reset();
+  backward.Reset();
+
+  forward.Relax(start, 0, start);
+  forward.Push(0, start);
+  backward.Relax(dest, 0, dest);
+  backward.Push(0, dest);
+
+  distance_t best = start == dest ? 0 : kUnreachable;
+  index_t meet = start;
+
+  // stop once no unsettled pair of frontiers can beat the best meeting found
+  while (!forward.heap_.empty() && !backward.heap_.empty() &&
+         forward.TopKey() + backward.TopKey() < best)
+  {
+    bool from_start = forward.heap_.size() <= backward.heap_.size();
+    SearchSpace &self = from_start ? forward : backward;
+    SearchSpace &other = from_start ? backward : forward;
+
+    auto [dist, v] = self.Pop();
+    if (dist > self.distance_[v])
+      continue;
+
+    auto relax = [&](index_t w, weight_t weight) {
+      distance_t candidate = dist + weight;
+      if (self.Relax(w, candidate, v))
+        self.Push(candidate, w);
+
+      if (other.distance_[w] != kUnreachable && candidate + other.distance_[w] < best) {
+        best = candidate + other.distance_[w];
+        meet = w;
+      }
+    };
+
+    if (from_start)
+      this->ForEachOut(v, relax);
+    else
+      this->ForEachIn(v, relax);
+  }
+
+  if (best == kUnreachable)
+    return kUnreachable;
+
+  for (index_t v = meet; v != start; v = forward.parent_[v])
+    path.push_back(v);
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  for (index_t v = meet; v != dest; v = backward.parent_[v])
+    path.push_back(backward.parent_[v]);
+
+  return best;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::ShortestPaths(index_t source, std::map<index_t, distance_t> &res) const noexcept
+{
+  res.clear();
+  if (!this->HasVertex(source))
+    return;
+
+  static thread_local SearchSpace space;
+  space.Reset();
+
+  space.Relax(source, 0, source);
+  space.Push(0, source);
+  while (!space.heap_.empty())
+  {
+    auto [dist, v] = space.Pop();
+    if (dist > space.distance_[v])
+      continue;
+
+    this->ForEachOut(v, [&](index_t w, weight_t weight) {
+      if (space.Relax(w, dist + weight, v))
+        space.Push(dist + weight, w);
+    });
+  }
+
+  for (index_t v : space.touched_)
+    res.emplace(v, space.distance_[v]);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res) const noexcept
+{
+  res.clear();
+  if (!this->HasVertex(source))
+    return;
+
+  static thread_local SearchSpace space;
+  space.Reset();
+
+  // touched_ is the queue, vertices enter it in the order they are reached
+  space.Relax(source, 0, source);
+  for (std::size_t head = 0; head < space.touched_.size(); ++head)
+  {
+    index_t v = space.touched_[head];
+    distance_t level = space.distance_[v] + 1;
+    this->ForEachOut(v, [&](index_t w, weight_t) {
+      space.Relax(w, level, v);
+    });
+  }
+
+  for (index_t v : space.touched_)
+    res.emplace(v, space.distance_[v]);
+}
+
+template <typename Ty, bool Weighted, bool Directed, bool Matrix, size_t Size, typename Storage>
+distance_t GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::MaxFlow(index_t source,
+                                                                    index_t sink,
+                                                                    std::vector<index_t> &source_side) const noexcept
+{
+  source_side.clear();
+  if (!this->HasVertex(source) || !this->HasVertex(sink) || source == sink)
+    return 0;
+
+  if constexpr (std::is_same_v<Storage, AdjacentMatrixTag>) {
+    // the matrix is already indexed by id, so the residual is a plain copy of it
+    DenseResidual<Size> network(this->matrix_);
+    PushRelabel<DenseResidual<Size>> solver(network);
+    distance_t flow = solver.Run(source, sink);
+
+    for (const auto &item : *this)
+      if (solver.SourceSide(item.first))
+        source_side.push_back(item.first);
+    return flow;
+  } else {
+    Compact adjacency(*this);
+    SparseResidual network(adjacency);
+    PushRelabel<SparseResidual> solver(network);
+    distance_t flow = solver.Run(adjacency.PositionOf(source), adjacency.PositionOf(sink));
+
+    for (std::size_t v = 0; v < adjacency.VerticesSize(); ++v)
+      if (solver.SourceSide(v))
+        source_side.push_back(adjacency.IdOf(v));
+    return flow;
+  }
+}
+
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::TopEdges(EdgeWeight type,
+                                                               std::size_t k,
+                                                               std::vector<Edge<Weighted>> &res,
+                                                               unsigned threads) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  res.clear();
+  if (k == 0)
+    return;
+
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  std::vector<index_t> ids;
+  ids.reserve(this->VerticesSize());
+  for (const auto &entry : *this)
+    ids.push_back(entry.first);
+
+  auto better = [type](const Edge<true> &lhs, const Edge<true> &rhs) {
+    if (lhs.weight_ != rhs.weight_)
+      return type == EdgeWeight::MIN ? lhs.weight_ < rhs.weight_ : lhs.weight_ > rhs.weight_;
+    return std::tie(lhs.start_, lhs.destination_) < std::tie(rhs.start_, rhs.destination_);
+  };
+
+  // the front of every heap is the worst edge it keeps, the one a better edge pushes out
+  std::vector<std::vector<Edge<true>>> heaps(threads);
+  ParallelForAdaptive(0, ids.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+    auto &heap = heaps[worker];
+    for (std::size_t i = first; i < last; ++i)
+    {
+      index_t start = ids[i];
+      this->ForEachOut(start, [&](index_t dest, weight_t weight) {
+        NON_DIRECTED_GRAPH
+          if (dest < start)
+            return;
+
+        Edge<true> edge(start, dest, weight);
+        if (heap.size() < k) {
+          heap.push_back(edge);
+          std::push_heap(heap.begin(), heap.end(), better);
+        } else if (better(edge, heap.front())) {
+          std::pop_heap(heap.begin(), heap.end(), better);
+          heap.back() = edge;
+          std::push_heap(heap.begin(), heap.end(), better);
+        }
+      });
+    }
+  });
+
+  for (auto &heap : heaps)
+    res.insert(res.end(), heap.begin(), heap.end());
+  k = std::min(k, res.size());
+  std::partial_sort(res.begin(), res.begin() + k, res.end(), better);
+  res.resize(k);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+void GraphAlgorithm<Ty,Weighted,Directed,Matrix,Size,Storage>::EdgesInRange(weight_t low,
+                                                                   weight_t high,
+                                                                   std::vector<Edge<Weighted>> &res,
+                                                                   unsigned threads) const noexcept
+{
+  static_assert(Weighted,"Function can't work if the graph is not weighted.");
+
+  res.clear();
+  if (low > high)
+    return;
+
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  std::vector<index_t> ids;
+  ids.reserve(this->VerticesSize());
+  for (const auto &entry : *this)
+    ids.push_back(entry.first);
+
+  // every worker fills its own buffer, joined in worker order, which is the order of ids
+  std::vector<std::vector<Edge<true>>> found(threads);
+  ParallelFor(0, ids.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+    auto &edges = found[worker];
+    for (std::size_t i = first; i < last; ++i)
+    {
+      index_t start = ids[i];
+      auto keep = [&](index_t dest, weight_t weight) {
+        NON_DIRECTED_GRAPH
+          if (dest < start)
+            return;
+
+        if (low <= weight && weight <= high)
+          edges.emplace_back(start, dest, weight);
+      };
+
+      // the matching entries of a weight-ordered row are one run
+      if constexpr (!std::is_same_v<Storage, AdjacentMatrixTag>) {
+        if (const auto *row = this->weight_index_.RowOf(EdgeDirection::OUT, start)) {
+          auto entry = std::lower_bound(row->begin(), row->end(), WeightedNeighbor{low, 0});
+          for (; entry != row->end() && entry->weight_ <= high; ++entry)
+            keep(entry->neighbor_, entry->weight_);
+          continue;
+        }
+      }
+
+      this->ForEachOut(start, keep);
+    }
+  });
+
+  for (auto &edges : found)
+    res.insert(res.end(), edges.begin(), edges.end());
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,151 @@
+#include "../backend_estimate.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline std::array<BackendEstimate, 5> EstimateBackends(std::size_t vertices,
+                                                       std::size_t edges,
+                                                       bool weighted,
+                                                       bool directed,
+                                                       std::size_t payload) noexcept
+{
+  constexpr std::size_t kCacheLine = 64;
+  constexpr std::size_t kWord = sizeof(void *);
+
+  const std::size_t v = vertices;
+  const std::size_t arcs = directed ? edges : 2 * edges;  // undirected edges are stored both ways
+  const double degree = v ? static_cast<double>(arcs) / static_cast<double>(v) : 0;
+  const std::size_t row_degree = v ? (arcs + v / 2) / v : 0;
+  const double levels = std::log2(static_cast<double>(v < 2 ? 2 : v));
+  /*  the values of the mutable backends sit in a column of optional values indexed by id, each
+   *  value followed by its engaged flag padded to the value's alignment, with a presence bit per id
+   */
+  const std::size_t slot = payload + std::min<std::size_t>(payload & (~payload + 1), kWord);
+  const std::size_t column = v * slot + (v + 63) / 64 * sizeof(std::uint64_t);
+
+  std::array<BackendEstimate, 5> res{};
+
+  /*  list: map node of pair<const index_t, Link> per vertex and the value column, one LinkNode per
+   *  arc and per in-edge when directed, one EdgeNode per edge shared by both of its ends when undirected
+   */
+  {
+    std::size_t vertex_node = MapNodeSize(2 * kWord, kWord);
+
+    std::size_t bytes = sizeof(AdjacentList<index_t, false, false>) + v * AllocationSize(vertex_node) + column;
+    if (directed) {
+      std::size_t link = weighted ? sizeof(LinkNode<true>) : sizeof(LinkNode<false>);
+      bytes += v * AllocationSize(vertex_node) + 2 * arcs * AllocationSize(link);
+    } else {
+      std::size_t link = weighted ? sizeof(EdgeNode<true>) : sizeof(EdgeNode<false>);
+      bytes += edges * AllocationSize(link);
+    }
+
+    res[static_cast<std::size_t>(Backend::LIST)] =
+      BackendEstimate{Backend::LIST, bytes, 2 * levels + (degree + 1) / 2, levels + degree, true};
+  }
+
+  /*  matrix: Size x Size cells with Size = vertices, only the upper triangle of them when undirected,
+   *  plus the value column
+   */
+  {
+    BackendEstimate &matrix = res[static_cast<std::size_t>(Backend::MATRIX)];
+    if (v > std::numeric_limits<size_t>::max()) {  // Size is a size_t template argument
+      matrix = BackendEstimate{Backend::MATRIX, SIZE_MAX, HUGE_VAL, HUGE_VAL, true};
+    } else {
+      std::size_t row = weighted ? v * sizeof(weight_t) : (v + 63) / 64 * sizeof(std::uint64_t);
+      std::size_t triangle = v * (v + 1) / 2;
+      std::size_t cells = directed ? v * row
+                                   : weighted ? triangle * sizeof(weight_t) : (triangle + 63) / 64 * sizeof(std::uint64_t);
+      std::size_t bytes = cells + sizeof(VertexColumn<index_t>) + column;
+      double scan = 1 + static_cast<double>((row + kCacheLine - 1) / kCacheLine);
+      matrix = BackendEstimate{Backend::MATRIX, bytes, 3, scan, true};
+    }
+  }
+
+  // compact: id and position arrays, CSR offsets and targets, weights beside them
+  {
+    std::size_t arc_bytes = sizeof(index_t) + (weighted ? sizeof(weight_t) : 0);
+    std::size_t bytes = sizeof(CompactAdjacency<true>) + v * (sizeof(index_t) + sizeof(std::size_t)) +
+                        (v + 1) * sizeof(std::size_t) + arcs * arc_bytes;
+    double lookup = 2 + std::log2(degree + 1);  // binary search over the sorted targets
+    double scan = 2 + degree * static_cast<double>(arc_bytes) / kCacheLine;
+    res[static_cast<std::size_t>(Backend::COMPACT)] = BackendEstimate{Backend::COMPACT, bytes, lookup, scan, false};
+  }
+
+  /*  hybrid: map node of pair<const index_t, Node> per vertex, a Node being two rows, and the value
+   *  column; an average vertex has one row of row_degree arcs, two when directed, each a sorted
+   *  array of targets with the weights beside them, or a bit and a weight per id once that's smaller
+   */
+  {
+    std::size_t row_size = weighted ? sizeof(HybridRow<true>) : sizeof(HybridRow<false>);
+    std::size_t vertex_node = MapNodeSize(kWord + 2 * row_size, kWord);
+    std::size_t sparse = weighted ? HybridRow<true>::SparseBytes(row_degree) : HybridRow<false>::SparseBytes(row_degree);
+    std::size_t dense = weighted ? HybridRow<true>::DenseBytes(v) : HybridRow<false>::DenseBytes(v);
+    bool is_dense = sparse > dense;
+
+    std::size_t row = 0;
+    if (is_dense) {
+      row = AllocationSize((v + 63) / 64 * sizeof(std::uint64_t));
+      if (weighted)
+        row += AllocationSize((v + 63) / 64 * 64 * sizeof(weight_t));
+    } else if (row_degree) {
+      // inserts grow the arrays by doubling
+      std::size_t capacity = 1;
+      while (capacity < row_degree)
+        capacity *= 2;
+      row = AllocationSize(capacity * sizeof(index_t));
+      if (weighted)
+        row += AllocationSize(capacity * sizeof(weight_t));
+    }
+
+    std::size_t rows = directed ? 2 : 1;
+    std::size_t bytes = sizeof(AdjacentHybrid<index_t, false, false>) + v * AllocationSize(vertex_node) +
+                        v * rows * row + column;
+    double lookup = 2 * levels + 1 + (is_dense ? 1 : std::log2(degree + 1));
+    double scan = levels + 1 + static_cast<double>(((is_dense ? dense : sparse) + kCacheLine - 1) / kCacheLine);
+    res[static_cast<std::size_t>(Backend::HYBRID)] = BackendEstimate{Backend::HYBRID, bytes, lookup, scan, true};
+  }
+
+  /*  compressed: id and position arrays, byte offsets and first arcs, then per vertex a control
+   *  byte per block of eight gaps and a byte per gap, two once the targets lie 256 or more ids
+   *  apart; weights are assumed to span all 16 bits
+   */
+  {
+    constexpr std::size_t kBlock = 8;
+
+    std::size_t gap = v / (row_degree + 1) > 0xFF ? 2 : 1;
+    std::size_t row = (row_degree + kBlock - 1) / kBlock + row_degree * gap;
+    std::size_t weight_bytes = weighted ? (arcs * 16 + 63) / 64 * sizeof(std::uint64_t) : 0;
+    std::size_t bytes = sizeof(CompressedAdjacency<true>) + v * (sizeof(index_t) + sizeof(std::uint32_t)) +
+                        2 * (v + 1) * sizeof(std::size_t) + v * row + 1 + weight_bytes;
+    double weights = weighted ? static_cast<double>(row_degree * sizeof(weight_t)) / kCacheLine : 0;
+    double lookup = 3 + static_cast<double>(row / 2) / kCacheLine + (weighted ? 1 : 0);  // decoded up to the target
+    double scan = 3 + static_cast<double>(row) / kCacheLine + weights;
+    res[static_cast<std::size_t>(Backend::COMPRESSED)] = BackendEstimate{Backend::COMPRESSED, bytes, lookup, scan, false};
+  }
+
+  return res;
+}
+
+inline Backend RecommendBackend(std::size_t vertices,
+                                std::size_t edges,
+                                bool weighted,
+                                bool directed,
+                                bool read_only,
+                                std::size_t payload) noexcept
+{
+  auto estimates = EstimateBackends(vertices, edges, weighted, directed, payload);
+  auto bytes = [&estimates](Backend backend) { return estimates[static_cast<std::size_t>(backend)].bytes_; };
+
+  if (read_only)
+    return bytes(Backend::COMPRESSED) <= bytes(Backend::COMPACT) / 2 ? Backend::COMPRESSED : Backend::COMPACT;
+
+  std::size_t smallest = std::min(bytes(Backend::LIST), bytes(Backend::HYBRID));
+  if (bytes(Backend::MATRIX) / 2 <= smallest)
+    return Backend::MATRIX;
+
+  return bytes(Backend::LIST) < bytes(Backend::HYBRID) ? Backend::LIST : Backend::HYBRID;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,100 @@
+#include "../bsp.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Message>
+InProcessTransport<Message>::InProcessTransport(unsigned peers):
+    outboxes_(peers, std::vector<std::vector<Message>>(peers))
+{
+
+}
+
+template <typename Message>
+unsigned InProcessTransport<Message>::Peers() const noexcept
+{
+  return static_cast<unsigned>(outboxes_.size());
+}
+
+template <typename Message>
+void InProcessTransport<Message>::Send(unsigned from, unsigned to, const Message &message)
+{
+  outboxes_[from][to].push_back(message);
+}
+
+template <typename Message>
+bool InProcessTransport<Message>::Exchange(unsigned self, bool active, std::vector<Message> &inbox)
+{
+  for (const auto &outbox : outboxes_[self])
+    active = active || !outbox.empty();
+
+  // after the first barrier no peer writes an outbox, after the second none reads one
+  bool running = Barrier(active);
+
+  inbox.clear();
+  for (const auto &outboxes : outboxes_)
+    inbox.insert(inbox.end(), outboxes[self].begin(), outboxes[self].end());
+
+  Barrier(false);
+  for (auto &outbox : outboxes_[self])
+    outbox.clear();
+  return running;
+}
+
+template <typename Message>
+bool InProcessTransport<Message>::Barrier(bool flag)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  any_ = any_ || flag;
+  if (++arrived_ == Peers()) {
+    arrived_ = 0;
+    result_ = any_;
+    any_ = false;
+    ++generation_;
+    arrived_all_.notify_all();
+    return result_;
+  }
+
+  // result_ stays put until this peer has reached the next barrier
+  std::uint64_t generation = generation_;
+  arrived_all_.wait(lock, [&]() { return generation_ != generation; });
+  return result_;
+}
+
+template <typename Transport, typename Compute>
+std::size_t RunBsp(Transport &transport, Compute&& compute, std::size_t max_steps) noexcept
+{
+  const unsigned peers = transport.Peers();
+  std::size_t steps = 0;
+
+  // peers wait for each other at every barrier, so each needs a thread of its own, not a pool task
+  auto run = [&](unsigned peer) {
+    std::vector<typename Transport::MessageType> inbox;
+    std::size_t step = 0;
+    while (step < max_steps)
+    {
+      bool active = compute(peer, step, static_cast<const std::vector<typename Transport::MessageType> &>(inbox));
+      ++step;
+      if (!transport.Exchange(peer, active, inbox))
+        break;
+    }
+
+    if (peer == 0)
+      steps = step;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(peers);
+  for (unsigned peer = 1; peer < peers; ++peer)
+    threads.emplace_back(run, peer);
+
+  if (peers)
+    run(0);
+
+  for (auto &thread : threads)
+    thread.join();
+  return steps;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,207 @@
+#include "../compact_adjacency.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+template <typename Container>
+CompactAdjacency<Weighted>::CompactAdjacency(const Container &graph, EdgeDirection direction)
+{
+  for (auto &entry : graph)
+    ids_.push_back(entry.first);
+
+  positions_.assign(ids_.empty() ? 0 : static_cast<std::size_t>(ids_.back()) + 1, kNoPosition);
+  for (std::size_t position = 0; position < ids_.size(); ++position)
+    positions_[ids_[position]] = position;
+
+  offsets_.reserve(ids_.size() + 1);
+  offsets_.push_back(0);
+  for (index_t id : ids_)
+  {
+    graph.ForEachOut(id, [this](index_t dest, weight_t weight) {
+      if (dest >= positions_.size() || positions_[dest] == kNoPosition)
+        return;
+
+      targets_.push_back(static_cast<index_t>(positions_[dest]));
+      WEIGHTED_GRAPH
+        weights_.push_back(weight);
+    });
+    offsets_.push_back(targets_.size());
+  }
+
+  if (direction == EdgeDirection::IN) {
+    Transpose();
+  } else if (direction == EdgeDirection::BOTH) {
+    CompactAdjacency reversed(*this);
+    reversed.Transpose();
+
+    std::vector<std::size_t> offsets(offsets_.size());
+    std::vector<index_t> targets;
+    std::vector<weight_t> weights;
+    targets.reserve(targets_.size() * 2);
+    WEIGHTED_GRAPH
+      weights.reserve(weights_.size() * 2);
+
+    const CompactAdjacency *parts[] = {this, &reversed};
+    for (std::size_t position = 0; position < ids_.size(); ++position)
+    {
+      for (const CompactAdjacency *part : parts)
+        for (std::size_t arc = part->offsets_[position]; arc < part->offsets_[position + 1]; ++arc)
+        {
+          targets.push_back(part->targets_[arc]);
+          WEIGHTED_GRAPH
+            weights.push_back(part->weights_[arc]);
+        }
+      offsets[position + 1] = targets.size();
+    }
+
+    offsets_.swap(offsets);
+    targets_.swap(targets);
+    weights_.swap(weights);
+  }
+}
+
+template <bool Weighted>
+std::size_t CompactAdjacency<Weighted>::VerticesSize() const noexcept
+{
+  return ids_.size();
+}
+
+template <bool Weighted>
+std::size_t CompactAdjacency<Weighted>::EdgeSize() const noexcept
+{
+  return targets_.size();
+}
+
+template <bool Weighted>
+MemoryFootprint CompactAdjacency<Weighted>::MemoryUsage() const noexcept
+{
+  MemoryFootprint usage;
+  usage.vertex_table_ = sizeof(*this);
+  AccountVector(ids_, usage.vertex_table_, usage.slack_);
+  AccountVector(positions_, usage.vertex_table_, usage.slack_);
+  AccountVector(offsets_, usage.adjacency_, usage.slack_);
+  AccountVector(targets_, usage.adjacency_, usage.slack_);
+  AccountVector(weights_, usage.adjacency_, usage.slack_);
+  return usage;
+}
+
+template <bool Weighted>
+std::size_t CompactAdjacency<Weighted>::Degree(std::size_t position) const noexcept
+{
+  return offsets_[position + 1] - offsets_[position];
+}
+
+template <bool Weighted>
+index_t CompactAdjacency<Weighted>::IdOf(std::size_t position) const noexcept
+{
+  return ids_[position];
+}
+
+template <bool Weighted>
+std::size_t CompactAdjacency<Weighted>::PositionOf(index_t id) const noexcept
+{
+  if (id >= positions_.size())
+    return kNoPosition;
+
+  return positions_[id];
+}
+
+template <bool Weighted>
+const index_t *CompactAdjacency<Weighted>::NeighborBegin(std::size_t position) const noexcept
+{
+  return targets_.data() + offsets_[position];
+}
+
+template <bool Weighted>
+const index_t *CompactAdjacency<Weighted>::NeighborEnd(std::size_t position) const noexcept
+{
+  return targets_.data() + offsets_[position + 1];
+}
+
+template <bool Weighted>
+std::size_t CompactAdjacency<Weighted>::ArcBegin(std::size_t position) const noexcept
+{
+  return offsets_[position];
+}
+
+template <bool Weighted>
+index_t CompactAdjacency<Weighted>::Target(std::size_t arc) const noexcept
+{
+  return targets_[arc];
+}
+
+template <bool Weighted>
+weight_t CompactAdjacency<Weighted>::Weight(std::size_t arc) const noexcept
+{
+  WEIGHTED_GRAPH
+    return weights_[arc];
+  ELSE
+    return kConnected;
+}
+
+template <bool Weighted>
+void CompactAdjacency<Weighted>::Transpose(unsigned threads)
+{
+  if (offsets_.empty())
+    return;
+
+  // counting sort of the arcs by their target, a row of counters per worker
+  const std::size_t vertices = ids_.size();
+  std::size_t workers = threads ? threads : DefaultConcurrency();
+  workers = std::max<std::size_t>(1, std::min(workers, targets_.size() / kParallelArcs));
+
+  // each worker takes the sources of an equal share of the arcs
+  std::vector<std::size_t> bounds(workers + 1, vertices);
+  for (std::size_t worker = 0; worker < workers; ++worker)
+    bounds[worker] = static_cast<std::size_t>(std::lower_bound(offsets_.begin(), offsets_.end() - 1,
+                                                               worker * targets_.size() / workers) - offsets_.begin());
+
+  std::vector<std::vector<std::size_t>> cursors(workers, std::vector<std::size_t>(vertices, 0));
+
+  ParallelFor(0, workers, static_cast<unsigned>(workers), [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t worker = first; worker < last; ++worker)
+      for (std::size_t arc = offsets_[bounds[worker]]; arc < offsets_[bounds[worker + 1]]; ++arc)
+        ++cursors[worker][targets_[arc]];
+  });
+
+  // the arcs into a target are placed worker by worker, so each worker's sources stay ascending
+  std::vector<std::size_t> offsets(offsets_.size(), 0);
+  std::size_t next = 0;
+  for (std::size_t target = 0; target < vertices; ++target)
+  {
+    offsets[target] = next;
+    for (std::size_t worker = 0; worker < workers; ++worker)
+    {
+      std::size_t count = cursors[worker][target];
+      cursors[worker][target] = next;
+      next += count;
+    }
+  }
+  if (!offsets.empty())
+    offsets.back() = next;
+
+  std::vector<index_t> targets(targets_.size());
+  std::vector<weight_t> weights(weights_.size());
+  ParallelFor(0, workers, static_cast<unsigned>(workers), [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t worker = first; worker < last; ++worker)
+    {
+      std::vector<std::size_t> &cursor = cursors[worker];
+      for (std::size_t source = bounds[worker]; source < bounds[worker + 1]; ++source)
+        for (std::size_t arc = offsets_[source]; arc < offsets_[source + 1]; ++arc)
+        {
+          std::size_t slot = cursor[targets_[arc]]++;
+          targets[slot] = static_cast<index_t>(source);
+          WEIGHTED_GRAPH
+            weights[slot] = weights_[arc];
+        }
+    }
+  });
+
+  offsets_.swap(offsets);
+  targets_.swap(targets);
+  weights_.swap(weights);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,268 @@
+#include "../compressed_adjacency.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+template <typename Container>
+CompressedAdjacency<Weighted>::CompressedAdjacency(const Container &graph, EdgeDirection direction):
+    CompressedAdjacency(CompactAdjacency<Weighted>(graph, direction))
+{
+
+}
+
+template <bool Weighted>
+CompressedAdjacency<Weighted>::CompressedAdjacency(const CompactAdjacency<Weighted> &adjacency)
+{
+  const std::size_t vertices = adjacency.VerticesSize();
+  const std::size_t arcs = adjacency.EdgeSize();
+
+  ids_.reserve(vertices);
+  for (std::size_t position = 0; position < vertices; ++position)
+    ids_.push_back(adjacency.IdOf(position));
+
+  positions_.assign(ids_.empty() ? 0 : static_cast<std::size_t>(ids_.back()) + 1, kNoSlot);
+  for (std::size_t position = 0; position < vertices; ++position)
+    positions_[ids_[position]] = static_cast<std::uint32_t>(position);
+
+  // the narrowest power-of-two width holding every weight as an offset from the smallest
+  WEIGHTED_GRAPH_BEGIN
+    if (arcs) {
+      weight_t low = kWeightMax, high = kWeightMin;
+      for (std::size_t arc = 0; arc < arcs; ++arc)
+      {
+        low = std::min(low, adjacency.Weight(arc));
+        high = std::max(high, adjacency.Weight(arc));
+      }
+
+      weight_base_ = low;
+      auto range = static_cast<std::uint32_t>(high - low);
+      while ((std::uint32_t{1} << weight_bits_) <= range)
+        weight_bits_ = weight_bits_ ? 2 * weight_bits_ : 1;
+    }
+    weights_.assign((arcs * weight_bits_ + kWordBits - 1) / kWordBits, 0);
+  WEIGHTED_GRAPH_END
+
+  offsets_.reserve(vertices + 1);
+  arcs_.reserve(vertices + 1);
+  bytes_.reserve(arcs + (arcs + kBlock - 1) / kBlock + vertices + 1);
+
+  std::vector<std::pair<index_t, weight_t>> neighbors;
+  std::size_t arc = 0;
+  for (std::size_t position = 0; position < vertices; ++position)
+  {
+    offsets_.push_back(bytes_.size());
+    arcs_.push_back(arc);
+
+    // a BOTH copy lists the out-arcs before the in-arcs, gaps need them in order
+    neighbors.clear();
+    const index_t *target = adjacency.NeighborBegin(position);
+    for (std::size_t source = adjacency.ArcBegin(position); target != adjacency.NeighborEnd(position); ++target, ++source)
+      neighbors.emplace_back(*target, adjacency.Weight(source));
+    std::sort(neighbors.begin(), neighbors.end());
+
+    std::size_t previous = 0;
+    for (std::size_t first = 0; first < neighbors.size(); first += kBlock)
+    {
+      std::size_t control = bytes_.size();
+      bytes_.push_back(0);
+      for (std::size_t i = 0; i < kBlock && first + i < neighbors.size(); ++i, ++arc)
+      {
+        auto [next, weight] = neighbors[first + i];
+        std::size_t gap = next - previous;
+        previous = next;
+
+        bytes_.push_back(static_cast<std::uint8_t>(gap));
+        if (gap > 0xFF) {
+          bytes_[control] |= static_cast<std::uint8_t>(1u << i);
+          bytes_.push_back(static_cast<std::uint8_t>(gap >> 8));
+        }
+
+        WEIGHTED_GRAPH_BEGIN
+          std::size_t bit = arc * weight_bits_;
+          auto offset = static_cast<std::uint64_t>(static_cast<std::uint32_t>(weight - weight_base_));
+          if (weight_bits_)
+            weights_[bit / kWordBits] |= offset << (bit % kWordBits);
+        WEIGHTED_GRAPH_END
+      }
+    }
+  }
+
+  offsets_.push_back(bytes_.size());
+  arcs_.push_back(arc);
+  bytes_.push_back(0);
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::VerticesSize() const noexcept
+{
+  return ids_.size();
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::EdgeSize() const noexcept
+{
+  return arcs_.empty() ? 0 : arcs_.back();
+}
+
+template <bool Weighted>
+MemoryFootprint CompressedAdjacency<Weighted>::MemoryUsage() const noexcept
+{
+  MemoryFootprint usage;
+  usage.vertex_table_ = sizeof(*this);
+  AccountVector(ids_, usage.vertex_table_, usage.slack_);
+  AccountVector(positions_, usage.vertex_table_, usage.slack_);
+  AccountVector(offsets_, usage.adjacency_, usage.slack_);
+  AccountVector(arcs_, usage.adjacency_, usage.slack_);
+  AccountVector(bytes_, usage.adjacency_, usage.slack_);
+  AccountVector(weights_, usage.adjacency_, usage.slack_);
+  return usage;
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::Degree(std::size_t position) const noexcept
+{
+  return arcs_[position + 1] - arcs_[position];
+}
+
+template <bool Weighted>
+index_t CompressedAdjacency<Weighted>::IdOf(std::size_t position) const noexcept
+{
+  return ids_[position];
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::PositionOf(index_t id) const noexcept
+{
+  if (id >= positions_.size() || positions_[id] == kNoSlot)
+    return kNoPosition;
+
+  return positions_[id];
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::ArcBegin(std::size_t position) const noexcept
+{
+  return arcs_[position];
+}
+
+template <bool Weighted>
+weight_t CompressedAdjacency<Weighted>::Weight(std::size_t arc) const noexcept
+{
+  NON_WEIGHTED_GRAPH
+    return kConnected;
+
+  if (!weight_bits_)
+    return weight_base_;
+
+  std::size_t bit = arc * weight_bits_;
+  std::uint64_t mask = (std::uint64_t{1} << weight_bits_) - 1;
+  auto offset = static_cast<std::uint32_t>((weights_[bit / kWordBits] >> (bit % kWordBits)) & mask);
+  return static_cast<weight_t>(weight_base_ + static_cast<std::int32_t>(offset));
+}
+
+template <bool Weighted>
+template <typename Visitor>
+void CompressedAdjacency<Weighted>::ForEachNeighbor(std::size_t position, Visitor&& visit) const noexcept
+{
+  Walk(position, [&](index_t target, std::size_t arc) {
+    visit(target, Weight(arc));
+    return true;
+  });
+}
+
+template <bool Weighted>
+template <typename Visitor>
+void CompressedAdjacency<Weighted>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  std::size_t position = PositionOf(start);
+  if (position == kNoPosition)
+    return;
+
+  Walk(position, [&](index_t target, std::size_t arc) {
+    visit(ids_[target], Weight(arc));
+    return true;
+  });
+}
+
+template <bool Weighted>
+bool CompressedAdjacency<Weighted>::GetEdgeOut(index_t start, std::vector<Edge<Weighted>> &res, bool append) const noexcept
+{
+  std::size_t position = PositionOf(start);
+  if (position == kNoPosition)
+    return false;
+
+  if (!append)
+    res.clear();
+
+  res.reserve(res.size() + Degree(position));
+  Walk(position, [&](index_t target, std::size_t arc) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, ids_[target], Weight(arc));
+    ELSE
+      res.emplace_back(start, ids_[target]);
+    return true;
+  });
+  return true;
+}
+
+template <bool Weighted>
+bool CompressedAdjacency<Weighted>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  std::size_t position = PositionOf(start), target = PositionOf(dest);
+  return position != kNoPosition && target != kNoPosition && FindArc(position, target) != kNoPosition;
+}
+
+template <bool Weighted>
+weight_t CompressedAdjacency<Weighted>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  std::size_t position = PositionOf(start), target = PositionOf(dest);
+  if (position == kNoPosition || target == kNoPosition)
+    return kDisconnected;
+
+  std::size_t arc = FindArc(position, target);
+  return arc == kNoPosition ? kDisconnected : Weight(arc);
+}
+
+template <bool Weighted>
+template <typename Step>
+void CompressedAdjacency<Weighted>::Walk(std::size_t position, Step&& step) const noexcept
+{
+  const std::uint8_t *data = bytes_.data() + offsets_[position];
+  std::size_t arc = arcs_[position];
+  const std::size_t last = arcs_[position + 1];
+  unsigned target = 0;
+
+  while (arc < last)
+  {
+    unsigned control = *data++;
+    const std::size_t block_end = std::min(arc + kBlock, last);
+    for (; arc < block_end; ++arc, control >>= 1)
+    {
+      // the high byte is masked off rather than branched over when the gap is short
+      unsigned wide = control & 1u;
+      target += data[0] | ((static_cast<unsigned>(data[1]) << 8) & (0u - wide));
+      data += 1 + wide;
+      if (!step(static_cast<index_t>(target), arc))
+        return;
+    }
+  }
+}
+
+template <bool Weighted>
+std::size_t CompressedAdjacency<Weighted>::FindArc(std::size_t position, std::size_t target) const noexcept
+{
+  std::size_t found = kNoPosition;
+  Walk(position, [&](index_t next, std::size_t arc) {
+    if (next < target)
+      return true;
+
+    if (next == target)
+      found = arc;
+    return false;
+  });
+  return found;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
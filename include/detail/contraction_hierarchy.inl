@@ -0,0 +1,511 @@
+#include "../contraction_hierarchy.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Container>
+ContractionHierarchy::ContractionHierarchy(const Container &graph, unsigned threads)
+{
+  Build(graph, threads);
+}
+
+template <typename Container>
+void ContractionHierarchy::Build(const Container &graph, unsigned threads) noexcept
+{
+  /*  Witness searches give up after this many settled vertices and keep the shortcut.
+   *  Estimating a priority only needs a rough count, so it searches less than a contraction.
+   */
+  constexpr std::size_t kEstimateSettleLimit = 20;
+  constexpr std::size_t kContractSettleLimit = 500;
+
+  enum : char { kActive, kSelected, kContracted };
+
+  struct Shortcut
+  {
+    index_t from_;
+    index_t to_;
+    index_t middle_;
+    ArcWeight weight_;
+  };
+
+  Clear();
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  CompactAdjacency<true> adjacency(graph);
+  std::size_t n = adjacency.VerticesSize();
+
+  // Working graph by position: out[v] holds arcs v->target_, in[v] holds arcs target_->v.
+  std::vector<std::vector<Arc>> out(n), in(n);
+  auto add_arc = [](std::vector<Arc> &arcs, index_t other, ArcWeight weight, index_t middle) {
+    for (auto &arc : arcs)
+      if (arc.target_ == other) {
+        if (weight < arc.weight_) {
+          arc.weight_ = weight;
+          arc.middle_ = middle;
+        }
+        return;
+      }
+    arcs.push_back(Arc{weight, other, middle});
+  };
+
+  for (std::size_t v = 0; v < n; ++v)
+    for (std::size_t arc = adjacency.ArcBegin(v); arc < adjacency.ArcBegin(v) + adjacency.Degree(v); ++arc)
+    {
+      index_t u = adjacency.Target(arc);
+      if (u == v)
+        continue;
+
+      ArcWeight weight = static_cast<ArcWeight>(adjacency.Weight(arc));
+      add_arc(out[v], u, weight, u);
+      add_arc(in[u], static_cast<index_t>(v), weight, static_cast<index_t>(v));
+    }
+
+  std::vector<char> state(n, kActive);
+  std::vector<char> dirty(n, 1);
+  std::vector<std::int64_t> priority(n, 0);
+  std::vector<std::int64_t> depth(n, 0);
+  std::vector<std::size_t> rank(n, kNoRank);
+
+  std::vector<SearchSpace> spaces(threads);
+  std::vector<std::vector<Shortcut>> found(threads);
+  std::vector<std::vector<std::size_t>> picks(threads);
+
+  // Number of shortcuts contracting v needs; they are appended to shortcuts when it isn't null.
+  auto contract = [&](std::size_t v, SearchSpace &space, std::vector<Shortcut> *shortcuts) {
+    std::size_t settle_limit = shortcuts ? kContractSettleLimit : kEstimateSettleLimit;
+    std::int64_t count = 0;
+    for (const Arc &first : in[v])
+    {
+      index_t x = first.target_;
+      if (state[x] != kActive)
+        continue;
+
+      ArcWeight limit = 0;
+      bool has_target = false;
+      for (const Arc &second : out[v])
+        if (state[second.target_] == kActive && second.target_ != x) {
+          limit = std::max(limit, first.weight_ + second.weight_);
+          has_target = true;
+        }
+      if (!has_target)
+        continue;
+
+      space.Reset();
+      space.Relax(x, 0, x);
+      space.Push(0, x);
+      for (std::size_t settled = 0; !space.heap_.empty() && settled < settle_limit; ++settled)
+      {
+        auto [dist, u] = space.Pop();
+        if (dist > space.distance_[u])
+          continue;
+        if (dist > limit)
+          break;
+
+        for (const Arc &arc : out[u])
+        {
+          if (arc.target_ == v || state[arc.target_] != kActive)
+            continue;
+          if (space.Relax(arc.target_, dist + arc.weight_, u))
+            space.Push(dist + arc.weight_, arc.target_);
+        }
+      }
+
+      for (const Arc &second : out[v])
+      {
+        index_t y = second.target_;
+        if (state[y] != kActive || y == x)
+          continue;
+
+        ArcWeight through = first.weight_ + second.weight_;
+        if (space.distance_[y] <= static_cast<distance_t>(through))
+          continue;  // a witness path avoids v
+
+        ++count;
+        if (shortcuts)
+          shortcuts->push_back(Shortcut{x, y, static_cast<index_t>(v), through});
+      }
+    }
+    return count;
+  };
+
+  std::vector<std::size_t> remaining(n), batch;
+  for (std::size_t v = 0; v < n; ++v)
+    remaining[v] = v;
+
+  std::size_t next_rank = 0;
+  while (!remaining.empty())
+  {
+    // edge difference plus the number of contracted neighbours, recomputed where it changed
+    ParallelFor(0, remaining.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i)
+      {
+        std::size_t v = remaining[i];
+        if (!dirty[v])
+          continue;
+
+        std::int64_t arcs = 0;
+        for (const Arc &arc : in[v])
+          arcs += state[arc.target_] == kActive;
+        for (const Arc &arc : out[v])
+          arcs += state[arc.target_] == kActive;
+
+        priority[v] = 2 * contract(v, spaces[worker], nullptr) - arcs + depth[v];
+        dirty[v] = 0;
+      }
+    });
+
+    // vertices whose priority is below every active neighbour form an independent set
+    ParallelFor(0, remaining.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+      auto lower = [&](std::size_t u, std::size_t v) {
+        return priority[u] < priority[v] || (priority[u] == priority[v] && u < v);
+      };
+      for (std::size_t i = first; i < last; ++i)
+      {
+        std::size_t v = remaining[i];
+        bool minimal = true;
+        for (const Arc &arc : in[v])
+          if (state[arc.target_] == kActive && lower(arc.target_, v)) {
+            minimal = false;
+            break;
+          }
+        if (minimal)
+          for (const Arc &arc : out[v])
+            if (state[arc.target_] == kActive && lower(arc.target_, v)) {
+              minimal = false;
+              break;
+            }
+        if (minimal)
+          picks[worker].push_back(v);
+      }
+    });
+
+    batch.clear();
+    for (auto &pick : picks)
+    {
+      batch.insert(batch.end(), pick.begin(), pick.end());
+      pick.clear();
+    }
+    for (std::size_t v : batch)
+      state[v] = kSelected;
+
+    ParallelFor(0, batch.size(), threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i)
+        contract(batch[i], spaces[worker], &found[worker]);
+    });
+
+    // v keeps its own arcs for the search graph, its neighbours drop theirs to v
+    auto drop_arc = [](std::vector<Arc> &arcs, std::size_t other) {
+      for (auto &arc : arcs)
+        if (arc.target_ == other) {
+          arc = arcs.back();
+          arcs.pop_back();
+          return;
+        }
+    };
+    for (std::size_t v : batch)
+    {
+      state[v] = kContracted;
+      rank[v] = next_rank++;
+      for (const Arc &arc : in[v])
+      {
+        drop_arc(out[arc.target_], v);
+        ++depth[arc.target_];
+        dirty[arc.target_] = 1;
+      }
+      for (const Arc &arc : out[v])
+      {
+        drop_arc(in[arc.target_], v);
+        ++depth[arc.target_];
+        dirty[arc.target_] = 1;
+      }
+    }
+
+    for (auto &shortcuts : found)
+    {
+      for (const Shortcut &shortcut : shortcuts)
+      {
+        add_arc(out[shortcut.from_], shortcut.to_, shortcut.weight_, shortcut.middle_);
+        add_arc(in[shortcut.to_], shortcut.from_, shortcut.weight_, shortcut.middle_);
+      }
+      shortcuts.clear();
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t v : remaining)
+      if (state[v] == kActive)
+        remaining[kept++] = v;
+    remaining.resize(kept);
+  }
+
+  // search graph numbered by rank
+  std::vector<std::size_t> order(n);
+  for (std::size_t v = 0; v < n; ++v)
+    order[rank[v]] = v;
+
+  ids_.resize(n);
+  ranks_.assign(n ? static_cast<std::size_t>(adjacency.IdOf(n - 1)) + 1 : 0, kNoRank);
+  for (std::size_t v = 0; v < n; ++v)
+  {
+    ids_[rank[v]] = adjacency.IdOf(v);
+    ranks_[adjacency.IdOf(v)] = rank[v];
+  }
+
+  auto relabel = [&rank](const Arc &arc) {
+    return Arc{arc.weight_, static_cast<index_t>(rank[arc.target_]), static_cast<index_t>(rank[arc.middle_])};
+  };
+
+  up_offsets_.reserve(n + 1);
+  down_offsets_.reserve(n + 1);
+  up_offsets_.push_back(0);
+  down_offsets_.push_back(0);
+  for (std::size_t r = 0; r < n; ++r)
+  {
+    std::size_t v = order[r];
+    for (const Arc &arc : out[v])
+      if (rank[arc.target_] > r)
+        up_.push_back(relabel(arc));
+    for (const Arc &arc : in[v])
+      if (rank[arc.target_] > r)
+        down_.push_back(relabel(arc));
+    up_offsets_.push_back(up_.size());
+    down_offsets_.push_back(down_.size());
+  }
+}
+
+inline distance_t ContractionHierarchy::Query(index_t start, index_t dest) const noexcept
+{
+  std::vector<index_t> path;
+  return Query(start, dest, path, false);
+}
+
+inline distance_t ContractionHierarchy::Query(index_t start, index_t dest, std::vector<index_t> &path) const noexcept
+{
+  return Query(start, dest, path, true);
+}
+
+inline std::size_t ContractionHierarchy::VerticesSize() const noexcept
+{
+  return ids_.size();
+}
+
+inline std::size_t ContractionHierarchy::ArcSize() const noexcept
+{
+  return up_.size() + down_.size();
+}
+
+inline bool ContractionHierarchy::Save(std::ostream &out) const
+{
+  static_assert(sizeof(Arc) == 8, "Arc must have no padding to be written as raw bytes.");
+
+  auto write_u64 = [&out](std::uint64_t value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  auto write_offsets = [&](const std::vector<std::size_t> &offsets) {
+    write_u64(offsets.size());
+    for (std::size_t offset : offsets)
+      write_u64(offset);
+  };
+  auto write_arcs = [&](const std::vector<Arc> &arcs) {
+    write_u64(arcs.size());
+    out.write(reinterpret_cast<const char *>(arcs.data()), arcs.size() * sizeof(Arc));
+  };
+
+  out.write(reinterpret_cast<const char *>(&kMagic), sizeof(kMagic));
+  out.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+  write_u64(ids_.size());
+  out.write(reinterpret_cast<const char *>(ids_.data()), ids_.size() * sizeof(index_t));
+  write_offsets(up_offsets_);
+  write_arcs(up_);
+  write_offsets(down_offsets_);
+  write_arcs(down_);
+
+  return static_cast<bool>(out);
+}
+
+inline bool ContractionHierarchy::Load(std::istream &in)
+{
+  Clear();
+
+  auto read_u64 = [&in](std::uint64_t &value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+  };
+  auto read_csr = [&](std::vector<std::size_t> &offsets, std::vector<Arc> &arcs, std::size_t n) {
+    std::uint64_t count;
+    if (!read_u64(count) || count != n + 1)
+      return false;
+
+    offsets.resize(count);
+    for (auto &offset : offsets)
+    {
+      std::uint64_t value;
+      if (!read_u64(value))
+        return false;
+      offset = value;
+    }
+
+    if (!read_u64(count) || offsets.front() != 0 || offsets.back() != count)
+      return false;
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+      if (offsets[i] < offsets[i - 1])
+        return false;
+
+    arcs.resize(count);
+    if (!in.read(reinterpret_cast<char *>(arcs.data()), count * sizeof(Arc)))
+      return false;
+
+    for (std::size_t r = 0; r < n; ++r)
+      for (std::size_t i = offsets[r]; i < offsets[r + 1]; ++i)
+        if (arcs[i].target_ <= r || arcs[i].target_ >= n || arcs[i].middle_ >= n)
+          return false;
+    return true;
+  };
+
+  std::uint32_t magic = 0, version = 0;
+  std::uint64_t n = 0;
+  in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  in.read(reinterpret_cast<char *>(&version), sizeof(version));
+  if (!in || magic != kMagic || version != kVersion || !read_u64(n) || n > static_cast<std::uint64_t>(UINT16_MAX) + 1)
+    return false;
+
+  ids_.resize(n);
+  bool success = static_cast<bool>(in.read(reinterpret_cast<char *>(ids_.data()), n * sizeof(index_t))) &&
+                 read_csr(up_offsets_, up_, n) &&
+                 read_csr(down_offsets_, down_, n);
+
+  if (success) {
+    ranks_.assign(static_cast<std::size_t>(UINT16_MAX) + 1, kNoRank);
+    std::size_t limit = 0;
+    for (std::size_t r = 0; r < n && success; ++r)
+    {
+      success = ranks_[ids_[r]] == kNoRank;
+      ranks_[ids_[r]] = r;
+      limit = std::max(limit, static_cast<std::size_t>(ids_[r]) + 1);
+    }
+    ranks_.resize(limit);
+  }
+
+  if (!success)
+    Clear();
+  return success;
+}
+
+inline std::size_t ContractionHierarchy::RankOf(index_t id) const noexcept
+{
+  return id < ranks_.size() ? ranks_[id] : kNoRank;
+}
+
+inline distance_t ContractionHierarchy::Query(index_t start, index_t dest, std::vector<index_t> &path, bool unpack) const noexcept
+{
+  path.clear();
+
+  std::size_t s = RankOf(start), t = RankOf(dest);
+  if (s == kNoRank || t == kNoRank)
+    return kUnreachable;
+
+  static thread_local SearchSpace forward, backward;
+  forward.Reset();
+  backward.Reset();
+
+  forward.Relax(static_cast<index_t>(s), 0, static_cast<index_t>(s));
+  forward.Push(0, static_cast<index_t>(s));
+  backward.Relax(static_cast<index_t>(t), 0, static_cast<index_t>(t));
+  backward.Push(0, static_cast<index_t>(t));
+
+  distance_t best = s == t ? 0 : kUnreachable;
+  std::size_t meet = s;
+
+  // both searches only climb, so a side stops once its smallest key can't improve the best
+  while (std::min(forward.TopKey(), backward.TopKey()) < best)
+  {
+    bool upward = forward.TopKey() <= backward.TopKey();
+    SearchSpace &self = upward ? forward : backward;
+    SearchSpace &other = upward ? backward : forward;
+    const auto &offsets = upward ? up_offsets_ : down_offsets_;
+    const auto &arcs = upward ? up_ : down_;
+
+    auto [dist, v] = self.Pop();
+    if (dist > self.distance_[v])
+      continue;
+
+    // stall-on-demand: a shorter way into v through a higher ranked vertex means v isn't on a shortest path
+    const auto &stall_offsets = upward ? down_offsets_ : up_offsets_;
+    const auto &stall_arcs = upward ? down_ : up_;
+    bool stalled = false;
+    for (std::size_t i = stall_offsets[v]; i < stall_offsets[v + 1] && !stalled; ++i)
+    {
+      distance_t before = self.distance_[stall_arcs[i].target_];
+      stalled = before != kUnreachable && before + stall_arcs[i].weight_ < dist;
+    }
+    if (stalled)
+      continue;
+
+    for (std::size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+    {
+      index_t w = arcs[i].target_;
+      if (self.Relax(w, dist + arcs[i].weight_, v))
+        self.Push(dist + arcs[i].weight_, w);
+
+      if (other.distance_[w] != kUnreachable && self.distance_[w] + other.distance_[w] < best) {
+        best = self.distance_[w] + other.distance_[w];
+        meet = w;
+      }
+    }
+  }
+
+  if (best == kUnreachable || !unpack)
+    return best;
+
+  std::vector<std::size_t> ranks;
+  for (std::size_t v = meet; v != s; v = forward.parent_[v])
+    ranks.push_back(v);
+  ranks.push_back(s);
+  std::reverse(ranks.begin(), ranks.end());
+  for (std::size_t v = meet; v != t; v = backward.parent_[v])
+    ranks.push_back(backward.parent_[v]);
+
+  path.push_back(ids_[s]);
+  for (std::size_t i = 1; i < ranks.size(); ++i)
+    Unpack(ranks[i - 1], ranks[i], path);
+
+  return best;
+}
+
+inline auto ContractionHierarchy::FindArc(std::size_t from, std::size_t to) const noexcept -> const Arc *
+{
+  // an arc is kept at its lower ranked end
+  const auto &offsets = to > from ? up_offsets_ : down_offsets_;
+  const auto &arcs = to > from ? up_ : down_;
+  std::size_t low = std::min(from, to), high = std::max(from, to);
+
+  for (std::size_t i = offsets[low]; i < offsets[low + 1]; ++i)
+    if (arcs[i].target_ == high)
+      return &arcs[i];
+
+  return nullptr;
+}
+
+inline void ContractionHierarchy::Unpack(std::size_t from, std::size_t to, std::vector<index_t> &path) const noexcept
+{
+  const Arc *arc = FindArc(from, to);
+  if (!arc || arc->middle_ == arc->target_) {
+    path.push_back(ids_[to]);
+    return;
+  }
+
+  Unpack(from, arc->middle_, path);
+  Unpack(arc->middle_, to, path);
+}
+
+inline void ContractionHierarchy::Clear() noexcept
+{
+  ids_.clear();
+  ranks_.clear();
+  up_offsets_.clear();
+  up_.clear();
+  down_offsets_.clear();
+  down_.clear();
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
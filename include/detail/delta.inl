@@ -0,0 +1,64 @@
+#include "../delta.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline bool DeltaArc::operator<(const DeltaArc &rhs) const noexcept
+{
+  if (in_list_ != rhs.in_list_)
+    return in_list_ < rhs.in_list_;
+  if (row_ != rhs.row_)
+    return row_ < rhs.row_;
+  if (column_ != rhs.column_)
+    return column_ < rhs.column_;
+  return sequence_ < rhs.sequence_;
+}
+
+template <typename Present>
+void MakeDeltaArcs(const std::vector<EdgeDelta> &delta, bool directed, Present&& present, std::vector<DeltaArc> &arcs)
+{
+  // look every distinct id up once instead of twice per change
+  std::vector<index_t> ids;
+  ids.reserve(2 * delta.size());
+  for (const EdgeDelta &change : delta)
+  {
+    ids.push_back(change.start_);
+    ids.push_back(change.destination_);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  std::vector<bool> known(ids.empty() ? 0 : static_cast<std::size_t>(ids.back()) + 1, false);
+  for (index_t id : ids)
+    known[id] = present(id);
+
+  arcs.clear();
+  arcs.reserve(2 * delta.size());
+  for (std::size_t sequence = 0; sequence < delta.size(); ++sequence)
+  {
+    const EdgeDelta &change = delta[sequence];
+    if (!known[change.start_] || !known[change.destination_])
+      continue;
+
+    auto seq = static_cast<std::uint32_t>(sequence);
+    arcs.push_back({change.start_, change.destination_, seq, change.operation_, change.weight_, false, true});
+    if (directed)
+      arcs.push_back({change.destination_, change.start_, seq, change.operation_, change.weight_, true, false});
+    else if (change.start_ != change.destination_)
+      arcs.push_back({change.destination_, change.start_, seq, change.operation_, change.weight_, false, false});
+  }
+
+  std::sort(arcs.begin(), arcs.end());
+}
+
+inline void GroupDeltaArcs(const std::vector<DeltaArc> &arcs, std::vector<std::size_t> &groups)
+{
+  groups.clear();
+  for (std::size_t arc = 0; arc < arcs.size(); ++arc)
+    if (arc == 0 || arcs[arc].row_ != arcs[arc - 1].row_ || arcs[arc].in_list_ != arcs[arc - 1].in_list_)
+      groups.push_back(arc);
+  groups.push_back(arcs.size());
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,408 @@
+#include "../generator.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+constexpr std::size_t kGeneratorMaxVertices = std::size_t{std::numeric_limits<index_t>::max()} + 1;
+constexpr std::size_t kGeneratorEdgeChunk = std::size_t{1} << 16;
+constexpr std::size_t kGeneratorRowChunk = 64;
+
+inline std::uint64_t SplitMix64::Mix(std::uint64_t x) noexcept
+{
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+inline std::uint64_t SplitMix64::Next() noexcept
+{
+  state_ += 0x9e3779b97f4a7c15ULL;
+  return Mix(state_);
+}
+
+inline std::uint64_t SplitMix64::Below(std::uint64_t bound) noexcept
+{
+  // reject the top partial range so every residue is equally likely
+  std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() - std::numeric_limits<std::uint64_t>::max() % bound;
+  std::uint64_t x = Next();
+  while (x >= limit)
+    x = Next();
+  return x % bound;
+}
+
+inline double SplitMix64::Real() noexcept
+{
+  return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+}
+
+inline bool ValidGeneratorOptions(const GeneratorOptions &options) noexcept
+{
+  return options.min_weight_ >= 0 && options.min_weight_ <= options.max_weight_;
+}
+
+template <bool Weighted>
+Edge<Weighted> MakeGeneratedEdge(std::size_t start, std::size_t dest, SplitMix64 &random, const GeneratorOptions &options) noexcept
+{
+  WEIGHTED_GRAPH {
+    auto span = static_cast<std::uint64_t>(options.max_weight_ - options.min_weight_) + 1;
+    auto weight = static_cast<weight_t>(options.min_weight_ + static_cast<weight_t>(random.Below(span)));
+    return Edge<true>(static_cast<index_t>(start), static_cast<index_t>(dest), weight);
+  } ELSE {
+    return Edge<false>(static_cast<index_t>(start), static_cast<index_t>(dest));
+  }
+}
+
+// Appends the per-chunk results in chunk order, copying the chunks in parallel.
+template <bool Weighted>
+void ConcatenateParts(const std::vector<std::vector<Edge<Weighted>>> &parts,
+                      std::vector<Edge<Weighted>> &res,
+                      unsigned threads) noexcept
+{
+  std::vector<std::size_t> offsets(parts.size() + 1, res.size());
+  for (std::size_t i = 0; i < parts.size(); ++i)
+    offsets[i + 1] = offsets[i] + parts[i].size();
+
+  res.resize(offsets.back());
+  ParallelFor(0, parts.size(), threads, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i)
+      std::copy(parts[i].begin(), parts[i].end(), res.begin() + static_cast<std::ptrdiff_t>(offsets[i]));
+  });
+}
+
+template <bool Weighted>
+bool GenerateRMat(std::size_t scale,
+                  std::size_t edges,
+                  std::vector<Edge<Weighted>> &res,
+                  const GeneratorOptions &options,
+                  RMatProbabilities probabilities,
+                  bool append) noexcept
+{
+  const auto [a, b, c] = probabilities;
+  if (scale == 0 || scale > static_cast<std::size_t>(std::numeric_limits<index_t>::digits) || !ValidGeneratorOptions(options) ||
+      a < 0 || b < 0 || c < 0 || a + b + c > 1)
+    return false;
+
+  if (!append)
+    res.clear();
+
+  std::size_t base = res.size();
+  res.resize(base + edges);
+
+  // a 64 bit draw decides three levels, 21 bits each compared against fixed point thresholds
+  constexpr unsigned kLevelBits = 21;
+  constexpr std::uint64_t kLevelMask = (std::uint64_t{1} << kLevelBits) - 1;
+  auto threshold = [](double p) { return static_cast<std::uint64_t>(p * static_cast<double>(kLevelMask + 1)); };
+  const std::uint64_t ta = threshold(a), tab = threshold(a + b), tabc = threshold(a + b + c);
+
+  std::size_t chunks = (edges + kGeneratorEdgeChunk - 1) / kGeneratorEdgeChunk;
+  ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+    {
+      SplitMix64 random(options.seed_, chunk);
+      std::size_t end = std::min(edges, (chunk + 1) * kGeneratorEdgeChunk);
+      for (std::size_t i = chunk * kGeneratorEdgeChunk; i < end; ++i)
+      {
+        // descend one quadrant per bit of the ids: a = (0, 0), b = (0, 1), c = (1, 0), d = (1, 1)
+        std::size_t start = 0, dest = 0;
+        std::uint64_t bits = 0;
+        for (std::size_t level = 0; level < scale; ++level)
+        {
+          if (level % 3 == 0)
+            bits = random.Next();
+
+          std::uint64_t r = bits & kLevelMask;
+          bits >>= kLevelBits;
+          // branch free, the quadrants are equally unpredictable
+          start = start << 1 | static_cast<std::size_t>(r >= tab);
+          dest = dest << 1 | static_cast<std::size_t>((r >= ta) ^ (r >= tab) ^ (r >= tabc));
+        }
+        res[base + i] = MakeGeneratedEdge<Weighted>(start, dest, random, options);
+      }
+    }
+  });
+
+  return true;
+}
+
+template <bool Weighted>
+bool GenerateGnp(std::size_t vertices,
+                 double probability,
+                 std::vector<Edge<Weighted>> &res,
+                 const GeneratorOptions &options,
+                 bool append) noexcept
+{
+  if (vertices > kGeneratorMaxVertices || !(probability >= 0 && probability <= 1) || !ValidGeneratorOptions(options))
+    return false;
+
+  if (!append)
+    res.clear();
+  if (vertices < 2 || probability == 0)
+    return true;
+
+  const bool directed = options.directed_;
+  const double log_q = std::log1p(-probability);
+  std::size_t chunks = (vertices + kGeneratorRowChunk - 1) / kGeneratorRowChunk;
+  std::vector<std::vector<Edge<Weighted>>> parts(chunks);
+
+  ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+    {
+      SplitMix64 random(options.seed_, chunk);
+      auto &part = parts[chunk];
+      std::size_t end = std::min(vertices, (chunk + 1) * kGeneratorRowChunk);
+      for (std::size_t u = chunk * kGeneratorRowChunk; u < end; ++u)
+      {
+        // candidates of row u: every other vertex when directed, the higher ids otherwise
+        std::size_t count = directed ? vertices - 1 : vertices - 1 - u;
+
+        // number of non-edges before the next edge, geometric with parameter p
+        auto skip = [&]() -> std::size_t {
+          if (probability == 1)
+            return 0;
+          double gap = std::log(1 - random.Real()) / log_q;
+          return gap < static_cast<double>(count) ? static_cast<std::size_t>(gap) : count;
+        };
+
+        for (std::size_t k = skip(); k < count; k += 1 + skip())
+        {
+          std::size_t v = directed ? (k < u ? k : k + 1) : u + 1 + k;
+          part.push_back(MakeGeneratedEdge<Weighted>(u, v, random, options));
+        }
+      }
+    }
+  });
+
+  ConcatenateParts(parts, res, options.threads_);
+  return true;
+}
+
+template <bool Weighted>
+bool GenerateGnm(std::size_t vertices,
+                 std::size_t edges,
+                 std::vector<Edge<Weighted>> &res,
+                 const GeneratorOptions &options,
+                 bool append) noexcept
+{
+  if (vertices > kGeneratorMaxVertices || !ValidGeneratorOptions(options))
+    return false;
+
+  const bool directed = options.directed_;
+  const std::uint64_t n = vertices;
+  const std::uint64_t total = n < 2 ? 0 : (directed ? n * (n - 1) : n * (n - 1) / 2);
+  if (edges > total)
+    return false;
+
+  if (!append)
+    res.clear();
+  if (edges == 0)
+    return true;
+
+  // pairs are numbered row by row; row u holds n - 1 (directed) or n - 1 - u candidates
+  auto row_begin = [&](std::uint64_t u) -> std::uint64_t {
+    return directed ? u * (n - 1) : u * (n - 1) - u * (u - 1) / 2;
+  };
+
+  // above half of the pairs it is cheaper to draw the pairs left out
+  const bool complement = edges > total / 2;
+  const std::uint64_t target = complement ? total - edges : edges;
+
+  std::size_t chunks = (vertices + kGeneratorRowChunk - 1) / kGeneratorRowChunk;
+  std::vector<std::uint64_t> chunk_begin(chunks + 1, total);
+  for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    chunk_begin[chunk] = row_begin(chunk * kGeneratorRowChunk);
+
+  /*  Positions are drawn with replacement and deduplicated per row chunk. The shortfall is
+   *  drawn again until `target` positions are distinct; the process treats every position
+   *  alike, so the final set is a uniform sample without replacement.
+   */
+  std::vector<std::vector<std::uint64_t>> buckets(chunks);
+  std::uint64_t missing = target;
+  for (std::uint64_t round = 0; missing > 0; ++round)
+  {
+    std::vector<std::uint64_t> drawn(missing);
+    std::uint64_t round_seed = SplitMix64::Mix(options.seed_ + round);
+    std::size_t draw_chunks = (missing + kGeneratorEdgeChunk - 1) / kGeneratorEdgeChunk;
+    ParallelFor(0, draw_chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+      for (std::size_t chunk = first; chunk < last; ++chunk)
+      {
+        SplitMix64 random(round_seed, chunk);
+        std::size_t end = std::min<std::size_t>(missing, (chunk + 1) * kGeneratorEdgeChunk);
+        for (std::size_t i = chunk * kGeneratorEdgeChunk; i < end; ++i)
+          drawn[i] = random.Below(total);
+      }
+    });
+
+    std::vector<std::size_t> sorted(chunks);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+      sorted[chunk] = buckets[chunk].size();
+    for (std::uint64_t position : drawn)
+    {
+      auto chunk = std::upper_bound(chunk_begin.begin(), chunk_begin.end(), position) - chunk_begin.begin() - 1;
+      buckets[static_cast<std::size_t>(chunk)].push_back(position);
+    }
+
+    ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+      for (std::size_t chunk = first; chunk < last; ++chunk)
+      {
+        auto &bucket = buckets[chunk];
+        auto middle = bucket.begin() + static_cast<std::ptrdiff_t>(sorted[chunk]);
+        std::sort(middle, bucket.end());
+        std::inplace_merge(bucket.begin(), middle, bucket.end());
+        bucket.erase(std::unique(bucket.begin(), bucket.end()), bucket.end());
+      }
+    });
+
+    std::uint64_t distinct = 0;
+    for (auto &bucket : buckets)
+      distinct += bucket.size();
+    missing = target - distinct;
+  }
+
+  std::vector<std::vector<Edge<Weighted>>> parts(chunks);
+  ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+    {
+      SplitMix64 random(SplitMix64::Mix(~options.seed_), chunk);
+      auto &part = parts[chunk];
+      const auto &bucket = buckets[chunk];
+      std::size_t u = chunk * kGeneratorRowChunk;
+      std::size_t end = std::min(vertices, (chunk + 1) * kGeneratorRowChunk);
+      auto emit = [&](std::size_t row, std::uint64_t k) {
+        std::size_t v = static_cast<std::size_t>(directed ? (k < row ? k : k + 1) : row + 1 + k);
+        part.push_back(MakeGeneratedEdge<Weighted>(row, v, random, options));
+      };
+
+      if (!complement) {
+        for (std::uint64_t position : bucket)
+        {
+          while (position >= row_begin(u + 1))
+            ++u;
+          emit(u, position - row_begin(u));
+        }
+      } else {
+        auto next = bucket.begin();
+        for (; u < end; ++u)
+          for (std::uint64_t position = row_begin(u); position < row_begin(u + 1); ++position)
+          {
+            if (next != bucket.end() && *next == position)
+              ++next;
+            else
+              emit(u, position - row_begin(u));
+          }
+      }
+    }
+  });
+
+  ConcatenateParts(parts, res, options.threads_);
+  return true;
+}
+
+template <bool Weighted>
+bool GenerateGrid(std::size_t rows,
+                  std::size_t columns,
+                  std::vector<Edge<Weighted>> &res,
+                  const GeneratorOptions &options,
+                  double keep,
+                  bool append) noexcept
+{
+  if (rows == 0 || columns == 0 || rows > kGeneratorMaxVertices / columns ||
+      !(keep >= 0 && keep <= 1) || !ValidGeneratorOptions(options))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  std::size_t chunks = (rows + kGeneratorRowChunk - 1) / kGeneratorRowChunk;
+  std::vector<std::vector<Edge<Weighted>>> parts(chunks);
+
+  ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+    {
+      SplitMix64 random(options.seed_, chunk);
+      auto &part = parts[chunk];
+      auto link = [&](std::size_t start, std::size_t dest) {
+        if (keep < 1 && random.Real() >= keep)
+          return;
+
+        auto edge = MakeGeneratedEdge<Weighted>(start, dest, random, options);
+        part.push_back(edge);
+        if (options.directed_) {
+          std::swap(edge.start_, edge.destination_);
+          part.push_back(edge);
+        }
+      };
+
+      std::size_t end = std::min(rows, (chunk + 1) * kGeneratorRowChunk);
+      for (std::size_t r = chunk * kGeneratorRowChunk; r < end; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+        {
+          std::size_t id = r * columns + c;
+          if (c + 1 < columns)
+            link(id, id + 1);
+          if (r + 1 < rows)
+            link(id, id + columns);
+        }
+    }
+  });
+
+  ConcatenateParts(parts, res, options.threads_);
+  return true;
+}
+
+template <bool Weighted>
+bool GenerateBarabasiAlbert(std::size_t vertices,
+                            std::size_t degree,
+                            std::vector<Edge<Weighted>> &res,
+                            const GeneratorOptions &options,
+                            bool append) noexcept
+{
+  if (vertices == 0 || vertices > kGeneratorMaxVertices || degree == 0 || !ValidGeneratorOptions(options))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  /*  Edge slot i belongs to vertex i / degree. Its target is a uniform pick among the endpoints
+   *  of all slots of earlier vertices, which is degree-proportional: endpoint 2j is the source
+   *  of slot j, endpoint 2j + 1 its target, resolved the same way. Picks are hashes of the slot,
+   *  so each slot is resolved independently of the others. Slots of vertex 0 point to itself
+   *  and are not emitted.
+   */
+  const std::uint64_t key = SplitMix64::Mix(options.seed_);
+  auto target_of = [&](std::uint64_t slot) -> std::size_t {
+    while (true)
+    {
+      std::uint64_t v = slot / degree;
+      if (v == 0)
+        return 0;
+
+      std::uint64_t endpoint = SplitMix64::Mix(key ^ SplitMix64::Mix(slot)) % (2 * v * degree);
+      if (endpoint % 2 == 0)
+        return static_cast<std::size_t>(endpoint / 2 / degree);
+      slot = endpoint / 2;
+    }
+  };
+
+  std::size_t slots = (vertices - 1) * degree;
+  std::size_t base = res.size();
+  res.resize(base + slots);
+
+  std::size_t chunks = (slots + kGeneratorEdgeChunk - 1) / kGeneratorEdgeChunk;
+  ParallelFor(0, chunks, options.threads_, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+    {
+      SplitMix64 random(options.seed_, chunk);
+      std::size_t end = std::min(slots, (chunk + 1) * kGeneratorEdgeChunk);
+      for (std::size_t i = chunk * kGeneratorEdgeChunk; i < end; ++i)
+      {
+        std::size_t slot = i + degree;
+        res[base + i] = MakeGeneratedEdge<Weighted>(slot / degree, target_of(slot), random, options);
+      }
+    }
+  });
+
+  return true;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -1,164 +1,241 @@
-#include "../graph.hpp"
-
-namespace smart_graph {
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-         size_t Size >
-template <typename... Container>
-Graph<Ty,Weighted,Directed,Matrix,Size>::Graph(Container&&... containers)
-{
-  static_assert(std::is_same_v<Ty, index_t>, "Only plainGraph can initialize in this way");
-  Initializer(std::forward<Container>(containers)...);
-}
-
-template<typename Ty,
-         bool Weighted,
-         bool Directed,
-         bool Matrix,
-         size_t Size>
-Graph<Ty,Weighted,Directed,Matrix,Size>::Graph(const Graph& rhs):Base(rhs)
-{
-	
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size >
-std::string Graph<Ty,Weighted,Directed,Matrix,Size>::DebugInfo()
-{
-  std::string info("Graph\tWeighted[");
-
-  WEIGHTED_GRAPH
-    info.append("True]");
-  ELSE
-    info.append("False]");
-
-    info.append("\tDirected[");
-  DIRECTED_GRAPH
-    info.append("True]");
-  ELSE
-    info.append("False]");
-
-  info.append("\tContainer[");
-  if constexpr (Matrix)
-    info.append("Adjacent Matrix]\tSize[" + std::to_string(Size) + "]\n");
-  else
-    info.append("Adjacent List]\n");
-
-  return info;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size
->
-decltype(auto) Graph<Ty,Weighted,Directed,Matrix,Size>::GetEdgeType() const noexcept
-{
-  return edge_t();
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size
->
-template <typename HeadContainer, typename... Rest>
-void Graph<Ty,Weighted,Directed,Matrix,Size>::Initializer(HeadContainer&& container, Rest&&... rest) noexcept
-{
-  for (auto &iter : container)
-  {
-    if (!this->HasVertex(iter.start_))
-      this->RegisterVertex(iter.start_, iter.start_);
-
-    if (!this->HasVertex(iter.destination_))
-      this->RegisterVertex(iter.destination_, iter.destination_);
-
-    this->InsertEdge(iter);
-  }
-
-  if constexpr (sizeof...(rest) > 0)
-    this->Initializer(std::forward<Rest>(rest)...);
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size,
-          typename... Containers>
-decltype(auto) MakePlaingraph(const Graph<Ty, Weighted, Directed, Matrix, Size>& graph, Containers&&... containers)
-{
-  return PlainGraph<Weighted, Directed, Matrix, Size>(std::forward<Containers>(containers)...);
-}
-
-template <typename Graph,
-          typename... Vertices>
-decltype(auto) MakeSubgraph(Graph&& source, Vertices&&... index)
-{
-  std::remove_reference_t<Graph> result;
-
-  index_t arr[] = {
-    (static_cast<index_t>(index))...};
-
-  std::vector<decltype(source.GetEdgeType())> tmp;
-
-  for (auto iter : arr)
-    if (source.HasVertex(iter))
-      result.RegisterVertex(iter, source.At(iter).value());
-
-  for (auto iter : arr)
-  {
-    if (!result.HasVertex(iter))
-      continue;
-
-    source.GetEdge(iter, tmp);
-    for (auto &edge : tmp)
-      result.InsertEdge(edge);
-  }
-
-  return result;
-}
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size,
-          typename... Vertices>
-decltype(auto) MakePlainSubgraph(Graph<Ty, Weighted, Directed, Matrix, Size>& graph, Vertices &&... index)
-{
-  //plainGraph<_Weighted,_Directed,_Matrix,_Size>
-  PlainGraph<Weighted, Directed, Matrix, Size> result;
-
-  index_t arr[] = {
-    (static_cast<index_t>(index))...};
-
-  std::vector<decltype(graph.GetEdgeType())> tmp;
-
-  for (auto iter : arr)
-    if (graph.HasVertex(iter))
-      result.RegisterVertex(iter, iter);
-
-  for (auto iter : arr)
-  {
-    if (!result.HasVertex(iter))
-      continue;
-
-    graph.GetEdgeOut(iter, tmp);
-    for (auto &edge : tmp)
-      result.InsertEdge(edge);
-  }
-
-  return result;
-}
-
-
-}  // namespace smart_graph
+#include "../graph.hpp"
+
+namespace smart_graph {
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+         size_t Size,
+         typename Storage >
+template <typename... Container>
+Graph<Ty,Weighted,Directed,Matrix,Size,Storage>::Graph(Container&&... containers)
+{
+  static_assert(std::is_same_v<Ty, index_t>, "Only plainGraph can initialize in this way");
+  Initializer(std::forward<Container>(containers)...);
+}
+
+template<typename Ty,
+         bool Weighted,
+         bool Directed,
+         bool Matrix,
+         size_t Size,
+         typename Storage>
+Graph<Ty,Weighted,Directed,Matrix,Size,Storage>::Graph(const Graph& rhs):Base(rhs)
+{
+	
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage >
+std::string Graph<Ty,Weighted,Directed,Matrix,Size,Storage>::DebugInfo()
+{
+  std::string info("Graph\tWeighted[");
+
+  WEIGHTED_GRAPH
+    info.append("True]");
+  ELSE
+    info.append("False]");
+
+    info.append("\tDirected[");
+  DIRECTED_GRAPH
+    info.append("True]");
+  ELSE
+    info.append("False]");
+
+  info.append("\tContainer[");
+  if constexpr (std::is_same_v<Storage, smart_graph_impl::AdjacentMatrixTag>)
+    info.append("Adjacent Matrix]\tSize[" + std::to_string(Size) + "]\n");
+  else if constexpr (std::is_same_v<Storage, smart_graph_impl::AdjacentHybridTag>)
+    info.append("Adjacent Hybrid]\n");
+  else
+    info.append("Adjacent List]\n");
+
+  return info;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage
+>
+decltype(auto) Graph<Ty,Weighted,Directed,Matrix,Size,Storage>::GetEdgeType() const noexcept
+{
+  return edge_t();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage
+>
+template <typename HeadContainer, typename... Rest>
+void Graph<Ty,Weighted,Directed,Matrix,Size,Storage>::Initializer(HeadContainer&& container, Rest&&... rest) noexcept
+{
+  for (auto &iter : container)
+  {
+    if (!this->HasVertex(iter.start_))
+      this->RegisterVertex(iter.start_, iter.start_);
+
+    if (!this->HasVertex(iter.destination_))
+      this->RegisterVertex(iter.destination_, iter.destination_);
+
+    this->InsertEdge(iter);
+  }
+
+  if constexpr (sizeof...(rest) > 0)
+    this->Initializer(std::forward<Rest>(rest)...);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename... Containers>
+decltype(auto) MakePlaingraph(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, Containers&&... containers)
+{
+  return PlainGraph<Weighted, Directed, Matrix, Size, Storage>(std::forward<Containers>(containers)...);
+}
+
+template <typename Graph,
+          typename... Vertices>
+decltype(auto) MakeSubgraph(Graph&& source, Vertices&&... index)
+{
+  // a pack names a handful of vertices, too few to share between threads
+  return MakeInducedSubgraph(source, std::vector<index_t>{static_cast<index_t>(index)...}, 1);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename... Vertices>
+decltype(auto) MakePlainSubgraph(Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, Vertices &&... index)
+{
+  PlainGraph<Weighted, Directed, Matrix, Size, Storage> result;
+
+  SubgraphView view(graph, std::vector<index_t>{static_cast<index_t>(index)...});
+  smart_graph_impl::CopySubgraph<Directed>(view, result, [](auto &target, index_t id) {
+    target.RegisterVertex(id, id);
+  }, 1);
+  return result;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename Vertices>
+decltype(auto) MakeInducedSubgraph(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, const Vertices &vertices, unsigned threads)
+{
+  Graph<Ty, Weighted, Directed, Matrix, Size, Storage> result;
+
+  SubgraphView view(graph, vertices);
+  smart_graph_impl::CopySubgraph<Directed>(view, result, [&graph](auto &target, index_t id) {
+    target.RegisterVertex(id, graph.At(id).value());
+  }, threads);
+  return result;
+}
+
+template <typename Container,
+          typename Vertices>
+decltype(auto) MakeSubgraphView(const Container& graph, const Vertices &vertices)
+{
+  return SubgraphView<Container>(graph, vertices);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeTranspose(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, unsigned threads)
+{
+  if constexpr (!Directed || std::is_same_v<Storage, smart_graph_impl::AdjacentMatrixTag>) {
+    Graph<Ty, Weighted, Directed, Matrix, Size, Storage> result(graph);
+    DIRECTED_GRAPH
+      result.Transpose();
+    return result;
+  } else {
+    Graph<Ty, Weighted, Directed, Matrix, Size, Storage> result;
+
+    TransposeView view(graph);
+    smart_graph_impl::CopySubgraph<Directed>(view, result, [&graph](auto &target, index_t id) {
+      target.RegisterVertex(id, graph.At(id).value());
+    }, threads);
+    return result;
+  }
+}
+
+template <typename Container>
+decltype(auto) MakeTransposeView(const Container& graph)
+{
+  return TransposeView<Container>(graph);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeRelabeled(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                             const VertexPermutation &permutation,
+                             unsigned threads)
+{
+  Graph<Ty, Weighted, Directed, Matrix, Size, Storage> result;
+
+  RelabeledView view(graph, permutation);
+  smart_graph_impl::CopySubgraph<Directed>(view, result, [&view](auto &target, index_t id) {
+    target.RegisterVertex(id, view.At(id).value());
+  }, threads);
+  return result;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeReordered(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                             VertexOrder order,
+                             VertexPermutation &permutation,
+                             unsigned threads)
+{
+  OrderVertices(graph, order, permutation);
+  return MakeRelabeled(graph, permutation, threads);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeSharded(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                           unsigned parts,
+                           const PartitionOptions &options,
+                           unsigned threads)
+{
+  VertexPartition partition;
+  PartitionGraph(graph, parts, partition, options);
+  return ShardedGraph<Graph<Ty, Weighted, Directed, Matrix, Size, Storage>>(graph, partition, threads);
+}
+
+}  // namespace smart_graph
@@ -0,0 +1,207 @@
+#include "../instrumentation.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline const char *OperationName(GraphOperation operation) noexcept
+{
+  switch (operation)
+  {
+  case GraphOperation::REGISTER_VERTEX: return "RegisterVertex";
+  case GraphOperation::ERASE_VERTEX:    return "EraseVertex";
+  case GraphOperation::INSERT_EDGE:     return "InsertEdge";
+  case GraphOperation::ERASE_EDGE:      return "EraseEdge";
+  case GraphOperation::HAS_EDGE:        return "HasEdge";
+  case GraphOperation::WEIGHT_OF_EDGE:  return "WeightOfEdge";
+  case GraphOperation::GET_EDGE_OUT:    return "GetEdgeOut";
+  case GraphOperation::GET_EDGE_IN:     return "GetEdgeIn";
+  case GraphOperation::DEGREE:          return "Degree";
+  case GraphOperation::EDGE_SIZE:       return "EdgeSize";
+  default:                              return "Unknown";
+  }
+}
+
+inline std::size_t LatencyHistogram::BucketOf(std::uint64_t nanoseconds) noexcept
+{
+  constexpr std::uint64_t kLinear = std::uint64_t{1} << kSubBucketBits;
+  if (nanoseconds < kLinear)
+    return static_cast<std::size_t>(nanoseconds);
+
+  unsigned exponent = 63;
+  while (!(nanoseconds >> exponent))
+    --exponent;
+
+  // the bits right below the leading one pick the sub-bucket
+  std::uint64_t sub = (nanoseconds >> (exponent - kSubBucketBits)) & (kLinear - 1);
+  return static_cast<std::size_t>(((exponent - kSubBucketBits + 1) << kSubBucketBits) + sub);
+}
+
+inline std::uint64_t LatencyHistogram::UpperBoundOf(std::size_t bucket) noexcept
+{
+  constexpr std::uint64_t kLinear = std::uint64_t{1} << kSubBucketBits;
+  if (bucket < kLinear)
+    return bucket;
+
+  unsigned exponent = static_cast<unsigned>(bucket >> kSubBucketBits) + kSubBucketBits - 1;
+  std::uint64_t sub = bucket & (kLinear - 1);
+  std::uint64_t width = std::uint64_t{1} << (exponent - kSubBucketBits);
+  return (std::uint64_t{1} << exponent) + (sub + 1) * width - 1;
+}
+
+inline std::uint64_t LatencyHistogram::Count() const noexcept
+{
+  std::uint64_t total = 0;
+  for (auto count : counts_)
+    total += count;
+  return total;
+}
+
+inline std::uint64_t LatencyHistogram::Quantile(double q) const noexcept
+{
+  std::uint64_t total = Count();
+  if (total == 0)
+    return 0;
+
+  auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+  if (rank >= total)
+    rank = total - 1;
+
+  std::uint64_t seen = 0;
+  for (std::size_t bucket = 0; bucket < kBuckets; ++bucket)
+  {
+    seen += counts_[bucket];
+    if (seen > rank)
+      return UpperBoundOf(bucket);
+  }
+  return UpperBoundOf(kBuckets - 1);
+}
+
+inline CountingInstrumentation::Scope::Scope(GraphOperation operation, bool active) noexcept:
+    operation_(operation), active_(active)
+{
+  if (active_)
+    start_ = std::chrono::steady_clock::now();
+}
+
+inline CountingInstrumentation::Scope::~Scope()
+{
+  if (!active_)
+    return;
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+  auto nanoseconds = static_cast<std::uint64_t>(elapsed.count());
+  auto index = static_cast<std::size_t>(operation_);
+
+  Slot &slot = Local();
+  Add(slot.calls_[index], 1);
+  Add(slot.total_nanoseconds_[index], nanoseconds);
+  Add(slot.latency_[index][LatencyHistogram::BucketOf(nanoseconds)], 1);
+}
+
+inline void CountingInstrumentation::CountHops(std::size_t hops) noexcept
+{
+  Add(Local().fetch_hops_, hops);
+}
+
+inline void CountingInstrumentation::CountLookups(std::size_t lookups) noexcept
+{
+  Add(Local().map_lookups_, lookups);
+}
+
+inline void CountingInstrumentation::CountAllocation(std::size_t bytes) noexcept
+{
+  Slot &slot = Local();
+  Add(slot.allocations_, 1);
+  Add(slot.allocated_bytes_, bytes);
+}
+
+inline InstrumentationSnapshot CountingInstrumentation::Snapshot() noexcept
+{
+  InstrumentationSnapshot snapshot;
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex_);
+
+  for (auto &slot : registry.slots_)
+  {
+    for (std::size_t op = 0; op < kOperationCount; ++op)
+    {
+      OperationStats &stats = snapshot.operations_[op];
+      stats.calls_ += slot->calls_[op].load(std::memory_order_relaxed);
+      stats.total_nanoseconds_ += slot->total_nanoseconds_[op].load(std::memory_order_relaxed);
+      for (std::size_t bucket = 0; bucket < LatencyHistogram::kBuckets; ++bucket)
+        stats.latency_.counts_[bucket] += slot->latency_[op][bucket].load(std::memory_order_relaxed);
+    }
+    snapshot.fetch_hops_ += slot->fetch_hops_.load(std::memory_order_relaxed);
+    snapshot.map_lookups_ += slot->map_lookups_.load(std::memory_order_relaxed);
+    snapshot.allocations_ += slot->allocations_.load(std::memory_order_relaxed);
+    snapshot.allocated_bytes_ += slot->allocated_bytes_.load(std::memory_order_relaxed);
+  }
+
+  return snapshot;
+}
+
+inline void CountingInstrumentation::Reset() noexcept
+{
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex_);
+
+  for (auto &slot : registry.slots_)
+  {
+    for (std::size_t op = 0; op < kOperationCount; ++op)
+    {
+      slot->calls_[op].store(0, std::memory_order_relaxed);
+      slot->total_nanoseconds_[op].store(0, std::memory_order_relaxed);
+      for (auto &bucket : slot->latency_[op])
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    slot->fetch_hops_.store(0, std::memory_order_relaxed);
+    slot->map_lookups_.store(0, std::memory_order_relaxed);
+    slot->allocations_.store(0, std::memory_order_relaxed);
+    slot->allocated_bytes_.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline CountingInstrumentation::Registry &CountingInstrumentation::GetRegistry() noexcept
+{
+  static Registry registry;
+  return registry;
+}
+
+inline CountingInstrumentation::Slot &CountingInstrumentation::Local() noexcept
+{
+  struct Owner
+  {
+    Slot *slot_;
+
+    Owner()
+    {
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex_);
+      if (!registry.free_.empty()) {
+        slot_ = registry.free_.back();
+        registry.free_.pop_back();
+      } else {
+        registry.slots_.push_back(std::make_unique<Slot>());
+        slot_ = registry.slots_.back().get();
+      }
+    }
+
+    ~Owner()
+    {
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex_);
+      registry.free_.push_back(slot_);
+    }
+  };
+
+  static thread_local Owner owner;
+  return *owner.slot_;
+}
+
+inline void CountingInstrumentation::Add(Counter &counter, std::uint64_t value) noexcept
+{
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
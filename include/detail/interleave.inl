@@ -0,0 +1,64 @@
+#include "../interleave.hpp"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline void Prefetch(const void *address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+  _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+  (void)address;
+#endif
+}
+
+template <typename State, typename Start, typename Step>
+void RunInterleaved(std::size_t count, std::size_t width, Start&& start, Step&& step) noexcept
+{
+  if (count == 0)
+    return;
+
+  if (width == 0)
+    width = 1;
+
+  std::vector<State> slots(width < count ? width : count);
+  std::vector<bool> active(slots.size());
+  std::size_t next = 0, running = 0;
+
+  // start queries on a slot until one has to wait for memory
+  auto launch = [&](State &slot) {
+    while (next < count)
+      if (const void *address = start(slot, next++)) {
+        Prefetch(address);
+        return true;
+      }
+    return false;
+  };
+
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    active[i] = launch(slots[i]);
+    running += active[i];
+  }
+
+  while (running)
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+      if (!active[i])
+        continue;
+
+      if (const void *address = step(slots[i]))
+        Prefetch(address);
+      else if (!(active[i] = launch(slots[i])))
+        --running;
+    }
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
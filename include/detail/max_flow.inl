@@ -0,0 +1,315 @@
+#include "../max_flow.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <bool Weighted>
+SparseResidual::SparseResidual(const CompactAdjacency<Weighted> &adjacency)
+{
+  std::size_t n = adjacency.VerticesSize();
+
+  offsets_.assign(n + 1, 0);
+  for (std::size_t u = 0; u < n; ++u)
+    for (std::size_t arc = adjacency.ArcBegin(u); arc < adjacency.ArcBegin(u) + adjacency.Degree(u); ++arc)
+      if (adjacency.Target(arc) != u && adjacency.Weight(arc) > 0) {
+        ++offsets_[u + 1];
+        ++offsets_[static_cast<std::size_t>(adjacency.Target(arc)) + 1];
+      }
+  for (std::size_t v = 0; v < n; ++v)
+    offsets_[v + 1] += offsets_[v];
+
+  std::vector<std::size_t> cursor(offsets_.begin(), offsets_.end() - 1);
+  arcs_.resize(offsets_.back());
+  for (std::size_t u = 0; u < n; ++u)
+    for (std::size_t arc = adjacency.ArcBegin(u); arc < adjacency.ArcBegin(u) + adjacency.Degree(u); ++arc)
+    {
+      std::size_t v = adjacency.Target(arc);
+      if (v == u || adjacency.Weight(arc) <= 0)
+        continue;
+
+      std::size_t forward = cursor[u]++;
+      std::size_t backward = cursor[v]++;
+      arcs_[forward] = Arc{adjacency.Weight(arc), backward, static_cast<index_t>(v)};
+      arcs_[backward] = Arc{0, forward, static_cast<index_t>(u)};
+    }
+}
+
+inline std::size_t SparseResidual::VerticesSize() const noexcept
+{
+  return offsets_.size() - 1;
+}
+
+inline std::size_t SparseResidual::ArcSize() const noexcept
+{
+  return arcs_.size();
+}
+
+inline std::size_t SparseResidual::Begin(std::size_t v) const noexcept
+{
+  return offsets_[v];
+}
+
+inline std::size_t SparseResidual::End(std::size_t v) const noexcept
+{
+  return offsets_[v + 1];
+}
+
+inline std::size_t SparseResidual::Head(std::size_t, std::size_t arc) const noexcept
+{
+  return arcs_[arc].head_;
+}
+
+inline distance_t SparseResidual::Residual(std::size_t, std::size_t arc) const noexcept
+{
+  return arcs_[arc].residual_;
+}
+
+inline distance_t SparseResidual::ReverseResidual(std::size_t, std::size_t arc) const noexcept
+{
+  return arcs_[arcs_[arc].reverse_].residual_;
+}
+
+inline void SparseResidual::Push(std::size_t, std::size_t arc, distance_t amount) noexcept
+{
+  arcs_[arc].residual_ -= amount;
+  arcs_[arcs_[arc].reverse_].residual_ += amount;
+}
+
+template <size_t Size>
+template <typename Matrix>
+DenseResidual<Size>::DenseResidual(const Matrix &matrix): residual_(static_cast<std::size_t>(Size) * Size, 0)
+{
+  for (std::size_t u = 0; u < Size; ++u)
+    for (std::size_t v = 0; v < Size; ++v)
+    {
+      if (u == v)
+        continue;
+
+      if constexpr (std::is_same_v<std::decay_t<decltype(matrix[0][0])>, weight_t>) {
+        if (WEIGHT_CHECK(matrix[u][v]))
+          residual_[u * Size + v] = matrix[u][v];
+      } else {
+        residual_[u * Size + v] = matrix[u][v] ? kConnected : 0;
+      }
+    }
+}
+
+template <size_t Size>
+std::size_t DenseResidual<Size>::VerticesSize() const noexcept
+{
+  return Size;
+}
+
+template <size_t Size>
+std::size_t DenseResidual<Size>::ArcSize() const noexcept
+{
+  return residual_.size();
+}
+
+template <size_t Size>
+std::size_t DenseResidual<Size>::Begin(std::size_t) const noexcept
+{
+  return 0;
+}
+
+template <size_t Size>
+std::size_t DenseResidual<Size>::End(std::size_t) const noexcept
+{
+  return Size;
+}
+
+template <size_t Size>
+std::size_t DenseResidual<Size>::Head(std::size_t, std::size_t arc) const noexcept
+{
+  return arc;
+}
+
+template <size_t Size>
+distance_t DenseResidual<Size>::Residual(std::size_t v, std::size_t arc) const noexcept
+{
+  return residual_[v * Size + arc];
+}
+
+template <size_t Size>
+distance_t DenseResidual<Size>::ReverseResidual(std::size_t v, std::size_t arc) const noexcept
+{
+  return residual_[arc * Size + v];
+}
+
+template <size_t Size>
+void DenseResidual<Size>::Push(std::size_t v, std::size_t arc, distance_t amount) noexcept
+{
+  residual_[v * Size + arc] -= static_cast<int32_t>(amount);
+  residual_[arc * Size + v] += static_cast<int32_t>(amount);
+}
+
+template <typename Network>
+PushRelabel<Network>::PushRelabel(Network &network):
+    network_(network), n_(network.VerticesSize()), source_(0), sink_(0), highest_(0), work_(0),
+    height_(n_, 0), current_(n_, 0), count_(n_ + 1, 0), excess_(n_, 0), active_(n_)
+{
+
+}
+
+template <typename Network>
+distance_t PushRelabel<Network>::Run(std::size_t source, std::size_t sink) noexcept
+{
+  source_ = source;
+  sink_ = sink;
+  if (source == sink || source >= n_ || sink >= n_)
+    return 0;
+
+  GlobalRelabel();
+
+  for (std::size_t arc = network_.Begin(source_); arc < network_.End(source_); ++arc)
+  {
+    distance_t amount = network_.Residual(source_, arc);
+    if (amount <= 0)
+      continue;
+
+    std::size_t w = network_.Head(source_, arc);
+    network_.Push(source_, arc, amount);
+    excess_[source_] -= amount;
+    if (excess_[w] == 0)
+      Activate(w);
+    excess_[w] += amount;
+  }
+
+  std::size_t threshold = 6 * n_ + network_.ArcSize() / 2;
+  while (true)
+  {
+    if (work_ > threshold) {
+      GlobalRelabel();
+      work_ = 0;
+    }
+
+    while (highest_ > 0 && active_[highest_].empty())
+      --highest_;
+    if (active_[highest_].empty())
+      break;
+
+    std::size_t v = active_[highest_].back();
+    active_[highest_].pop_back();
+    if (height_[v] != highest_ || excess_[v] == 0)
+      continue;  // stale entry, lifted by a gap or a global relabel
+
+    Discharge(v);
+  }
+
+  // final heights tell which vertices still reach the sink
+  GlobalRelabel();
+  return excess_[sink_];
+}
+
+template <typename Network>
+bool PushRelabel<Network>::SourceSide(std::size_t v) const noexcept
+{
+  return height_[v] >= n_;
+}
+
+template <typename Network>
+void PushRelabel<Network>::GlobalRelabel() noexcept
+{
+  std::fill(height_.begin(), height_.end(), n_);
+  std::fill(count_.begin(), count_.end(), 0);
+
+  height_[sink_] = 0;
+  std::vector<std::size_t> queue;
+  queue.reserve(n_);
+  queue.push_back(sink_);
+  for (std::size_t head = 0; head < queue.size(); ++head)
+  {
+    std::size_t w = queue[head];
+    ++count_[height_[w]];
+    for (std::size_t arc = network_.Begin(w); arc < network_.End(w); ++arc)
+    {
+      std::size_t u = network_.Head(w, arc);
+      if (height_[u] == n_ && u != source_ && network_.ReverseResidual(w, arc) > 0) {
+        height_[u] = height_[w] + 1;
+        queue.push_back(u);
+      }
+    }
+  }
+
+  for (auto &bucket : active_)
+    bucket.clear();
+  highest_ = 0;
+  for (std::size_t v = 0; v < n_; ++v)
+  {
+    current_[v] = network_.Begin(v);
+    if (v != source_ && v != sink_ && excess_[v] > 0 && height_[v] < n_)
+      Activate(v);
+  }
+}
+
+template <typename Network>
+void PushRelabel<Network>::Discharge(std::size_t v) noexcept
+{
+  while (excess_[v] > 0)
+  {
+    if (current_[v] == network_.End(v)) {
+      Relabel(v);
+      if (height_[v] >= n_)
+        return;
+      continue;
+    }
+
+    std::size_t arc = current_[v];
+    std::size_t w = network_.Head(v, arc);
+    distance_t residual = network_.Residual(v, arc);
+    if (residual > 0 && height_[v] == height_[w] + 1) {
+      distance_t amount = std::min(excess_[v], residual);
+      network_.Push(v, arc, amount);
+      excess_[v] -= amount;
+      if (excess_[w] == 0)
+        Activate(w);
+      excess_[w] += amount;
+    } else {
+      ++current_[v];
+    }
+  }
+}
+
+template <typename Network>
+void PushRelabel<Network>::Relabel(std::size_t v) noexcept
+{
+  std::size_t old = height_[v];
+  std::size_t lowest = n_;
+  for (std::size_t arc = network_.Begin(v); arc < network_.End(v); ++arc)
+    if (network_.Residual(v, arc) > 0)
+      lowest = std::min(lowest, height_[network_.Head(v, arc)] + 1);
+
+  work_ += network_.End(v) - network_.Begin(v) + 12;
+  current_[v] = network_.Begin(v);
+  height_[v] = lowest;
+  --count_[old];
+  if (lowest < n_)
+    ++count_[lowest];
+
+  if (count_[old] == 0)
+    Gap(old);
+}
+
+template <typename Network>
+void PushRelabel<Network>::Gap(std::size_t level) noexcept
+{
+  // nothing above an empty level can reach the sink any more
+  for (std::size_t u = 0; u < n_; ++u)
+    if (height_[u] > level && height_[u] < n_) {
+      --count_[height_[u]];
+      height_[u] = n_;
+    }
+}
+
+template <typename Network>
+void PushRelabel<Network>::Activate(std::size_t v) noexcept
+{
+  if (v == source_ || v == sink_ || height_[v] >= n_)
+    return;
+
+  active_[height_[v]].push_back(v);
+  highest_ = std::max(highest_, height_[v]);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,45 @@
+#include "../memory_usage.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline std::size_t MemoryFootprint::Total() const noexcept
+{
+  return vertex_table_ + adjacency_ + payloads_ + indices_ + slack_;
+}
+
+constexpr std::size_t AllocationSize(std::size_t bytes) noexcept
+{
+  constexpr std::size_t kGranule = 16;
+  constexpr std::size_t kMinimum = 32;
+  std::size_t size = (bytes + sizeof(std::size_t) + kGranule - 1) / kGranule * kGranule;
+  return size < kMinimum ? kMinimum : size;
+}
+
+constexpr std::size_t MapNodeSize(std::size_t value_size, std::size_t value_align) noexcept
+{
+  constexpr std::size_t kHeader = 4 * sizeof(void *);
+  std::size_t align = value_align > alignof(void *) ? value_align : alignof(void *);
+  std::size_t offset = (kHeader + value_align - 1) / value_align * value_align;
+  return (offset + value_size + align - 1) / align * align;
+}
+
+template <typename Value>
+constexpr std::size_t MapNodeSize() noexcept
+{
+  return MapNodeSize(sizeof(Value), alignof(Value));
+}
+
+template <typename T>
+void AccountVector(const std::vector<T> &vector, std::size_t &category, std::size_t &slack) noexcept
+{
+  category += vector.size() * sizeof(T);
+  if (vector.capacity() == 0)
+    return;
+
+  std::size_t reserved = vector.capacity() * sizeof(T);
+  slack += reserved - vector.size() * sizeof(T) + AllocationSize(reserved) - reserved;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
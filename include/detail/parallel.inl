@@ -0,0 +1,290 @@
+#include "../parallel.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline std::size_t TaskGroup::Pending() const noexcept
+{
+  return pending_.load(std::memory_order_acquire);
+}
+
+inline ThreadPool::ThreadPool(unsigned threads, bool pin)
+{
+  if (threads == 0)
+    threads = HardwareConcurrency();
+
+  queues_.reserve(threads);
+  for (unsigned i = 0; i < threads; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+
+  workers_.reserve(threads - 1);
+  for (std::size_t home = 1; home < threads; ++home)
+  {
+    workers_.emplace_back([this, home]() { Work(home); });
+
+#if defined(__linux__)
+    if (pin) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(home % HardwareConcurrency(), &cpus);
+      pthread_setaffinity_np(workers_.back().native_handle(), sizeof(cpus), &cpus);
+    }
+#else
+    (void)pin;
+#endif
+  }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+
+  for (auto &worker : workers_)
+    worker.join();
+}
+
+inline unsigned ThreadPool::Concurrency() const noexcept
+{
+  return static_cast<unsigned>(queues_.size());
+}
+
+template <typename Func>
+void ThreadPool::Submit(TaskGroup &group, Func&& func)
+{
+  group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+  Queue &queue = *queues_[Home()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex_);
+    queue.tasks_.emplace_back([&group, func = std::forward<Func>(func)]() mutable {
+      func();
+      group.pending_.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // counted before taking the lock, so a worker going to sleep either sees it or gets the call
+  queued_.fetch_add(1, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  wake_.notify_one();
+}
+
+inline void ThreadPool::Wait(TaskGroup &group) noexcept
+{
+  std::size_t home = Home();
+  while (group.Pending())
+    if (!RunOne(home))
+      std::this_thread::yield();
+}
+
+inline ThreadPool::Identity &ThreadPool::Current() noexcept
+{
+  static thread_local Identity identity;
+  return identity;
+}
+
+inline std::size_t ThreadPool::Home() const noexcept
+{
+  const Identity &identity = Current();
+  return identity.pool_ == this ? identity.queue_ : kShared;
+}
+
+inline bool ThreadPool::RunOne(std::size_t home) noexcept
+{
+  std::function<void()> task;
+  {
+    Queue &queue = *queues_[home];
+    std::lock_guard<std::mutex> lock(queue.mutex_);
+    if (!queue.tasks_.empty()) {
+      task = std::move(queue.tasks_.back());
+      queue.tasks_.pop_back();
+    }
+  }
+
+  for (std::size_t i = 1; !task && i < queues_.size(); ++i)
+  {
+    Queue &queue = *queues_[(home + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex_);
+    if (!queue.tasks_.empty()) {
+      task = std::move(queue.tasks_.front());
+      queue.tasks_.pop_front();
+    }
+  }
+
+  if (!task)
+    return false;
+
+  queued_.fetch_sub(1, std::memory_order_relaxed);
+  task();
+  return true;
+}
+
+inline void ThreadPool::Work(std::size_t home) noexcept
+{
+  Current() = Identity{this, home};
+
+  for (;;)
+  {
+    if (RunOne(home))
+      continue;
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+    if (stopping_ && queued_.load(std::memory_order_acquire) == 0)
+      return;
+  }
+}
+
+inline unsigned HardwareConcurrency() noexcept
+{
+  unsigned count = std::thread::hardware_concurrency();
+  return count ? count : 1;
+}
+
+// The replaceable default pool behind DefaultPool and SetDefaultPool.
+struct DefaultPoolSlot
+{
+  std::mutex mutex_;
+  std::shared_ptr<ThreadPool> pool_;
+
+  static DefaultPoolSlot &Get() noexcept
+  {
+    static DefaultPoolSlot slot;
+    return slot;
+  }
+};
+
+inline std::shared_ptr<ThreadPool> DefaultPool() noexcept
+{
+  auto &slot = DefaultPoolSlot::Get();
+  std::lock_guard<std::mutex> lock(slot.mutex_);
+  if (!slot.pool_)
+    slot.pool_ = std::make_shared<ThreadPool>();
+  return slot.pool_;
+}
+
+inline void SetDefaultPool(std::shared_ptr<ThreadPool> pool) noexcept
+{
+  auto &slot = DefaultPoolSlot::Get();
+  std::lock_guard<std::mutex> lock(slot.mutex_);
+  slot.pool_ = std::move(pool);
+}
+
+inline unsigned DefaultConcurrency() noexcept
+{
+  return DefaultPool()->Concurrency();
+}
+
+template <typename Func>
+unsigned ParallelFor(std::size_t begin, std::size_t end, unsigned threads, Func&& func) noexcept
+{
+  if (end <= begin)
+    return 0;
+
+  std::size_t total = end - begin;
+  if (threads == 0)
+    threads = DefaultConcurrency();
+  if (threads > total)
+    threads = static_cast<unsigned>(total);
+
+  if (threads == 1) {
+    func(0u, begin, end);
+    return 1;
+  }
+
+  std::size_t block = total / threads;
+  std::size_t rest = total % threads;
+
+  // held here, so a pool replaced meanwhile lives until its tasks are done
+  auto pool = DefaultPool();
+  TaskGroup group;
+
+  std::size_t first = begin + block + (rest > 0 ? 1 : 0);
+  for (unsigned worker = 1; worker < threads; ++worker)
+  {
+    std::size_t last = first + block + (worker < rest ? 1 : 0);
+    pool->Submit(group, [&func, worker, first, last]() { func(worker, first, last); });
+    first = last;
+  }
+
+  func(0u, begin, begin + block + (rest > 0 ? 1 : 0));
+  pool->Wait(group);
+
+  return threads;
+}
+
+template <typename Func>
+unsigned ParallelForAdaptive(std::size_t begin, std::size_t end, unsigned threads, Func&& func, std::size_t grain) noexcept
+{
+  if (end <= begin)
+    return 0;
+
+  std::size_t total = end - begin;
+  if (threads == 0)
+    threads = DefaultConcurrency();
+  if (threads > total)
+    threads = static_cast<unsigned>(total);
+  if (grain == 0)
+    grain = 1;
+
+  if (threads == 1) {
+    func(0u, begin, end);
+    return 1;
+  }
+
+  std::atomic<std::size_t> next{begin};
+  auto drain = [&, threads](unsigned worker) {
+    std::size_t first = next.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      if (first >= end)
+        return;
+
+      std::size_t chunk = std::max(grain, (end - first) / (2 * threads));
+      std::size_t last = end - first > chunk ? first + chunk : end;
+      if (next.compare_exchange_weak(first, last, std::memory_order_relaxed)) {
+        func(worker, first, last);
+        first = next.load(std::memory_order_relaxed);
+      }
+    }
+  };
+
+  auto pool = DefaultPool();
+  TaskGroup group;
+  for (unsigned worker = 1; worker < threads; ++worker)
+    pool->Submit(group, [&drain, worker]() { drain(worker); });
+
+  drain(0u);
+  pool->Wait(group);
+
+  return threads;
+}
+
+template <typename T, typename Map, typename Combine>
+T ParallelReduce(std::size_t begin, std::size_t end, unsigned threads, T identity, Map&& map, Combine&& combine, std::size_t grain) noexcept
+{
+  if (threads == 0)
+    threads = DefaultConcurrency();
+
+  std::vector<T> partial(threads, identity);
+  unsigned workers = ParallelForAdaptive(begin, end, threads, [&](unsigned worker, std::size_t first, std::size_t last) {
+    partial[worker] = combine(std::move(partial[worker]), map(first, last));
+  }, grain);
+
+  for (unsigned worker = 0; worker < workers; ++worker)
+    identity = combine(std::move(identity), std::move(partial[worker]));
+  return identity;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,335 @@
+#include "../partition.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline VertexPartition::VertexPartition(const std::vector<index_t> &ids, const std::vector<std::uint32_t> &part, unsigned parts):
+    members_(parts)
+{
+  std::size_t largest = 0;
+  for (index_t id : ids)
+    largest = std::max<std::size_t>(largest, id);
+
+  parts_.assign(ids.empty() ? 0 : largest + 1, kNoPart);
+  for (std::size_t i = 0; i < ids.size(); ++i)
+  {
+    parts_[ids[i]] = part[i];
+    members_[part[i]].push_back(ids[i]);
+  }
+
+  for (auto &members : members_)
+    std::sort(members.begin(), members.end());
+}
+
+inline unsigned VertexPartition::Parts() const noexcept
+{
+  return static_cast<unsigned>(members_.size());
+}
+
+inline std::uint32_t VertexPartition::PartOf(index_t id) const noexcept
+{
+  return id < parts_.size() ? parts_[id] : kNoPart;
+}
+
+inline const std::vector<index_t> &VertexPartition::Members(unsigned part) const noexcept
+{
+  return members_[part];
+}
+
+inline std::size_t PartitionLevel::VerticesSize() const noexcept
+{
+  return vertex_weights_.size();
+}
+
+inline void PartitionLevel::Coarsen(SplitMix64 &random, PartitionLevel &res, std::vector<std::size_t> &coarse) const
+{
+  static constexpr std::size_t kUnmatched = SIZE_MAX;
+
+  const std::size_t n = VerticesSize();
+  std::vector<std::size_t> order(n), mate(n, kUnmatched);
+  for (std::size_t v = 0; v < n; ++v)
+    order[v] = v;
+  for (std::size_t i = n; i > 1; --i)
+    std::swap(order[i - 1], order[random.Below(i)]);
+
+  // heavy-edge matching: every vertex pairs with the unmatched neighbour it shares the most arcs with
+  for (std::size_t v : order)
+  {
+    if (mate[v] != kUnmatched)
+      continue;
+
+    std::size_t best = v, heaviest = 0;
+    for (std::size_t arc = offsets_[v]; arc < offsets_[v + 1]; ++arc)
+      if (mate[targets_[arc]] == kUnmatched && targets_[arc] != v && edge_weights_[arc] > heaviest) {
+        best = targets_[arc];
+        heaviest = edge_weights_[arc];
+      }
+
+    mate[v] = best;
+    mate[best] = v;
+  }
+
+  coarse.assign(n, kUnmatched);
+  res.vertex_weights_.clear();
+  for (std::size_t v = 0; v < n; ++v)
+    if (coarse[v] == kUnmatched) {
+      coarse[v] = coarse[mate[v]] = res.vertex_weights_.size();
+      res.vertex_weights_.push_back(vertex_weights_[v] + (mate[v] != v ? vertex_weights_[mate[v]] : 0));
+    }
+
+  // the arcs of both halves, merged by coarse target; slot[t] is where the current row holds t
+  const std::size_t m = res.vertex_weights_.size();
+  std::vector<std::size_t> slot(m, kUnmatched), members(2 * m);
+  for (std::size_t v = 0; v < n; ++v)
+    if (v <= mate[v]) {
+      members[2 * coarse[v]] = v;
+      members[2 * coarse[v] + 1] = mate[v];
+    }
+
+  res.offsets_.assign(1, 0);
+  res.targets_.clear();
+  res.edge_weights_.clear();
+  for (std::size_t c = 0; c < m; ++c)
+  {
+    std::size_t row = res.targets_.size();
+    std::size_t first = members[2 * c], second = members[2 * c + 1];
+    for (std::size_t v : {first, second})
+    {
+      for (std::size_t arc = offsets_[v]; arc < offsets_[v + 1]; ++arc)
+      {
+        std::size_t t = coarse[targets_[arc]];
+        if (t == c)
+          continue;
+
+        if (slot[t] == kUnmatched || slot[t] < row) {
+          slot[t] = res.targets_.size();
+          res.targets_.push_back(t);
+          res.edge_weights_.push_back(edge_weights_[arc]);
+        } else {
+          res.edge_weights_[slot[t]] += edge_weights_[arc];
+        }
+      }
+
+      if (second == first)
+        break;
+    }
+    res.offsets_.push_back(res.targets_.size());
+  }
+}
+
+inline void PartitionLevel::Refine(std::vector<std::uint32_t> &part, unsigned parts, std::size_t capacity, unsigned passes) const
+{
+  const std::size_t n = VerticesSize();
+  std::vector<std::size_t> size(parts, 0), links(parts, 0);
+  std::vector<std::uint32_t> seen;
+  for (std::size_t v = 0; v < n; ++v)
+    size[part[v]] += vertex_weights_[v];
+
+  for (unsigned pass = 0; pass < passes; ++pass)
+  {
+    bool moved = false;
+    for (std::size_t v = 0; v < n; ++v)
+    {
+      seen.clear();
+      for (std::size_t arc = offsets_[v]; arc < offsets_[v + 1]; ++arc)
+        if ((links[part[targets_[arc]]] += edge_weights_[arc]) == edge_weights_[arc])
+          seen.push_back(part[targets_[arc]]);
+
+      /*  only the boundary can gain, an interior vertex sees its own part alone. Ties go to the
+       *  lighter part, and a vertex of an overfull part leaves for any part with room.
+       */
+      const std::uint32_t own = part[v];
+      const std::size_t weight = vertex_weights_[v];
+      auto load = [&](std::uint32_t p) { return p == own ? size[own] : size[p] + weight; };
+      std::uint32_t best = own;
+      for (std::uint32_t p : seen)
+      {
+        if (p == own || size[p] + weight > capacity)
+          continue;
+
+        if ((best == own && size[own] > capacity) || links[p] > links[best] ||
+            (links[p] == links[best] && load(p) < load(best)))
+          best = p;
+      }
+      for (std::uint32_t p : seen)
+        links[p] = 0;
+
+      if (best != own) {
+        size[own] -= weight;
+        size[best] += weight;
+        part[v] = best;
+        moved = true;
+      }
+    }
+
+    if (!moved)
+      break;
+  }
+}
+
+inline void GrowParts(const PartitionLevel &level, unsigned parts, std::vector<std::uint32_t> &part)
+{
+  const std::size_t n = level.VerticesSize();
+  std::size_t total = 0;
+  for (std::size_t w : level.vertex_weights_)
+    total += w;
+
+  // breadth-first order keeps every block of the order connected where the graph allows it
+  std::vector<char> reached(n, 0);
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  for (std::size_t root = 0; root < n; ++root)
+  {
+    if (reached[root])
+      continue;
+
+    reached[root] = 1;
+    std::size_t head = order.size();
+    order.push_back(root);
+    for (; head < order.size(); ++head)
+    {
+      std::size_t v = order[head];
+      for (std::size_t arc = level.offsets_[v]; arc < level.offsets_[v + 1]; ++arc)
+        if (!reached[level.targets_[arc]]) {
+          reached[level.targets_[arc]] = 1;
+          order.push_back(level.targets_[arc]);
+        }
+    }
+  }
+
+  part.assign(n, 0);
+  std::size_t before = 0;
+  for (std::size_t v : order)
+  {
+    // a vertex goes to the part its middle falls in
+    std::size_t middle = before + level.vertex_weights_[v] / 2;
+    part[v] = static_cast<std::uint32_t>(std::min<std::size_t>(parts - 1, middle * parts / std::max<std::size_t>(total, 1)));
+    before += level.vertex_weights_[v];
+  }
+}
+
+template <typename Container>
+void PartitionGraph(const Container &graph, unsigned parts, VertexPartition &res, const PartitionOptions &options) noexcept
+{
+  // the multilevel scheme stops coarsening at this many vertices per part or once matching stalls
+  constexpr std::size_t kCoarsestPerPart = 16;
+
+  parts = std::max(parts, 1u);
+  CompactAdjacency<false> adjacency(graph, EdgeDirection::BOTH);
+  const std::size_t n = adjacency.VerticesSize();
+
+  // both directions of an edge merge into one arc of weight 2, self-loops never cross a cut
+  PartitionLevel level;
+  level.vertex_weights_.assign(n, 1);
+  level.offsets_.assign(1, 0);
+  std::vector<std::size_t> slot(n, SIZE_MAX);
+  for (std::size_t v = 0; v < n; ++v)
+  {
+    std::size_t row = level.targets_.size();
+    for (auto u = adjacency.NeighborBegin(v); u != adjacency.NeighborEnd(v); ++u)
+    {
+      if (*u == v)
+        continue;
+
+      if (slot[*u] == SIZE_MAX || slot[*u] < row) {
+        slot[*u] = level.targets_.size();
+        level.targets_.push_back(*u);
+        level.edge_weights_.push_back(1);
+      } else {
+        ++level.edge_weights_[slot[*u]];
+      }
+    }
+    level.offsets_.push_back(level.targets_.size());
+  }
+
+  const auto capacity = static_cast<std::size_t>((1.0 + options.imbalance_) * static_cast<double>(n) / parts) + 1;
+  std::vector<std::uint32_t> part;
+
+  if (options.method_ == PartitionMethod::LABEL_PROPAGATION) {
+    GrowParts(level, parts, part);
+
+    // a vertex takes the part most of its arcs lead to, unless that part is full
+    std::vector<std::size_t> size(parts, 0), links(parts, 0);
+    std::vector<std::uint32_t> seen;
+    for (std::size_t v = 0; v < n; ++v)
+      ++size[part[v]];
+
+    for (unsigned round = 0; round < options.rounds_; ++round)
+    {
+      bool changed = false;
+      for (std::size_t v = 0; v < n; ++v)
+      {
+        seen.clear();
+        for (std::size_t arc = level.offsets_[v]; arc < level.offsets_[v + 1]; ++arc)
+          if ((links[part[level.targets_[arc]]] += level.edge_weights_[arc]) == level.edge_weights_[arc])
+            seen.push_back(part[level.targets_[arc]]);
+
+        std::uint32_t best = part[v];
+        for (std::uint32_t p : seen)
+          if (links[p] > links[best] && size[p] < capacity)
+            best = p;
+        for (std::uint32_t p : seen)
+          links[p] = 0;
+
+        if (best != part[v]) {
+          --size[part[v]];
+          ++size[best];
+          part[v] = best;
+          changed = true;
+        }
+      }
+
+      if (!changed)
+        break;
+    }
+  } else {
+    SplitMix64 random(options.seed_);
+    std::vector<PartitionLevel> levels;
+    std::vector<std::vector<std::size_t>> maps;
+    levels.push_back(std::move(level));
+    while (levels.back().VerticesSize() > kCoarsestPerPart * parts)
+    {
+      PartitionLevel coarser;
+      std::vector<std::size_t> coarse;
+      levels.back().Coarsen(random, coarser, coarse);
+      if (coarser.VerticesSize() * 20 > levels.back().VerticesSize() * 19)
+        break;
+
+      levels.push_back(std::move(coarser));
+      maps.push_back(std::move(coarse));
+    }
+
+    GrowParts(levels.back(), parts, part);
+    levels.back().Refine(part, parts, capacity, options.rounds_);
+    for (std::size_t i = maps.size(); i-- > 0;)
+    {
+      std::vector<std::uint32_t> finer(maps[i].size());
+      for (std::size_t v = 0; v < finer.size(); ++v)
+        finer[v] = part[maps[i][v]];
+      part = std::move(finer);
+      levels[i].Refine(part, parts, capacity, options.rounds_);
+    }
+  }
+
+  std::vector<index_t> ids(n);
+  for (std::size_t v = 0; v < n; ++v)
+    ids[v] = adjacency.IdOf(v);
+  res = VertexPartition(ids, part, parts);
+}
+
+template <typename Container>
+std::size_t EdgeCut(const Container &graph, const VertexPartition &partition) noexcept
+{
+  std::size_t cut = 0;
+  for (const auto &entry : graph)
+  {
+    index_t start = entry.first;
+    graph.ForEachOut(start, [&](index_t dest, weight_t) {
+      cut += partition.PartOf(start) != partition.PartOf(dest);
+    });
+  }
+  return cut;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,333 @@
+#include "../reorder.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline VertexPermutation::VertexPermutation(std::vector<index_t> order): order_(std::move(order))
+{
+  std::size_t largest = 0;
+  for (index_t id : order_)
+    largest = std::max<std::size_t>(largest, id);
+
+  new_ids_.assign(order_.empty() ? 0 : largest + 1, kNoId);
+  for (std::size_t position = 0; position < order_.size(); ++position)
+    new_ids_[order_[position]] = static_cast<std::uint32_t>(position);
+}
+
+inline std::size_t VertexPermutation::Size() const noexcept
+{
+  return order_.size();
+}
+
+inline std::optional<index_t> VertexPermutation::NewId(index_t old_id) const noexcept
+{
+  if (old_id >= new_ids_.size() || new_ids_[old_id] == kNoId)
+    return std::nullopt;
+
+  return static_cast<index_t>(new_ids_[old_id]);
+}
+
+inline index_t VertexPermutation::OldId(index_t new_id) const noexcept
+{
+  return order_[new_id];
+}
+
+inline const std::vector<index_t> &VertexPermutation::Order() const noexcept
+{
+  return order_;
+}
+
+inline void BreadthFirstOrder(const CompactAdjacency<false> &adjacency,
+                              const std::vector<std::size_t> &roots,
+                              bool by_degree,
+                              std::vector<std::size_t> &res)
+{
+  const std::size_t n = adjacency.VerticesSize();
+  std::vector<char> reached(n, 0);
+  std::vector<std::size_t> neighbors;
+  res.clear();
+  res.reserve(n);
+
+  for (std::size_t root : roots)
+  {
+    if (reached[root])
+      continue;
+
+    reached[root] = 1;
+    std::size_t head = res.size();
+    res.push_back(root);
+
+    // res doubles as the queue, the vertices from head on are waiting
+    for (; head < res.size(); ++head)
+    {
+      std::size_t v = res[head];
+      neighbors.assign(adjacency.NeighborBegin(v), adjacency.NeighborEnd(v));
+      if (by_degree)
+        std::stable_sort(neighbors.begin(), neighbors.end(), [&adjacency](std::size_t lhs, std::size_t rhs) {
+          return adjacency.Degree(lhs) < adjacency.Degree(rhs);
+        });
+
+      for (std::size_t u : neighbors)
+        if (!reached[u]) {
+          reached[u] = 1;
+          res.push_back(u);
+        }
+    }
+  }
+}
+
+inline void DepthFirstOrder(const CompactAdjacency<false> &adjacency, std::vector<std::size_t> &res)
+{
+  const std::size_t n = adjacency.VerticesSize();
+  std::vector<char> reached(n, 0);
+  std::vector<std::pair<std::size_t, const index_t *>> stack;
+  res.clear();
+  res.reserve(n);
+
+  for (std::size_t root = 0; root < n; ++root)
+  {
+    if (reached[root])
+      continue;
+
+    reached[root] = 1;
+    res.push_back(root);
+    stack.emplace_back(root, adjacency.NeighborBegin(root));
+    while (!stack.empty())
+    {
+      auto &[v, next] = stack.back();
+      if (next == adjacency.NeighborEnd(v)) {
+        stack.pop_back();
+        continue;
+      }
+
+      std::size_t u = *next++;
+      if (!reached[u]) {
+        reached[u] = 1;
+        res.push_back(u);
+        stack.emplace_back(u, adjacency.NeighborBegin(u));
+      }
+    }
+  }
+}
+
+inline void PropagateLabels(const CompactAdjacency<false> &adjacency, std::vector<std::size_t> &labels)
+{
+  constexpr unsigned kRounds = 16;
+
+  const std::size_t n = adjacency.VerticesSize();
+  labels.resize(n);
+  for (std::size_t v = 0; v < n; ++v)
+    labels[v] = v;
+
+  std::vector<std::size_t> votes(n, 0), seen;
+  for (unsigned round = 0; round < kRounds; ++round)
+  {
+    bool changed = false;
+    for (std::size_t v = 0; v < n; ++v)
+    {
+      seen.clear();
+      for (auto u = adjacency.NeighborBegin(v); u != adjacency.NeighborEnd(v); ++u)
+        if (*u != v && votes[labels[*u]]++ == 0)
+          seen.push_back(labels[*u]);
+
+      std::size_t best = labels[v], most = 0;
+      for (std::size_t label : seen)
+      {
+        if (votes[label] > most || (votes[label] == most && label < best)) {
+          best = label;
+          most = votes[label];
+        }
+        votes[label] = 0;
+      }
+
+      if (most && best != labels[v]) {
+        labels[v] = best;
+        changed = true;
+      }
+    }
+
+    if (!changed)
+      break;
+  }
+}
+
+template <typename Container>
+void OrderVertices(const Container &graph, VertexOrder order, VertexPermutation &res) noexcept
+{
+  // neighbours both ways, so directed graphs are ordered by their undirected shape
+  CompactAdjacency<false> adjacency(graph, EdgeDirection::BOTH);
+  const std::size_t n = adjacency.VerticesSize();
+
+  std::vector<std::size_t> ascending(n);
+  for (std::size_t v = 0; v < n; ++v)
+    ascending[v] = v;
+
+  std::vector<std::size_t> positions;
+  switch (order)
+  {
+  case VertexOrder::DEGREE:
+    positions = ascending;
+    std::stable_sort(positions.begin(), positions.end(), [&adjacency](std::size_t lhs, std::size_t rhs) {
+      return adjacency.Degree(lhs) > adjacency.Degree(rhs);
+    });
+    break;
+
+  case VertexOrder::BFS:
+    BreadthFirstOrder(adjacency, ascending, false, positions);
+    break;
+
+  case VertexOrder::DFS:
+    DepthFirstOrder(adjacency, positions);
+    break;
+
+  case VertexOrder::RCM: {
+    // every component starts from its vertex of least degree
+    std::vector<std::size_t> roots = ascending;
+    std::stable_sort(roots.begin(), roots.end(), [&adjacency](std::size_t lhs, std::size_t rhs) {
+      return adjacency.Degree(lhs) < adjacency.Degree(rhs);
+    });
+    BreadthFirstOrder(adjacency, roots, true, positions);
+    std::reverse(positions.begin(), positions.end());
+    break;
+  }
+
+  case VertexOrder::COMMUNITY: {
+    // communities in the order breadth-first search meets them, breadth-first order inside each
+    std::vector<std::size_t> labels, rank(n), first_rank(n, SIZE_MAX);
+    PropagateLabels(adjacency, labels);
+    BreadthFirstOrder(adjacency, ascending, false, positions);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      rank[positions[i]] = i;
+      first_rank[labels[positions[i]]] = std::min(first_rank[labels[positions[i]]], i);
+    }
+
+    std::sort(positions.begin(), positions.end(), [&](std::size_t lhs, std::size_t rhs) {
+      std::size_t left = first_rank[labels[lhs]], right = first_rank[labels[rhs]];
+      return left != right ? left < right : rank[lhs] < rank[rhs];
+    });
+    break;
+  }
+  }
+
+  std::vector<index_t> ids(n);
+  for (std::size_t i = 0; i < n; ++i)
+    ids[i] = adjacency.IdOf(positions[i]);
+  res = VertexPermutation(std::move(ids));
+}
+
+template <typename Container>
+RelabeledView<Container>::RelabeledView(const Container &graph, const VertexPermutation &permutation):
+    graph_(&graph), permutation_(&permutation)
+{
+  ids_.reserve(permutation.Size());
+  for (std::size_t id = 0; id < permutation.Size(); ++id)
+    if (graph.HasVertex(permutation.OldId(static_cast<index_t>(id))))
+      ids_.push_back(Entry{static_cast<index_t>(id)});
+}
+
+template <typename Container>
+const VertexPermutation &RelabeledView<Container>::Permutation() const noexcept
+{
+  return *permutation_;
+}
+
+template <typename Container>
+bool RelabeledView<Container>::HasVertex(index_t s) const noexcept
+{
+  return s < permutation_->Size() && graph_->HasVertex(permutation_->OldId(s));
+}
+
+template <typename Container>
+auto RelabeledView<Container>::At(index_t id) const -> std::optional<ValueType>
+{
+  if (!HasVertex(id))
+    return std::nullopt;
+
+  return graph_->At(permutation_->OldId(id));
+}
+
+template <typename Container>
+std::size_t RelabeledView<Container>::VerticesSize() const noexcept
+{
+  return ids_.size();
+}
+
+template <typename Container>
+std::size_t RelabeledView<Container>::OutDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachOut(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <typename Container>
+std::size_t RelabeledView<Container>::InDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachIn(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <typename Container>
+bool RelabeledView<Container>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  return start < permutation_->Size() && dest < permutation_->Size() &&
+         graph_->HasEdge(permutation_->OldId(start), permutation_->OldId(dest));
+}
+
+template <typename Container>
+weight_t RelabeledView<Container>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  if (start >= permutation_->Size() || dest >= permutation_->Size())
+    return kDisconnected;
+
+  return graph_->WeightOfEdge(permutation_->OldId(start), permutation_->OldId(dest));
+}
+
+template <typename Container>
+template <typename Visitor>
+void RelabeledView<Container>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(start))
+    return;
+
+  graph_->ForEachOut(permutation_->OldId(start), [&](index_t dest, weight_t weight) {
+    if (auto id = permutation_->NewId(dest))
+      visit(*id, weight);
+  });
+}
+
+template <typename Container>
+template <typename Visitor>
+void RelabeledView<Container>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(dest))
+    return;
+
+  graph_->ForEachIn(permutation_->OldId(dest), [&](index_t start, weight_t weight) {
+    if (auto id = permutation_->NewId(start))
+      visit(*id, weight);
+  });
+}
+
+template <typename Container>
+bool RelabeledView<Container>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeOut(*this, start, res, append);
+}
+
+template <typename Container>
+auto RelabeledView<Container>::begin() const noexcept -> typename std::vector<Entry>::const_iterator
+{
+  return ids_.begin();
+}
+
+template <typename Container>
+auto RelabeledView<Container>::end() const noexcept -> typename std::vector<Entry>::const_iterator
+{
+  return ids_.end();
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,159 @@
+#include "../sharded_graph.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Local>
+template <typename Container>
+ShardedGraph<Local>::ShardedGraph(const Container &graph, const VertexPartition &partition, unsigned threads):
+    partition_(partition), shards_(partition.Parts())
+{
+  ParallelFor(0, shards_.size(), threads, [&](unsigned, std::size_t first, std::size_t last) {
+    for (std::size_t part = first; part < last; ++part)
+    {
+      Shard &shard = shards_[part];
+      for (index_t id : partition_.Members(static_cast<unsigned>(part)))
+        if (graph.HasVertex(id)) {
+          shard.local_.RegisterVertex(id, graph.At(id).value());
+          shard.owned_.push_back(id);
+        }
+
+      // an undirected edge between two owned vertices is already there when its other end came first
+      for (index_t start : shard.owned_)
+        graph.ForEachOut(start, [&](index_t dest, weight_t weight) {
+          if (partition_.PartOf(dest) != part) {
+            if (!shard.local_.HasVertex(dest)) {
+              shard.local_.RegisterVertex(dest, graph.At(dest).value());
+              shard.ghosts_.push_back(dest);
+            }
+          } else if (dest < start && shard.local_.HasEdge(start, dest)) {
+            return;
+          }
+          shard.local_.InsertEdge(start, dest, weight);
+        });
+    }
+  });
+}
+
+template <typename Local>
+unsigned ShardedGraph<Local>::Shards() const noexcept
+{
+  return static_cast<unsigned>(shards_.size());
+}
+
+template <typename Local>
+auto ShardedGraph<Local>::ShardAt(unsigned shard) const noexcept -> const Shard &
+{
+  return shards_[shard];
+}
+
+template <typename Local>
+const VertexPartition &ShardedGraph<Local>::Partition() const noexcept
+{
+  return partition_;
+}
+
+template <typename Local>
+std::uint32_t ShardedGraph<Local>::OwnerOf(index_t id) const noexcept
+{
+  return partition_.PartOf(id);
+}
+
+template <typename Local>
+std::size_t ShardedGraph<Local>::VerticesSize() const noexcept
+{
+  std::size_t count = 0;
+  for (const auto &shard : shards_)
+    count += shard.owned_.size();
+  return count;
+}
+
+template <typename Local>
+std::size_t ShardedGraph<Local>::GhostsSize() const noexcept
+{
+  std::size_t count = 0;
+  for (const auto &shard : shards_)
+    count += shard.ghosts_.size();
+  return count;
+}
+
+template <typename Local>
+template <typename Transport>
+void ShardedGraph<Local>::ShortestPaths(index_t source, std::map<index_t, distance_t> &res, Transport &transport) const noexcept
+{
+  Relaxation(source, false, res, transport);
+}
+
+template <typename Local>
+void ShardedGraph<Local>::ShortestPaths(index_t source, std::map<index_t, distance_t> &res) const noexcept
+{
+  InProcessTransport<DistanceMessage> transport(Shards());
+  Relaxation(source, false, res, transport);
+}
+
+template <typename Local>
+template <typename Transport>
+void ShardedGraph<Local>::BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res, Transport &transport) const noexcept
+{
+  Relaxation(source, true, res, transport);
+}
+
+template <typename Local>
+void ShardedGraph<Local>::BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res) const noexcept
+{
+  InProcessTransport<DistanceMessage> transport(Shards());
+  Relaxation(source, true, res, transport);
+}
+
+template <typename Local>
+template <typename Transport>
+void ShardedGraph<Local>::Relaxation(index_t source, bool unit, std::map<index_t, distance_t> &res, Transport &transport) const noexcept
+{
+  res.clear();
+  const std::uint32_t home = OwnerOf(source);
+  if (home == VertexPartition::kNoPart || shards_.empty())
+    return;
+
+  std::vector<SearchSpace> spaces(shards_.size());
+  RunBsp(transport, [&](unsigned shard, std::size_t step, const std::vector<DistanceMessage> &inbox) {
+    SearchSpace &space = spaces[shard];
+    if (step == 0 && shard == home) {
+      space.Relax(source, 0, source);
+      space.Push(0, source);
+    }
+
+    for (const auto &message : inbox)
+      if (space.Relax(message.vertex_, message.distance_, message.vertex_))
+        space.Push(message.distance_, message.vertex_);
+
+    // settle what the shard reaches locally; a ghost isn't expanded, its owner hears of it instead
+    const Local &local = shards_[shard].local_;
+    while (!space.heap_.empty())
+    {
+      auto [dist, v] = space.Pop();
+      if (dist > space.distance_[v])
+        continue;
+
+      std::uint32_t owner = OwnerOf(v);
+      if (owner != shard) {
+        transport.Send(shard, owner, DistanceMessage{v, dist});
+        continue;
+      }
+
+      local.ForEachOut(v, [&](index_t w, weight_t weight) {
+        distance_t candidate = dist + (unit ? 1 : weight);
+        if (space.Relax(w, candidate, v))
+          space.Push(candidate, w);
+      });
+    }
+    return false;
+  });
+
+  for (std::size_t shard = 0; shard < shards_.size(); ++shard)
+    for (index_t v : shards_[shard].owned_)
+      if (spaces[shard].distance_[v] != kUnreachable)
+        res.emplace(v, spaces[shard].distance_[v]);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,345 @@
+#include "../static_graph.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr StaticGraph<Size,Weighted,Directed>::StaticGraph() noexcept
+{
+  WEIGHTED_GRAPH_BEGIN
+    for (auto &cell : cells_)
+      cell = kDisconnected;
+  WEIGHTED_GRAPH_END
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr StaticGraph<Size,Weighted,Directed>::StaticGraph(std::initializer_list<EdgeType> edges) noexcept:
+    StaticGraph()
+{
+  for (const auto &edge : edges)
+    InsertEdge(edge);
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::VerticesSize() const noexcept
+{
+  return Size;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::EdgeSize() const noexcept
+{
+  return edges_;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::HasVertex(index_t s) const noexcept
+{
+  return s < Size;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  return HasVertex(start) && HasVertex(dest) && WEIGHT_CHECK(Weight(Index(start, dest)));
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr weight_t StaticGraph<Size,Weighted,Directed>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  if (!HasVertex(start) || !HasVertex(dest))
+    return kDisconnected;
+
+  return Weight(Index(start, dest));
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::InsertEdge(index_t start, index_t dest, weight_t weight) noexcept
+{
+  if (!HasVertex(start) || !HasVertex(dest))
+    return false;
+
+  WEIGHTED_GRAPH
+    if (!(WEIGHT_CHECK(weight)))
+      return false;
+
+  if (!HasEdge(start, dest))
+    ++edges_;
+
+  Set(start, dest, weight);
+  NON_DIRECTED_GRAPH
+    Set(dest, start, weight);
+  return true;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::InsertEdge(const EdgeType &edge) noexcept
+{
+  WEIGHTED_GRAPH
+    return InsertEdge(edge.start_, edge.destination_, edge.weight_);
+  ELSE
+    return InsertEdge(edge.start_, edge.destination_);
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::EraseEdge(index_t start, index_t dest) noexcept
+{
+  if (!HasEdge(start, dest))
+    return false;
+
+  --edges_;
+  Set(start, dest, kDisconnected);
+  NON_DIRECTED_GRAPH
+    Set(dest, start, kDisconnected);
+  return true;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::OutDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachOut(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::InDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachIn(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::Degree(index_t s) const noexcept
+{
+  DIRECTED_GRAPH
+    return InDegree(s) + OutDegree(s);
+  ELSE
+    return OutDegree(s);
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+constexpr void StaticGraph<Size,Weighted,Directed>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(start))
+    return;
+
+  for (index_t dest = 0; dest < Size; ++dest)
+  {
+    weight_t weight = Weight(Index(start, dest));
+    if (WEIGHT_CHECK(weight))
+      visit(dest, weight);
+  }
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+constexpr void StaticGraph<Size,Weighted,Directed>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(dest))
+    return;
+
+  for (index_t start = 0; start < Size; ++start)
+  {
+    weight_t weight = Weight(Index(start, dest));
+    if (WEIGHT_CHECK(weight))
+      visit(start, weight);
+  }
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::optional<std::array<index_t, Size>> StaticGraph<Size,Weighted,Directed>::TopologicalOrder() const noexcept
+{
+  static_assert(Directed, "Function can't work if the graph is not directed.");
+
+  std::array<std::size_t, Size> pending{};
+  std::array<bool, Size> placed{};
+  for (index_t v = 0; v < Size; ++v)
+    pending[v] = InDegree(v);
+
+  // each step places the smallest vertex left without pending in-edges, O(Size^2) in all
+  std::array<index_t, Size> order{};
+  for (std::size_t i = 0; i < Size; ++i)
+  {
+    index_t next = 0;
+    while (next < Size && (placed[next] || pending[next]))
+      ++next;
+
+    if (next == Size)
+      return std::nullopt;
+
+    placed[next] = true;
+    order[i] = next;
+    ForEachOut(next, [&pending](index_t dest, weight_t) { --pending[dest]; });
+  }
+  return order;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr bool StaticGraph<Size,Weighted,Directed>::Reaches(index_t start, index_t dest) const noexcept
+{
+  if (!HasVertex(start) || !HasVertex(dest))
+    return false;
+
+  std::array<bool, Size> seen{};
+  std::array<index_t, Size> stack{};
+  std::size_t top = 0;
+  stack[top++] = start;
+  while (top)
+  {
+    index_t v = stack[--top];
+    for (index_t next = 0; next < Size; ++next)
+    {
+      if (seen[next] || !HasEdge(v, next))
+        continue;
+
+      if (next == dest)
+        return true;
+
+      seen[next] = true;
+      stack[top++] = next;
+    }
+  }
+  return false;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr auto StaticGraph<Size,Weighted,Directed>::Reachability() const noexcept -> Table<bool>
+{
+  std::array<std::array<std::uint64_t, kWords>, Size> rows{};
+  for (index_t s = 0; s < Size; ++s)
+    ForEachOut(s, [&rows, s](index_t dest, weight_t) { rows[s][dest / 64] |= std::uint64_t{1} << (dest % 64); });
+
+  // after step k, a row holds every vertex reached through intermediates below k + 1
+  for (std::size_t k = 0; k < Size; ++k)
+    for (std::size_t s = 0; s < Size; ++s)
+    {
+      if (!(rows[s][k / 64] >> (k % 64) & 1))
+        continue;
+
+      for (std::size_t word = 0; word < kWords; ++word)
+        rows[s][word] |= rows[k][word];
+    }
+
+  Table<bool> reach{};
+  for (std::size_t s = 0; s < Size; ++s)
+    for (std::size_t d = 0; d < Size; ++d)
+      reach[s][d] = rows[s][d / 64] >> (d % 64) & 1;
+  return reach;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::array<distance_t, Size> StaticGraph<Size,Weighted,Directed>::ShortestPaths(index_t source) const noexcept
+{
+  std::array<distance_t, Size> distance{};
+  std::array<bool, Size> settled{};
+  for (auto &d : distance)
+    d = kUnreachable;
+
+  if (!HasVertex(source))
+    return distance;
+
+  // a scan for the closest open vertex beats a heap on a dense array of a few dozen
+  distance[source] = 0;
+  for (std::size_t round = 0; round < Size; ++round)
+  {
+    std::size_t v = Size;
+    for (std::size_t u = 0; u < Size; ++u)
+      if (!settled[u] && distance[u] != kUnreachable && (v == Size || distance[u] < distance[v]))
+        v = u;
+
+    if (v == Size)
+      break;
+
+    settled[v] = true;
+    ForEachOut(static_cast<index_t>(v), [&](index_t dest, weight_t weight) {
+      if (distance[v] + weight < distance[dest])
+        distance[dest] = distance[v] + weight;
+    });
+  }
+  return distance;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr auto StaticGraph<Size,Weighted,Directed>::AllPairsShortestPaths() const noexcept -> Table<distance_t>
+{
+  Table<distance_t> distance{};
+  for (index_t s = 0; s < Size; ++s)
+    distance[s] = ShortestPaths(s);
+  return distance;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr std::size_t StaticGraph<Size,Weighted,Directed>::Index(index_t start, index_t dest) noexcept
+{
+  return static_cast<std::size_t>(start) * Size + dest;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr weight_t StaticGraph<Size,Weighted,Directed>::Weight(std::size_t cell) const noexcept
+{
+  WEIGHTED_GRAPH
+    return cells_[cell];
+  ELSE
+    return cells_[cell] ? kConnected : kDisconnected;
+}
+
+template <size_t Size,
+          bool Weighted,
+          bool Directed>
+constexpr void StaticGraph<Size,Weighted,Directed>::Set(index_t start, index_t dest, weight_t weight) noexcept
+{
+  WEIGHTED_GRAPH
+    cells_[Index(start, dest)] = weight;
+  ELSE
+    cells_[Index(start, dest)] = WEIGHT_CHECK(weight);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,186 @@
+#include "../subgraph.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Container>
+SubgraphView<Container>::SubgraphView(const Container &graph, const std::vector<index_t> &vertices):
+    graph_(&graph)
+{
+  for (index_t id : vertices)
+  {
+    if (id >= members_.size())
+      members_.resize(static_cast<std::size_t>(id) + 1, false);
+    members_[id] = true;
+  }
+
+  Collect();
+}
+
+template <typename Container>
+SubgraphView<Container>::SubgraphView(const Container &graph, const std::vector<bool> &members):
+    graph_(&graph), members_(members)
+{
+  Collect();
+}
+
+template <typename Container>
+void SubgraphView<Container>::Collect() noexcept
+{
+  for (std::size_t id = 0; id < members_.size(); ++id)
+  {
+    if (!members_[id])
+      continue;
+
+    if (graph_->HasVertex(static_cast<index_t>(id)))
+      ids_.push_back(Entry{static_cast<index_t>(id)});
+    else
+      members_[id] = false;
+  }
+}
+
+template <typename Container>
+const Container &SubgraphView<Container>::Source() const noexcept
+{
+  return *graph_;
+}
+
+template <typename Container>
+bool SubgraphView<Container>::HasVertex(index_t s) const noexcept
+{
+  return s < members_.size() && members_[s];
+}
+
+template <typename Container>
+auto SubgraphView<Container>::At(index_t id) const -> std::optional<ValueType>
+{
+  if (!HasVertex(id))
+    return std::nullopt;
+
+  return graph_->At(id);
+}
+
+template <typename Container>
+std::size_t SubgraphView<Container>::VerticesSize() const noexcept
+{
+  return ids_.size();
+}
+
+template <typename Container>
+std::size_t SubgraphView<Container>::OutDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachOut(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <typename Container>
+std::size_t SubgraphView<Container>::InDegree(index_t s) const noexcept
+{
+  std::size_t degree = 0;
+  ForEachIn(s, [&degree](index_t, weight_t) { ++degree; });
+  return degree;
+}
+
+template <typename Container>
+bool SubgraphView<Container>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  return HasVertex(start) && HasVertex(dest) && graph_->HasEdge(start, dest);
+}
+
+template <typename Container>
+weight_t SubgraphView<Container>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  if (!HasVertex(start) || !HasVertex(dest))
+    return kDisconnected;
+
+  return graph_->WeightOfEdge(start, dest);
+}
+
+template <typename Container>
+template <typename Visitor>
+void SubgraphView<Container>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(start))
+    return;
+
+  graph_->ForEachOut(start, [&](index_t dest, weight_t weight) {
+    if (HasVertex(dest))
+      visit(dest, weight);
+  });
+}
+
+template <typename Container>
+template <typename Visitor>
+void SubgraphView<Container>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  if (!HasVertex(dest))
+    return;
+
+  graph_->ForEachIn(dest, [&](index_t start, weight_t weight) {
+    if (HasVertex(start))
+      visit(start, weight);
+  });
+}
+
+template <typename Container>
+bool SubgraphView<Container>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeOut(*this, start, res, append);
+}
+
+template <typename Container>
+bool SubgraphView<Container>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeIn(*this, destination, res, append);
+}
+
+template <typename Container>
+auto SubgraphView<Container>::begin() const noexcept -> typename std::vector<Entry>::const_iterator
+{
+  return ids_.begin();
+}
+
+template <typename Container>
+auto SubgraphView<Container>::end() const noexcept -> typename std::vector<Entry>::const_iterator
+{
+  return ids_.end();
+}
+
+template <bool Directed, typename View, typename Result, typename Register>
+void CopySubgraph(const View &view, Result &result, Register&& add, unsigned threads) noexcept
+{
+  std::vector<index_t> ids;
+  ids.reserve(view.VerticesSize());
+  for (auto &entry : view)
+  {
+    ids.push_back(entry.first);
+    add(result, entry.first);
+  }
+
+  std::vector<std::vector<EdgeDelta>> parts(threads ? threads : DefaultConcurrency());
+  unsigned workers = ParallelFor(0, ids.size(), static_cast<unsigned>(parts.size()),
+                                 [&](unsigned worker, std::size_t first, std::size_t last) {
+    std::vector<EdgeDelta> &part = parts[worker];
+    for (std::size_t i = first; i < last; ++i)
+      view.ForEachOut(ids[i], [&](index_t dest, weight_t weight) {
+        if (Directed || ids[i] <= dest)
+          part.push_back(EdgeDelta{DeltaOperation::INSERT, ids[i], dest, weight});
+      });
+  });
+
+  std::size_t total = 0;
+  for (unsigned worker = 0; worker < workers; ++worker)
+    total += parts[worker].size();
+
+  std::vector<EdgeDelta> delta;
+  delta.reserve(total);
+  for (unsigned worker = 0; worker < workers; ++worker)
+    delta.insert(delta.end(), parts[worker].begin(), parts[worker].end());
+
+  std::vector<std::uint8_t> applied;
+  result.ApplyDelta(delta, applied, threads);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,99 @@
+#include "../transpose_view.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Container>
+TransposeView<Container>::TransposeView(const Container &graph) noexcept: graph_(&graph)
+{
+
+}
+
+template <typename Container>
+const Container &TransposeView<Container>::Source() const noexcept
+{
+  return *graph_;
+}
+
+template <typename Container>
+bool TransposeView<Container>::HasVertex(index_t s) const noexcept
+{
+  return graph_->HasVertex(s);
+}
+
+template <typename Container>
+auto TransposeView<Container>::At(index_t id) const -> std::optional<ValueType>
+{
+  return graph_->At(id);
+}
+
+template <typename Container>
+std::size_t TransposeView<Container>::VerticesSize() const noexcept
+{
+  return graph_->VerticesSize();
+}
+
+template <typename Container>
+std::size_t TransposeView<Container>::OutDegree(index_t s) const noexcept
+{
+  return graph_->InDegree(s);
+}
+
+template <typename Container>
+std::size_t TransposeView<Container>::InDegree(index_t s) const noexcept
+{
+  return graph_->OutDegree(s);
+}
+
+template <typename Container>
+bool TransposeView<Container>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  return graph_->HasEdge(dest, start);
+}
+
+template <typename Container>
+weight_t TransposeView<Container>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  return graph_->WeightOfEdge(dest, start);
+}
+
+template <typename Container>
+template <typename Visitor>
+void TransposeView<Container>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  graph_->ForEachIn(start, std::forward<Visitor>(visit));
+}
+
+template <typename Container>
+template <typename Visitor>
+void TransposeView<Container>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  graph_->ForEachOut(dest, std::forward<Visitor>(visit));
+}
+
+template <typename Container>
+bool TransposeView<Container>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeOut(*this, start, res, append);
+}
+
+template <typename Container>
+bool TransposeView<Container>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeIn(*this, destination, res, append);
+}
+
+template <typename Container>
+decltype(auto) TransposeView<Container>::begin() const noexcept
+{
+  return graph_->begin();
+}
+
+template <typename Container>
+decltype(auto) TransposeView<Container>::end() const noexcept
+{
+  return graph_->end();
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
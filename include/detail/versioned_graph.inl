@@ -0,0 +1,491 @@
+#include "../versioned_graph.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphVersion<Ty,Weighted,Directed>::Find(index_t id) const noexcept -> const Node *
+{
+  std::size_t chunk = id >> kChunkBits;
+  if (chunk >= chunks_.size() || !chunks_[chunk])
+    return nullptr;
+
+  return chunks_[chunk]->nodes_[id & (kChunkSize - 1)].get();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+GraphSnapshot<Ty,Weighted,Directed>::Iterator::Iterator(const Version *version, std::size_t id) noexcept:
+    version_(version), id_(id), entry_{0}
+{
+  Settle();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphSnapshot<Ty,Weighted,Directed>::Iterator::operator*() const noexcept -> const Entry &
+{
+  return entry_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphSnapshot<Ty,Weighted,Directed>::Iterator::operator->() const noexcept -> const Entry *
+{
+  return &entry_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphSnapshot<Ty,Weighted,Directed>::Iterator::operator++() noexcept -> Iterator &
+{
+  ++id_;
+  Settle();
+  return *this;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::Iterator::operator==(const Iterator &rhs) const noexcept
+{
+  return id_ == rhs.id_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::Iterator::operator!=(const Iterator &rhs) const noexcept
+{
+  return id_ != rhs.id_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+void GraphSnapshot<Ty,Weighted,Directed>::Iterator::Settle() noexcept
+{
+  const std::size_t last = version_->chunks_.size() << Version::kChunkBits;
+  while (id_ < last)
+  {
+    const auto &chunk = version_->chunks_[id_ >> Version::kChunkBits];
+    if (!chunk || chunk->size_ == 0) {
+      id_ = ((id_ >> Version::kChunkBits) + 1) << Version::kChunkBits;
+      continue;
+    }
+
+    if (chunk->nodes_[id_ & (Version::kChunkSize - 1)]) {
+      entry_.first = static_cast<index_t>(id_);
+      return;
+    }
+    ++id_;
+  }
+  id_ = last;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+GraphSnapshot<Ty,Weighted,Directed>::GraphSnapshot():
+    version_(std::make_shared<Version>())
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+GraphSnapshot<Ty,Weighted,Directed>::GraphSnapshot(std::shared_ptr<Version> version) noexcept:
+    version_(std::move(version))
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::uint64_t GraphSnapshot<Ty,Weighted,Directed>::VersionNumber() const noexcept
+{
+  return version_->number_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::HasVertex(index_t s) const noexcept
+{
+  return version_->Find(s) != nullptr;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::optional<Ty> GraphSnapshot<Ty,Weighted,Directed>::At(index_t id) const
+{
+  if (auto node = version_->Find(id))
+    return node->value_;
+  return std::nullopt;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t GraphSnapshot<Ty,Weighted,Directed>::VerticesSize() const noexcept
+{
+  return version_->vertices_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t GraphSnapshot<Ty,Weighted,Directed>::EdgeSize() const noexcept
+{
+  return version_->arcs_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t GraphSnapshot<Ty,Weighted,Directed>::OutDegree(index_t s) const noexcept
+{
+  auto node = version_->Find(s);
+  return node ? node->out_.Degree() : 0;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t GraphSnapshot<Ty,Weighted,Directed>::InDegree(index_t s) const noexcept
+{
+  auto node = version_->Find(s);
+  if (!node)
+    return 0;
+
+  DIRECTED_GRAPH
+    return node->in_.Degree();
+  ELSE
+    return node->out_.Degree();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+std::size_t GraphSnapshot<Ty,Weighted,Directed>::Degree(index_t s) const noexcept
+{
+  DIRECTED_GRAPH
+    return InDegree(s) + OutDegree(s);
+  ELSE
+    return OutDegree(s);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::HasEdge(index_t start, index_t dest) const noexcept
+{
+  return WEIGHT_CHECK(WeightOfEdge(start, dest));
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+weight_t GraphSnapshot<Ty,Weighted,Directed>::WeightOfEdge(index_t start, index_t dest) const noexcept
+{
+  auto node = version_->Find(start);
+  return node ? node->out_.Find(dest) : kDisconnected;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void GraphSnapshot<Ty,Weighted,Directed>::ForEachOut(index_t start, Visitor&& visit) const noexcept
+{
+  if (auto node = version_->Find(start))
+    node->out_.ForEach(visit);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Visitor>
+void GraphSnapshot<Ty,Weighted,Directed>::ForEachIn(index_t dest, Visitor&& visit) const noexcept
+{
+  auto node = version_->Find(dest);
+  if (!node)
+    return;
+
+  DIRECTED_GRAPH
+    node->in_.ForEach(visit);
+  ELSE
+    node->out_.ForEach(visit);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeOut(*this, start, res, append);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool GraphSnapshot<Ty,Weighted,Directed>::GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append) const noexcept
+{
+  return CollectEdgeIn(*this, destination, res, append);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphSnapshot<Ty,Weighted,Directed>::begin() const noexcept -> Iterator
+{
+  return Iterator(version_.get(), 0);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto GraphSnapshot<Ty,Weighted,Directed>::end() const noexcept -> Iterator
+{
+  return Iterator(version_.get(), version_->chunks_.size() << Version::kChunkBits);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+VersionedGraph<Ty,Weighted,Directed>::VersionedGraph():
+    Base()
+{
+
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Container>
+VersionedGraph<Ty,Weighted,Directed>::VersionedGraph(const Container &graph):
+    Base()
+{
+  for (auto &entry : graph)
+    RegisterVertex(entry.first, *graph.At(entry.first));
+
+  // an undirected edge is inserted once, from its smaller end
+  for (auto &entry : graph)
+  {
+    index_t start = entry.first;
+    graph.ForEachOut(start, [&](index_t dest, weight_t weight) {
+      NON_DIRECTED_GRAPH
+        if (dest < start)
+          return;
+
+      InsertEdge(start, dest, weight);
+    });
+  }
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto VersionedGraph<Ty,Weighted,Directed>::Snapshot() const noexcept -> SnapshotType
+{
+  return SnapshotType(this->version_);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename... Args>
+bool VersionedGraph<Ty,Weighted,Directed>::RegisterVertex(index_t index, Args &&... args) noexcept
+{
+  if (this->HasVertex(index))
+    return false;
+
+  Version &version = Writable();
+  std::size_t position = index >> Version::kChunkBits;
+  if (position >= version.chunks_.size())
+    version.chunks_.resize(position + 1);
+
+  auto &chunk = version.chunks_[position];
+  if (!chunk)
+    chunk = std::make_shared<Chunk>();
+  else if (!Unique(chunk))
+    chunk = std::make_shared<Chunk>(*chunk);
+
+  chunk->nodes_[index & (Version::kChunkSize - 1)] = std::make_shared<Node>(Node{Ty(std::forward<Args>(args)...), {}, {}});
+  ++chunk->size_;
+  ++version.vertices_;
+  ++version.number_;
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool VersionedGraph<Ty,Weighted,Directed>::EraseVertex(index_t index) noexcept
+{
+  Node *node = WritableNode(index);
+  if (!node)
+    return false;
+
+  Version &version = *this->version_;
+
+  // take the arcs out of the rows of the other ends, then drop the vertex with its own rows
+  std::vector<index_t> ends;
+  node->out_.ForEach([&ends](index_t dest, weight_t) { ends.push_back(dest); });
+  for (index_t dest : ends)
+  {
+    if (dest == index)
+      continue;
+
+    Node *other = WritableNode(dest);
+    (Directed ? other->in_ : other->out_).Erase(index);
+    NON_DIRECTED_GRAPH
+      --version.arcs_;
+  }
+  version.arcs_ -= node->out_.Degree();
+
+  DIRECTED_GRAPH_BEGIN
+    ends.clear();
+    node->in_.ForEach([&ends](index_t start, weight_t) { ends.push_back(start); });
+    for (index_t start : ends)
+    {
+      if (start == index)
+        continue;
+
+      WritableNode(start)->out_.Erase(index);
+      --version.arcs_;
+    }
+  DIRECTED_GRAPH_END
+
+  auto &chunk = version.chunks_[index >> Version::kChunkBits];
+  chunk->nodes_[index & (Version::kChunkSize - 1)].reset();
+  --chunk->size_;
+  --version.vertices_;
+  ++version.number_;
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool VersionedGraph<Ty,Weighted,Directed>::InsertEdge(index_t start, index_t dest, weight_t weight) noexcept
+{
+  if (!this->HasVertex(start) || !this->HasVertex(dest))
+    return false;
+
+  NON_WEIGHTED_GRAPH
+    weight = kConnected;
+
+  Node *from = WritableNode(start);
+  bool added = from->out_.Insert(dest, weight);
+  Version &version = *this->version_;
+  version.arcs_ += added;
+
+  DIRECTED_GRAPH
+    WritableNode(dest)->in_.Insert(start, weight);
+
+  NON_DIRECTED_GRAPH_BEGIN
+    if (start != dest) {
+      WritableNode(dest)->out_.Insert(start, weight);
+      version.arcs_ += added;
+    }
+  NON_DIRECTED_GRAPH_END
+
+  ++version.number_;
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool VersionedGraph<Ty,Weighted,Directed>::InsertEdge(const EdgeType &edge) noexcept
+{
+  WEIGHTED_GRAPH
+    return InsertEdge(edge.start_, edge.destination_, edge.weight_);
+  ELSE
+    return InsertEdge(edge.start_, edge.destination_);
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+bool VersionedGraph<Ty,Weighted,Directed>::EraseEdge(index_t start, index_t dest) noexcept
+{
+  if (!this->HasVertex(start) || !this->HasVertex(dest))
+    return false;
+
+  // nothing to erase, and nothing to copy
+  if (!this->HasEdge(start, dest))
+    return true;
+
+  WritableNode(start)->out_.Erase(dest);
+  Version &version = *this->version_;
+  --version.arcs_;
+
+  DIRECTED_GRAPH
+    WritableNode(dest)->in_.Erase(start);
+
+  NON_DIRECTED_GRAPH_BEGIN
+    if (start != dest) {
+      WritableNode(dest)->out_.Erase(start);
+      --version.arcs_;
+    }
+  NON_DIRECTED_GRAPH_END
+
+  ++version.number_;
+  return true;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto VersionedGraph<Ty,Weighted,Directed>::Writable() noexcept -> Version &
+{
+  if (!Unique(this->version_))
+    this->version_ = std::make_shared<Version>(*this->version_);
+  return *this->version_;
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+auto VersionedGraph<Ty,Weighted,Directed>::WritableNode(index_t id) noexcept -> Node *
+{
+  if (!this->HasVertex(id))
+    return nullptr;
+
+  auto &chunk = Writable().chunks_[id >> Version::kChunkBits];
+  if (!Unique(chunk))
+    chunk = std::make_shared<Chunk>(*chunk);
+
+  auto &node = chunk->nodes_[id & (Version::kChunkSize - 1)];
+  if (!Unique(node))
+    node = std::make_shared<Node>(*node);
+  return node.get();
+}
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed>
+template <typename Shared>
+bool VersionedGraph<Ty,Weighted,Directed>::Unique(const std::shared_ptr<Shared> &pointer) noexcept
+{
+  if (pointer.use_count() != 1)
+    return false;
+
+  // the last other owner let go with a release decrement; see its reads before writing over them
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
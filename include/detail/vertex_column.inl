@@ -0,0 +1,169 @@
+#include "../vertex_column.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Ty>
+VertexColumn<Ty>::Iterator::Iterator(const VertexColumn *column, std::size_t id) noexcept:
+    column_(column), id_(id)
+{
+  Settle();
+}
+
+template <typename Ty>
+auto VertexColumn<Ty>::Iterator::operator*() const noexcept -> reference
+{
+  return *entry_;
+}
+
+template <typename Ty>
+auto VertexColumn<Ty>::Iterator::operator->() const noexcept -> pointer
+{
+  return &*entry_;
+}
+
+template <typename Ty>
+auto VertexColumn<Ty>::Iterator::operator++() noexcept -> Iterator &
+{
+  id_ = column_->Next(id_ + 1);
+  Settle();
+  return *this;
+}
+
+template <typename Ty>
+bool VertexColumn<Ty>::Iterator::operator==(const Iterator &rhs) const noexcept
+{
+  return id_ == rhs.id_;
+}
+
+template <typename Ty>
+bool VertexColumn<Ty>::Iterator::operator!=(const Iterator &rhs) const noexcept
+{
+  return id_ != rhs.id_;
+}
+
+template <typename Ty>
+void VertexColumn<Ty>::Iterator::Settle() noexcept
+{
+  entry_.reset();
+  if (id_ < column_->Capacity())
+    entry_.emplace(Entry{static_cast<index_t>(id_), *column_->values_[id_]});
+}
+
+template <typename Ty>
+bool VertexColumn<Ty>::Has(index_t id) const noexcept
+{
+  std::size_t word = id / kWordBits;
+  return word < present_.size() && (present_[word] >> (id % kWordBits) & 1u);
+}
+
+template <typename Ty>
+std::size_t VertexColumn<Ty>::Size() const noexcept
+{
+  return size_;
+}
+
+template <typename Ty>
+const Ty *VertexColumn<Ty>::Find(index_t id) const noexcept
+{
+  return Has(id) ? &*values_[id] : nullptr;
+}
+
+template <typename Ty>
+template <typename... Args>
+bool VertexColumn<Ty>::Emplace(index_t id, Args&&... args)
+{
+  if (Has(id))
+    return false;
+
+  if (id >= values_.size()) {
+    values_.resize(static_cast<std::size_t>(id) + 1);
+    present_.resize(values_.size() / kWordBits + 1, 0);
+  }
+
+  values_[id].emplace(std::forward<Args>(args)...);
+  present_[id / kWordBits] |= std::uint64_t{1} << (id % kWordBits);
+  ++size_;
+  return true;
+}
+
+template <typename Ty>
+template <typename Arg>
+bool VertexColumn<Ty>::Assign(index_t id, Arg&& value)
+{
+  if (!Has(id))
+    return false;
+
+  *values_[id] = std::forward<Arg>(value);
+  return true;
+}
+
+template <typename Ty>
+bool VertexColumn<Ty>::Erase(index_t id) noexcept
+{
+  if (!Has(id))
+    return false;
+
+  present_[id / kWordBits] &= ~(std::uint64_t{1} << (id % kWordBits));
+  values_[id].reset();
+  --size_;
+  return true;
+}
+
+template <typename Ty>
+void VertexColumn<Ty>::Clear() noexcept
+{
+  values_.clear();
+  present_.clear();
+  size_ = 0;
+}
+
+template <typename Ty>
+void VertexColumn<Ty>::Account(MemoryFootprint &usage) const noexcept
+{
+  std::size_t values = 0;
+  AccountVector(values_, values, usage.slack_);
+  usage.payloads_ += size_ * sizeof(Ty);
+  usage.slack_ += values - size_ * sizeof(Ty);
+  AccountVector(present_, usage.vertex_table_, usage.slack_);
+}
+
+template <typename Ty>
+auto VertexColumn<Ty>::begin() const noexcept -> Iterator
+{
+  return Iterator(this, Next(0));
+}
+
+template <typename Ty>
+auto VertexColumn<Ty>::end() const noexcept -> Iterator
+{
+  return Iterator(this, Capacity());
+}
+
+template <typename Ty>
+std::size_t VertexColumn<Ty>::Next(std::size_t id) const noexcept
+{
+  std::size_t word = id / kWordBits;
+  if (word >= present_.size())
+    return Capacity();
+
+  std::uint64_t bits = present_[word] & (~std::uint64_t{0} << (id % kWordBits));
+  while (!bits)
+  {
+    if (++word == present_.size())
+      return Capacity();
+    bits = present_[word];
+  }
+
+  std::size_t next = word * kWordBits + CountTrailingZeros(bits);
+  return next < Capacity() ? next : Capacity();
+}
+
+template <typename Ty>
+std::size_t VertexColumn<Ty>::Capacity() const noexcept
+{
+  return values_.size();
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,43 @@
+#include "../view_edges.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename View, bool Weighted>
+bool CollectEdgeOut(const View &view, index_t start, std::vector<Edge<Weighted>> &res, bool append) noexcept
+{
+  if (!view.HasVertex(start))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  view.ForEachOut(start, [&](index_t dest, weight_t weight) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, dest, weight);
+    ELSE
+      res.emplace_back(start, dest);
+  });
+  return true;
+}
+
+template <typename View, bool Weighted>
+bool CollectEdgeIn(const View &view, index_t destination, std::vector<Edge<Weighted>> &res, bool append) noexcept
+{
+  if (!view.HasVertex(destination))
+    return false;
+
+  if (!append)
+    res.clear();
+
+  view.ForEachIn(destination, [&](index_t start, weight_t weight) {
+    WEIGHTED_GRAPH
+      res.emplace_back(start, destination, weight);
+    ELSE
+      res.emplace_back(start, destination);
+  });
+  return true;
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,263 @@
+#include "../weight_index.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+inline bool WeightedNeighbor::operator<(const WeightedNeighbor &rhs) const noexcept
+{
+  return weight_ != rhs.weight_ ? weight_ < rhs.weight_ : neighbor_ < rhs.neighbor_;
+}
+
+template <bool Directed>
+template <typename Container>
+WeightIndex<Directed>::Update<Container>::Update(WeightIndex *index, const Container &graph) noexcept:
+    index_(index), graph_(graph)
+{
+
+}
+
+template <bool Directed>
+template <typename Container>
+WeightIndex<Directed>::Update<Container>::Update(Update &&rhs) noexcept:
+    index_(rhs.index_), graph_(rhs.graph_), start_(rhs.start_), dest_(rhs.dest_), old_(rhs.old_),
+    arc_(rhs.arc_), all_(rhs.all_), rows_(std::move(rhs.rows_))
+{
+  rhs.index_ = nullptr;
+}
+
+template <bool Directed>
+template <typename Container>
+WeightIndex<Directed>::Update<Container>::~Update()
+{
+  if (!index_)
+    return;
+
+  if (all_) {
+    index_->Build(graph_);
+  } else if (arc_) {
+    auto now = ArcWeight(graph_, start_, dest_);
+    if (now == old_)
+      return;
+
+    Replace(index_->Grow(index_->out_, start_), dest_, old_, now);
+    DIRECTED_GRAPH
+      Replace(index_->Grow(index_->in_, dest_), start_, old_, now);
+    ELSE
+      if (start_ != dest_)
+        Replace(index_->Grow(index_->out_, dest_), start_, old_, now);
+  } else {
+    for (index_t v : rows_)
+      index_->Refresh(graph_, v);
+  }
+}
+
+template <bool Directed>
+bool WeightIndex<Directed>::Enabled() const noexcept
+{
+  return enabled_;
+}
+
+template <bool Directed>
+template <typename Container>
+void WeightIndex<Directed>::Build(const Container &graph)
+{
+  enabled_ = true;
+  out_.clear();
+  in_.clear();
+  for (const auto &entry : graph)
+    Refresh(graph, entry.first);
+}
+
+template <bool Directed>
+void WeightIndex<Directed>::Clear() noexcept
+{
+  enabled_ = false;
+  std::vector<Row>().swap(out_);
+  std::vector<Row>().swap(in_);
+}
+
+template <bool Directed>
+auto WeightIndex<Directed>::RowOf(EdgeDirection direction, index_t v) const noexcept -> const Row *
+{
+  static const Row kEmpty;
+  if (!enabled_)
+    return nullptr;
+
+  const std::vector<Row> &rows = Directed && direction == EdgeDirection::IN ? in_ : out_;
+  return v < rows.size() ? &rows[v] : &kEmpty;
+}
+
+template <bool Directed>
+void WeightIndex<Directed>::Account(MemoryFootprint &usage) const noexcept
+{
+  AccountVector(out_, usage.indices_, usage.slack_);
+  AccountVector(in_, usage.indices_, usage.slack_);
+  for (const auto *rows : {&out_, &in_})
+    for (const Row &row : *rows)
+      AccountVector(row, usage.indices_, usage.slack_);
+}
+
+template <bool Directed>
+const WeightedNeighbor *WeightIndex<Directed>::Extreme(const Row &row, EdgeWeight type) noexcept
+{
+  if (row.empty())
+    return nullptr;
+
+  if (type == EdgeWeight::MIN)
+    return &row.front();
+
+  return &*std::lower_bound(row.begin(), row.end(), WeightedNeighbor{row.back().weight_, 0});
+}
+
+template <bool Directed>
+template <typename Visitor>
+void WeightIndex<Directed>::Select(const Row &row, EdgeWeight type, std::size_t k, Visitor&& visit)
+{
+  k = std::min(k, row.size());
+  if (type == EdgeWeight::MIN) {
+    for (std::size_t i = 0; i < k; ++i)
+      visit(row[i].neighbor_, row[i].weight_);
+    return;
+  }
+
+  // heaviest first, each run of equal weights forwards so ties keep ascending neighbours
+  auto last = row.end();
+  while (k)
+  {
+    auto first = std::lower_bound(row.begin(), last, WeightedNeighbor{last[-1].weight_, 0});
+    for (auto entry = first; entry != last && k; ++entry, --k)
+      visit(entry->neighbor_, entry->weight_);
+    last = first;
+  }
+}
+
+template <bool Directed>
+template <typename ForEach, typename Visitor>
+void WeightIndex<Directed>::SelectScan(ForEach&& for_each, EdgeWeight type, std::size_t k, Visitor&& visit)
+{
+  Row row;
+  for_each([&row](index_t neighbor, weight_t weight) { row.push_back(WeightedNeighbor{weight, neighbor}); });
+
+  k = std::min(k, row.size());
+  auto heavier = [](const WeightedNeighbor &lhs, const WeightedNeighbor &rhs) {
+    return lhs.weight_ != rhs.weight_ ? lhs.weight_ > rhs.weight_ : lhs.neighbor_ < rhs.neighbor_;
+  };
+  if (type == EdgeWeight::MIN)
+    std::partial_sort(row.begin(), row.begin() + k, row.end());
+  else
+    std::partial_sort(row.begin(), row.begin() + k, row.end(), heavier);
+
+  for (std::size_t i = 0; i < k; ++i)
+    visit(row[i].neighbor_, row[i].weight_);
+}
+
+template <bool Directed>
+template <typename Container>
+auto WeightIndex<Directed>::TrackArc(const Container &graph, index_t start, index_t dest) -> Update<Container>
+{
+  Update<Container> update(enabled_ ? this : nullptr, graph);
+  if (enabled_) {
+    update.arc_ = true;
+    update.start_ = start;
+    update.dest_ = dest;
+    update.old_ = ArcWeight(graph, start, dest);
+  }
+  return update;
+}
+
+template <bool Directed>
+template <typename Container, typename Changes>
+auto WeightIndex<Directed>::TrackArcs(const Container &graph, const Changes &changes) -> Update<Container>
+{
+  Update<Container> update(enabled_ ? this : nullptr, graph);
+  if (enabled_) {
+    update.rows_.reserve(2 * changes.size());
+    for (const auto &change : changes)
+    {
+      update.rows_.push_back(change.start_);
+      update.rows_.push_back(change.destination_);
+    }
+    std::sort(update.rows_.begin(), update.rows_.end());
+    update.rows_.erase(std::unique(update.rows_.begin(), update.rows_.end()), update.rows_.end());
+  }
+  return update;
+}
+
+template <bool Directed>
+template <typename Container>
+auto WeightIndex<Directed>::TrackVertex(const Container &graph, index_t v) -> Update<Container>
+{
+  Update<Container> update(enabled_ ? this : nullptr, graph);
+  if (enabled_) {
+    // the rows that mention v are those of its neighbours, read before they go
+    update.rows_.push_back(v);
+    for (EdgeDirection direction : {EdgeDirection::OUT, EdgeDirection::IN})
+      for (const WeightedNeighbor &entry : *RowOf(direction, v))
+        update.rows_.push_back(entry.neighbor_);
+    std::sort(update.rows_.begin(), update.rows_.end());
+    update.rows_.erase(std::unique(update.rows_.begin(), update.rows_.end()), update.rows_.end());
+  }
+  return update;
+}
+
+template <bool Directed>
+template <typename Container>
+auto WeightIndex<Directed>::TrackAll(const Container &graph) -> Update<Container>
+{
+  Update<Container> update(enabled_ ? this : nullptr, graph);
+  update.all_ = enabled_;
+  return update;
+}
+
+template <bool Directed>
+auto WeightIndex<Directed>::Grow(std::vector<Row> &rows, index_t v) -> Row &
+{
+  if (v >= rows.size())
+    rows.resize(static_cast<std::size_t>(v) + 1);
+  return rows[v];
+}
+
+template <bool Directed>
+template <typename Container>
+void WeightIndex<Directed>::Refresh(const Container &graph, index_t v)
+{
+  Row &out = Grow(out_, v);
+  out.clear();
+  if (graph.HasVertex(v))
+    graph.ForEachOut(v, [&out](index_t dest, weight_t weight) { out.push_back(WeightedNeighbor{weight, dest}); });
+  std::sort(out.begin(), out.end());
+
+  DIRECTED_GRAPH_BEGIN
+    Row &in = Grow(in_, v);
+    in.clear();
+    if (graph.HasVertex(v))
+      graph.ForEachIn(v, [&in](index_t start, weight_t weight) { in.push_back(WeightedNeighbor{weight, start}); });
+    std::sort(in.begin(), in.end());
+  DIRECTED_GRAPH_END
+}
+
+template <bool Directed>
+void WeightIndex<Directed>::Replace(Row &row, index_t neighbor, std::optional<weight_t> old, std::optional<weight_t> now)
+{
+  if (old) {
+    auto entry = std::lower_bound(row.begin(), row.end(), WeightedNeighbor{*old, neighbor});
+    if (entry != row.end() && entry->weight_ == *old && entry->neighbor_ == neighbor)
+      row.erase(entry);
+  }
+
+  if (now)
+    row.insert(std::lower_bound(row.begin(), row.end(), WeightedNeighbor{*now, neighbor}), WeightedNeighbor{*now, neighbor});
+}
+
+template <bool Directed>
+template <typename Container>
+std::optional<weight_t> WeightIndex<Directed>::ArcWeight(const Container &graph, index_t start, index_t dest) noexcept
+{
+  if (!graph.HasEdge(start, dest))
+    return std::nullopt;
+
+  return graph.WeightOfEdge(start, dest);
+}
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
@@ -0,0 +1,120 @@
+#ifndef GENERATOR_HPP_
+#define GENERATOR_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "edge.hpp"
+#include "parallel.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+/*  Synthetic edge lists for load tests. Every generator cuts its work into fixed chunks
+ *  that each draw from their own stream derived from the seed, so the output only depends
+ *  on the seed and the arguments, never on the thread count.
+ *  The result feeds Graph / PlainGraph construction directly: PlainGraph<Weighted, false, false> graph(edges).
+ *  Vertex ids are index_t, so a generated graph has at most 65536 vertices.
+ */
+
+struct GeneratorOptions
+{
+  std::uint64_t seed_ = 0;
+  unsigned threads_ = 0;
+  bool directed_ = false;     // ordered pairs for G(n,p) / G(n,m), both directions for grids
+  weight_t min_weight_ = 1;   // weights are drawn uniformly from [min_weight_, max_weight_]
+  weight_t max_weight_ = 100;
+};
+
+// Quadrant probabilities of R-MAT, d = 1 - a - b - c. The defaults are Graph500's.
+struct RMatProbabilities
+{
+  double a_ = 0.57;
+  double b_ = 0.19;
+  double c_ = 0.19;
+};
+
+class SplitMix64
+{
+  /*  SplitMix64 is a small counter-based generator. It is used instead of <random> engines
+   *  and distributions so that a seed gives the same graph with every standard library.
+   */
+public:
+  explicit SplitMix64(std::uint64_t seed) noexcept: state_(seed) {}
+
+  // Independent stream number `stream` of a seed.
+  SplitMix64(std::uint64_t seed, std::uint64_t stream) noexcept: state_(Mix(seed ^ Mix(stream + 1))) {}
+
+  static std::uint64_t Mix(std::uint64_t x) noexcept;
+
+  std::uint64_t Next() noexcept;
+
+  // Uniform in [0, bound), bound > 0.
+  std::uint64_t Below(std::uint64_t bound) noexcept;
+
+  // Uniform in [0, 1).
+  double Real() noexcept;
+
+private:
+  std::uint64_t state_;
+};
+
+/*  R-MAT with 2^scale vertices and exactly `edges` edges. Self-loops and duplicates are kept,
+ *  as in the reference generator.
+ */
+template <bool Weighted>
+bool GenerateRMat(std::size_t scale,
+                  std::size_t edges,
+                  std::vector<Edge<Weighted>> &res,
+                  const GeneratorOptions &options = {},
+                  RMatProbabilities probabilities = {},
+                  bool append = false) noexcept;
+
+// G(n, p): every pair is an edge with probability p, using geometric skips between edges.
+template <bool Weighted>
+bool GenerateGnp(std::size_t vertices,
+                 double probability,
+                 std::vector<Edge<Weighted>> &res,
+                 const GeneratorOptions &options = {},
+                 bool append = false) noexcept;
+
+// G(n, m): exactly `edges` distinct pairs without self-loops, uniform over all such graphs.
+template <bool Weighted>
+bool GenerateGnm(std::size_t vertices,
+                 std::size_t edges,
+                 std::vector<Edge<Weighted>> &res,
+                 const GeneratorOptions &options = {},
+                 bool append = false) noexcept;
+
+/*  rows x columns lattice, vertex r * columns + c linked to its right and lower neighbours.
+ *  Each link is kept with probability `keep`, which thins it into a road-like network.
+ */
+template <bool Weighted>
+bool GenerateGrid(std::size_t rows,
+                  std::size_t columns,
+                  std::vector<Edge<Weighted>> &res,
+                  const GeneratorOptions &options = {},
+                  double keep = 1.0,
+                  bool append = false) noexcept;
+
+/*  Barabasi-Albert preferential attachment: vertex v links to `degree` earlier vertices chosen
+ *  proportionally to their degree. Every edge end is resolved independently by following
+ *  random earlier edge slots, so the edges are generated in parallel. Duplicate edges can occur,
+ *  self-loops of the first vertex are dropped.
+ */
+template <bool Weighted>
+bool GenerateBarabasiAlbert(std::size_t vertices,
+                            std::size_t degree,
+                            std::vector<Edge<Weighted>> &res,
+                            const GeneratorOptions &options = {},
+                            bool append = false) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/generator.inl"
+#endif // GENERATOR_HPP_
@@ -1,77 +1,224 @@
-#ifndef GRAPH_HPP
-#define GRAPH_HPP
-
-#include "algorithm.hpp"
-
-namespace smart_graph {
-
-using smart_graph_impl::Edge;
-using smart_graph_impl::EdgeWeight;
-using smart_graph_impl::index_t;
-using smart_graph_impl::size_t;
-using smart_graph_impl::weight_t;
-
-/* Interface */
-template <typename Ty,
-          bool Weighted = false,
-          bool Directed = false,
-          bool Matrix = true,
-          size_t Size = 0>
-class Graph: public smart_graph_impl::GraphAlgorithm<Ty, Weighted, Directed, Matrix, Size>
-{
-	using Base = smart_graph_impl::GraphAlgorithm<Ty, Weighted, Directed, Matrix, Size>;
-
-	static_assert(!Matrix || (Matrix && Size != 0), "You must appoint a size to the matrix.");
-
-public:
-	using edge_t = Edge<Weighted>;
-
-	Graph():Base() {}
-
-	template <typename... Container>
-	Graph(Container&&... containers);
-
-	Graph(const Graph& rhs);
-
-	Graph(Graph&& rhs):Base(std::forward<Graph>(rhs)) { }
-
-	std::string DebugInfo();
-
-	decltype(auto) GetEdgeType() const noexcept;
-
-private:
-	template <typename HeadContainer, typename... Rest>
-	void Initializer(HeadContainer&& container, Rest&&... rest) noexcept;
-};
-
-template <bool Weighted = false,
-          bool Directed = false,
-          bool Matrix = true,
-          size_t Size = 0
->
-using PlainGraph = Graph<index_t, Weighted, Directed, Matrix, Size>;
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size,
-          typename... Containers>
-decltype(auto) MakePlaingraph(const Graph<Ty, Weighted, Directed, Matrix, Size>& graph, Containers&&... containers);
-
-template <typename Graph,
-		  typename... Vertices>
-decltype(auto) MakeSubgraph(Graph&& source, Vertices&&... index);
-
-template <typename Ty,
-          bool Weighted,
-          bool Directed,
-          bool Matrix,
-          size_t Size,
-          typename... Vertices>
-decltype(auto) MakePlainSubgraph(Graph<Ty, Weighted, Directed, Matrix, Size>& graph, Vertices &&... index);
-
-}  // namespace smart_graph
-
-#include "detail/graph.inl"
-#endif // !GRAPH_HPP
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include "algorithm.hpp"
+#include "backend_estimate.hpp"
+#include "compressed_adjacency.hpp"
+#include "contraction_hierarchy.hpp"
+#include "generator.hpp"
+#include "partition.hpp"
+#include "reorder.hpp"
+#include "sharded_graph.hpp"
+#include "static_graph.hpp"
+#include "subgraph.hpp"
+#include "transpose_view.hpp"
+#include "versioned_graph.hpp"
+
+namespace smart_graph {
+
+using smart_graph_impl::Backend;
+using smart_graph_impl::BackendEstimate;
+using smart_graph_impl::CompactAdjacency;
+using smart_graph_impl::CompressedAdjacency;
+using smart_graph_impl::ContractionHierarchy;
+using smart_graph_impl::DefaultPool;
+using smart_graph_impl::DeltaOperation;
+using smart_graph_impl::distance_t;
+using smart_graph_impl::Edge;
+using smart_graph_impl::EdgeCut;
+using smart_graph_impl::EdgeDelta;
+using smart_graph_impl::EdgeDirection;
+using smart_graph_impl::EdgeWeight;
+using smart_graph_impl::EstimateBackends;
+using smart_graph_impl::GenerateBarabasiAlbert;
+using smart_graph_impl::GenerateGnm;
+using smart_graph_impl::GenerateGnp;
+using smart_graph_impl::GenerateGrid;
+using smart_graph_impl::GenerateRMat;
+using smart_graph_impl::GeneratorOptions;
+using smart_graph_impl::GraphOperation;
+using smart_graph_impl::GraphSnapshot;
+using smart_graph_impl::InProcessTransport;
+using smart_graph_impl::index_t;
+using smart_graph_impl::Instrumentation;
+using smart_graph_impl::InstrumentationSnapshot;
+using smart_graph_impl::kInterleaveWidth;
+using smart_graph_impl::MemoryFootprint;
+using smart_graph_impl::OperationName;
+using smart_graph_impl::OrderVertices;
+using smart_graph_impl::ParallelFor;
+using smart_graph_impl::ParallelForAdaptive;
+using smart_graph_impl::ParallelReduce;
+using smart_graph_impl::PartitionGraph;
+using smart_graph_impl::PartitionMethod;
+using smart_graph_impl::PartitionOptions;
+using smart_graph_impl::RecommendBackend;
+using smart_graph_impl::RelabeledView;
+using smart_graph_impl::RMatProbabilities;
+using smart_graph_impl::RunBsp;
+using smart_graph_impl::RunInterleaved;
+using smart_graph_impl::SetDefaultPool;
+using smart_graph_impl::ShardedGraph;
+using smart_graph_impl::size_t;
+using smart_graph_impl::StaticGraph;
+using smart_graph_impl::SubgraphView;
+using smart_graph_impl::ThreadPool;
+using smart_graph_impl::TransposeView;
+using smart_graph_impl::VersionedGraph;
+using smart_graph_impl::VertexOrder;
+using smart_graph_impl::VertexPartition;
+using smart_graph_impl::VertexPermutation;
+using smart_graph_impl::weight_t;
+
+/* Interface
+ * Matrix = false stores the graph in adjacency lists and Matrix = true in a Size x Size matrix.
+ * Storage, the tag of the container, follows Matrix unless named: HybridGraph names
+ * AdjacentHybridTag, the storage that turns the rows of dense vertices into matrix rows as the
+ * graph fills up.
+ */
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false,
+          bool Matrix = true,
+          size_t Size = 0,
+          typename Storage = smart_graph_impl::DefaultStorage<Matrix>>
+class Graph: public smart_graph_impl::GraphAlgorithm<Ty, Weighted, Directed, Matrix, Size, Storage>
+{
+	using Base = smart_graph_impl::GraphAlgorithm<Ty, Weighted, Directed, Matrix, Size, Storage>;
+
+	static_assert(!Matrix || (Matrix && Size != 0), "You must appoint a size to the matrix.");
+
+public:
+	using edge_t = Edge<Weighted>;
+
+	Graph():Base() {}
+
+	template <typename... Container>
+	Graph(Container&&... containers);
+
+	Graph(const Graph& rhs);
+
+	Graph(Graph&& rhs):Base(std::forward<Graph>(rhs)) { }
+
+	std::string DebugInfo();
+
+	decltype(auto) GetEdgeType() const noexcept;
+
+private:
+	template <typename HeadContainer, typename... Rest>
+	void Initializer(HeadContainer&& container, Rest&&... rest) noexcept;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+using HybridGraph = Graph<Ty, Weighted, Directed, false, 0, smart_graph_impl::AdjacentHybridTag>;
+
+template <bool Weighted = false,
+          bool Directed = false,
+          bool Matrix = true,
+          size_t Size = 0,
+          typename Storage = smart_graph_impl::DefaultStorage<Matrix>
+>
+using PlainGraph = Graph<index_t, Weighted, Directed, Matrix, Size, Storage>;
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename... Containers>
+decltype(auto) MakePlaingraph(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, Containers&&... containers);
+
+template <typename Graph,
+		  typename... Vertices>
+decltype(auto) MakeSubgraph(Graph&& source, Vertices&&... index);
+
+/*  The subgraph induced by a set of vertices known at run time, given as a std::vector<index_t> of
+ *  ids or a std::vector<bool> with a bit per id: the vertices with their values and the edges
+ *  between them, gathered by `threads` workers and inserted as one ApplyDelta batch.
+ */
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename Vertices>
+decltype(auto) MakeInducedSubgraph(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, const Vertices &vertices, unsigned threads = 0);
+
+// The same subgraph as a view reading graph in place, see SubgraphView.
+template <typename Container,
+          typename Vertices>
+decltype(auto) MakeSubgraphView(const Container& graph, const Vertices &vertices);
+
+/*  A graph of the same type with every edge reversed, on which all the algorithms run: a matrix
+ *  is copied and transposed a tile at a time, other storage is rebuilt from a TransposeView in
+ *  one ApplyDelta batch gathered by `threads` workers. Undirected graphs come back as a copy.
+ */
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeTranspose(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, unsigned threads = 0);
+
+// The reversed graph as a view reading graph in place, see TransposeView.
+template <typename Container>
+decltype(auto) MakeTransposeView(const Container& graph);
+
+/*  A graph of the same type whose vertex i is the vertex permutation.OldId(i) of graph, with its
+ *  value and its edges to the other vertices of the permutation, inserted as one ApplyDelta batch.
+ *  Callers holding the old ids translate them with permutation.NewId().
+ */
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeRelabeled(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                             const VertexPermutation &permutation,
+                             unsigned threads = 0);
+
+// Order the vertices of graph with OrderVertices and relabel it; permutation receives the id map.
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeReordered(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                             VertexOrder order,
+                             VertexPermutation &permutation,
+                             unsigned threads = 0);
+
+/*  graph split into `parts` shards by PartitionGraph, each shard a graph of the same type, see
+ *  ShardedGraph. The shards are built by `threads` workers.
+ */
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage>
+decltype(auto) MakeSharded(const Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph,
+                           unsigned parts,
+                           const PartitionOptions &options = {},
+                           unsigned threads = 0);
+
+template <typename Ty,
+          bool Weighted,
+          bool Directed,
+          bool Matrix,
+          size_t Size,
+          typename Storage,
+          typename... Vertices>
+decltype(auto) MakePlainSubgraph(Graph<Ty, Weighted, Directed, Matrix, Size, Storage>& graph, Vertices &&... index);
+
+}  // namespace smart_graph
+
+#include "detail/graph.inl"
+#endif // !GRAPH_HPP
@@ -0,0 +1,179 @@
+#ifndef INSTRUMENTATION_HPP_
+#define INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "define.h"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class GraphOperation {
+  REGISTER_VERTEX,
+  ERASE_VERTEX,
+  INSERT_EDGE,
+  ERASE_EDGE,
+  HAS_EDGE,
+  WEIGHT_OF_EDGE,
+  GET_EDGE_OUT,
+  GET_EDGE_IN,
+  DEGREE,
+  EDGE_SIZE,
+  COUNT
+};
+
+constexpr std::size_t kOperationCount = static_cast<std::size_t>(GraphOperation::COUNT);
+
+const char *OperationName(GraphOperation operation) noexcept;
+
+struct LatencyHistogram
+{
+  /*  Log-linear buckets over nanoseconds in the style of HDR histograms: values below 8 have a
+   *  bucket each, above that every power of two is split into 8 buckets, so a recorded latency
+   *  is known within 12.5% over the whole 64 bit range.
+   */
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr std::size_t kBuckets = (64 - kSubBucketBits + 1) << kSubBucketBits;
+
+  static std::size_t BucketOf(std::uint64_t nanoseconds) noexcept;
+
+  // Largest value that falls into the bucket.
+  static std::uint64_t UpperBoundOf(std::size_t bucket) noexcept;
+
+  std::uint64_t Count() const noexcept;
+
+  // Upper bound of the bucket holding the q-quantile, 0 <= q <= 1; 0 when empty.
+  std::uint64_t Quantile(double q) const noexcept;
+
+  std::array<std::uint64_t, kBuckets> counts_{};
+};
+
+struct OperationStats
+{
+  std::uint64_t calls_ = 0;
+  std::uint64_t total_nanoseconds_ = 0;
+  LatencyHistogram latency_;
+};
+
+struct InstrumentationSnapshot
+{
+  std::array<OperationStats, kOperationCount> operations_;
+  std::uint64_t fetch_hops_ = 0;       // list nodes visited while searching an edge
+  std::uint64_t map_lookups_ = 0;      // searches in the vertex maps
+  std::uint64_t allocations_ = 0;      // edge nodes allocated
+  std::uint64_t allocated_bytes_ = 0;
+};
+
+class NullInstrumentation
+{
+  /*  NullInstrumentation is the default policy: every hook is an empty inline function,
+   *  so the containers compile exactly as without instrumentation.
+   */
+public:
+  static constexpr bool kEnabled = false;
+
+  class Scope
+  {
+  public:
+    explicit Scope(GraphOperation, bool = true) noexcept {}
+  };
+
+  static void CountHops(std::size_t) noexcept {}
+
+  static void CountLookups(std::size_t) noexcept {}
+
+  static void CountAllocation(std::size_t) noexcept {}
+
+  static InstrumentationSnapshot Snapshot() noexcept { return {}; }
+
+  static void Reset() noexcept {}
+};
+
+class CountingInstrumentation
+{
+  /*  CountingInstrumentation gives every thread its own slot of counters and histograms.
+   *  Only the owning thread writes a slot, with relaxed atomics, so recording never locks;
+   *  Snapshot sums all slots under a mutex. Slots of finished threads are handed to new
+   *  threads instead of being freed, so nothing recorded is lost.
+   */
+public:
+  static constexpr bool kEnabled = true;
+
+  // Times one call of an operation; an inactive scope records nothing (used by recursive calls).
+  class Scope
+  {
+  public:
+    explicit Scope(GraphOperation operation, bool active = true) noexcept;
+
+    Scope(const Scope&) = delete;
+
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope();
+
+  private:
+    GraphOperation operation_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  static void CountHops(std::size_t hops) noexcept;
+
+  static void CountLookups(std::size_t lookups) noexcept;
+
+  static void CountAllocation(std::size_t bytes) noexcept;
+
+  static InstrumentationSnapshot Snapshot() noexcept;
+
+  // Counts recorded concurrently with Reset may survive it.
+  static void Reset() noexcept;
+
+private:
+  using Counter = std::atomic<std::uint64_t>;
+
+  struct Slot
+  {
+    std::array<Counter, kOperationCount> calls_{};
+    std::array<Counter, kOperationCount> total_nanoseconds_{};
+    std::array<std::array<Counter, LatencyHistogram::kBuckets>, kOperationCount> latency_{};
+    Counter fetch_hops_{0};
+    Counter map_lookups_{0};
+    Counter allocations_{0};
+    Counter allocated_bytes_{0};
+  };
+
+  struct Registry
+  {
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<Slot*> free_;
+  };
+
+  static Registry &GetRegistry() noexcept;
+
+  static Slot &Local() noexcept;
+
+  static void Add(Counter &counter, std::uint64_t value) noexcept;
+};
+
+/*  The policy every container reports to. Define SMART_GRAPH_INSTRUMENTATION before including
+ *  the library (or on the command line) to record; otherwise all hooks vanish.
+ */
+#ifdef SMART_GRAPH_INSTRUMENTATION
+using Instrumentation = CountingInstrumentation;
+#else
+using Instrumentation = NullInstrumentation;
+#endif
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/instrumentation.inl"
+#endif // INSTRUMENTATION_HPP_
@@ -0,0 +1,31 @@
+#ifndef INTERLEAVE_HPP_
+#define INTERLEAVE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+// Queries in flight at once by default: enough to cover the misses a core keeps outstanding.
+constexpr std::size_t kInterleaveWidth = 16;
+
+// Ask for the cache line holding address ahead of its use; nothing where the compiler has no hint.
+void Prefetch(const void *address) noexcept;
+
+/*  Run count independent queries on the calling thread, written as state machines, with up to
+ *  width of them in flight. start(state, query) sets a slot up for a query and step(state)
+ *  advances it by one dependent load; both return the address the next step of that query will
+ *  read, or nullptr when the query is done. The address is prefetched and the other slots take
+ *  their turn before the query resumes, so the misses of different queries overlap instead of
+ *  being paid one after the other. States are reused from query to query, so buffers they hold
+ *  keep their capacity.
+ */
+template <typename State, typename Start, typename Step>
+void RunInterleaved(std::size_t count, std::size_t width, Start&& start, Step&& step) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/interleave.inl"
+#endif // INTERLEAVE_HPP_
@@ -0,0 +1,130 @@
+#ifndef MAX_FLOW_HPP_
+#define MAX_FLOW_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "compact_adjacency.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+class SparseResidual
+{
+  /*  SparseResidual keeps the residual graph as one flat arc array grouped by tail.
+   *  Every edge u->v adds the arc u->v with its capacity and the arc v->u with 0,
+   *  each holding the index of its partner, so a push updates both in O(1).
+   */
+public:
+  template <bool Weighted>
+  explicit SparseResidual(const CompactAdjacency<Weighted> &adjacency);
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t ArcSize() const noexcept;
+
+  std::size_t Begin(std::size_t v) const noexcept;
+
+  std::size_t End(std::size_t v) const noexcept;
+
+  std::size_t Head(std::size_t v, std::size_t arc) const noexcept;
+
+  distance_t Residual(std::size_t v, std::size_t arc) const noexcept;
+
+  // Residual capacity of the arc going the other way, from Head(v, arc) into v.
+  distance_t ReverseResidual(std::size_t v, std::size_t arc) const noexcept;
+
+  void Push(std::size_t v, std::size_t arc, distance_t amount) noexcept;
+
+private:
+  struct Arc
+  {
+    distance_t residual_;
+    std::size_t reverse_;
+    index_t head_;
+  };
+
+  std::vector<std::size_t> offsets_;
+  std::vector<Arc> arcs_;
+};
+
+template <size_t Size>
+class DenseResidual
+{
+  /*  DenseResidual is a Size x Size residual matrix filled from an adjacent matrix row by row.
+   *  Arcs are addressed by their head, so a vertex scans every column.
+   */
+public:
+  template <typename Matrix>
+  explicit DenseResidual(const Matrix &matrix);
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t ArcSize() const noexcept;
+
+  std::size_t Begin(std::size_t v) const noexcept;
+
+  std::size_t End(std::size_t v) const noexcept;
+
+  std::size_t Head(std::size_t v, std::size_t arc) const noexcept;
+
+  distance_t Residual(std::size_t v, std::size_t arc) const noexcept;
+
+  distance_t ReverseResidual(std::size_t v, std::size_t arc) const noexcept;
+
+  void Push(std::size_t v, std::size_t arc, distance_t amount) noexcept;
+
+private:
+  // c(u, v) + c(v, u) can pass kWeightMax
+  std::vector<int32_t> residual_;
+};
+
+template <typename Network>
+class PushRelabel
+{
+  /*  Highest-label push-relabel, first phase only: it finds the value of a maximum preflow,
+   *  which equals the maximum flow, and the minimum cut, without turning the preflow into a flow.
+   *  Heights are recomputed by a backward BFS from the sink at the start and whenever the
+   *  relabel work passes a multiple of V + E; a height level emptied by a relabel lifts every
+   *  vertex above it out of reach (gap heuristic).
+   */
+public:
+  explicit PushRelabel(Network &network);
+
+  distance_t Run(std::size_t source, std::size_t sink) noexcept;
+
+  // After Run, true for the vertices that can't reach the sink in the residual graph.
+  bool SourceSide(std::size_t v) const noexcept;
+
+private:
+  void GlobalRelabel() noexcept;
+
+  void Discharge(std::size_t v) noexcept;
+
+  void Relabel(std::size_t v) noexcept;
+
+  void Gap(std::size_t level) noexcept;
+
+  void Activate(std::size_t v) noexcept;
+
+  Network &network_;
+  std::size_t n_;
+  std::size_t source_;
+  std::size_t sink_;
+  std::size_t highest_;
+  std::size_t work_;
+  std::vector<std::size_t> height_;
+  std::vector<std::size_t> current_;
+  std::vector<std::size_t> count_;
+  std::vector<distance_t> excess_;
+  std::vector<std::vector<std::size_t>> active_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/max_flow.inl"
+#endif // MAX_FLOW_HPP_
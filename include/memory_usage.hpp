@@ -0,0 +1,41 @@
+#ifndef MEMORY_USAGE_HPP_
+#define MEMORY_USAGE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+struct MemoryFootprint
+{
+  /*  Bytes held by a container, split by role. The figures are computed from the node and
+   *  vector sizes, heap memory owned by the vertex values themselves isn't included.
+   */
+  std::size_t vertex_table_ = 0;  // the container object and the vertex index (map nodes, id arrays)
+  std::size_t adjacency_ = 0;     // out-edges with their weights
+  std::size_t payloads_ = 0;      // vertex values
+  std::size_t indices_ = 0;       // secondary indexes, such as the in-edge lists of directed graphs
+  std::size_t slack_ = 0;         // malloc headers and rounding, unused vector capacity
+
+  std::size_t Total() const noexcept;
+};
+
+// Bytes malloc takes for a request, modelled on glibc: one header word, 16 byte granules, 32 at least.
+constexpr std::size_t AllocationSize(std::size_t bytes) noexcept;
+
+// Bytes of a red-black tree node holding a value: three links and a colour, then the value.
+constexpr std::size_t MapNodeSize(std::size_t value_size, std::size_t value_align) noexcept;
+
+template <typename Value>
+constexpr std::size_t MapNodeSize() noexcept;
+
+// Adds the used bytes of a vector to `category` and its spare capacity and malloc overhead to slack.
+template <typename T>
+void AccountVector(const std::vector<T> &vector, std::size_t &category, std::size_t &slack) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/memory_usage.inl"
+#endif // MEMORY_USAGE_HPP_
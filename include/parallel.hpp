@@ -0,0 +1,136 @@
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+// Tasks of one parallel call; ThreadPool::Wait returns once all of them have run.
+class TaskGroup
+{
+public:
+  std::size_t Pending() const noexcept;
+
+private:
+  friend class ThreadPool;
+
+  std::atomic<std::size_t> pending_{0};
+};
+
+class ThreadPool
+{
+  /*  ThreadPool is the work-stealing scheduler every parallel algorithm of the library runs on.
+   *  Each worker has a deque of tasks: it pushes and pops its own at the back, and an idle
+   *  worker steals from the front of the others, where the oldest tasks are. Threads outside
+   *  the pool share one more deque. Waiting for a TaskGroup runs queued tasks rather than
+   *  blocking, so the waiting thread works as one of the pool's threads and parallel calls
+   *  nested in a task can't deadlock it.
+   */
+public:
+  /*  A pool of threads threads, the thread that waits being one of them, so threads - 1 are
+   *  started; 0 takes the hardware concurrency. With pin, worker i is bound to CPU i (Linux).
+   */
+  explicit ThreadPool(unsigned threads = 0, bool pin = false);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  unsigned Concurrency() const noexcept;
+
+  // Queue func() as a task of group.
+  template <typename Func>
+  void Submit(TaskGroup &group, Func&& func);
+
+  // Run queued tasks until every task of group has finished.
+  void Wait(TaskGroup &group) noexcept;
+
+private:
+  struct Queue
+  {
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+  };
+
+  // The pool and deque of the calling thread, set by the workers of a pool.
+  struct Identity
+  {
+    const ThreadPool *pool_ = nullptr;
+    std::size_t queue_ = 0;
+  };
+
+  static Identity &Current() noexcept;
+
+  // Deque of the calling thread: its own for a worker of this pool, the shared one otherwise.
+  std::size_t Home() const noexcept;
+
+  // Run one task, the newest of home or else the oldest of another deque; false if there was none.
+  bool RunOne(std::size_t home) noexcept;
+
+  void Work(std::size_t home) noexcept;
+
+  static constexpr std::size_t kShared = 0;
+
+  std::vector<std::unique_ptr<Queue>> queues_;    // queues_[0] is shared, queues_[i] belongs to worker i
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+// Hardware threads, at least 1.
+unsigned HardwareConcurrency() noexcept;
+
+/*  The pool parallel algorithms run on, shared by all of them: HardwareConcurrency() threads
+ *  until SetDefaultPool hands another one over. nullptr goes back to the default.
+ */
+std::shared_ptr<ThreadPool> DefaultPool() noexcept;
+
+void SetDefaultPool(std::shared_ptr<ThreadPool> pool) noexcept;
+
+/* Number of workers used by parallel algorithms when the caller doesn't appoint one: the default pool's. */
+unsigned DefaultConcurrency() noexcept;
+
+/*  Split [begin, end) into one contiguous block per worker and run
+ *  func(worker, first, last) on each block. The calling thread runs the first block.
+ *  worker is always below the returned worker count, so callers can index per-worker buffers.
+ *  The blocks are tasks of the default pool, so threads may exceed its threads; blocks must not
+ *  wait for each other.
+ */
+template <typename Func>
+unsigned ParallelFor(std::size_t begin, std::size_t end, unsigned threads, Func&& func) noexcept;
+
+/*  As ParallelFor, but workers take chunks of the range as they get free, each a share of
+ *  what is left, 1 / (2 * threads) of it and at least grain, so chunks shrink as the range
+ *  drains. A few expensive items, like the hubs of a skewed degree distribution, then don't keep
+ *  one worker busy while the others wait. func(worker, first, last) is called once per chunk,
+ *  in no fixed order.
+ */
+template <typename Func>
+unsigned ParallelForAdaptive(std::size_t begin, std::size_t end, unsigned threads, Func&& func, std::size_t grain = 1) noexcept;
+
+/*  combine(identity, map(first, last), ...) over the chunks of ParallelForAdaptive; every worker
+ *  combines its own chunks, and the workers' results are combined in worker order. combine must
+ *  be associative and commutative, since the chunks a worker gets vary from run to run.
+ */
+template <typename T, typename Map, typename Combine>
+T ParallelReduce(std::size_t begin, std::size_t end, unsigned threads, T identity, Map&& map, Combine&& combine, std::size_t grain = 1) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/parallel.inl"
+#endif // PARALLEL_HPP_
@@ -0,0 +1,94 @@
+#ifndef PARTITION_HPP_
+#define PARTITION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "compact_adjacency.hpp"
+#include "edge.hpp"
+#include "generator.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class PartitionMethod {
+  LABEL_PROPAGATION,    // vertices move to the part most of their neighbours are in, within the balance bound
+  MULTILEVEL            // heavy-edge matching down to a small graph, cut there, refined on the way back up
+};
+
+struct PartitionOptions
+{
+  PartitionMethod method_ = PartitionMethod::MULTILEVEL;
+  double imbalance_ = 0.05;   // a part holds at most (1 + imbalance_) * vertices / parts vertices
+  unsigned rounds_ = 8;       // label propagation rounds, refinement passes per level
+  std::uint64_t seed_ = 0;    // order of the matching
+};
+
+class VertexPartition
+{
+  /*  VertexPartition assigns every vertex of a graph to one of Parts() parts, an edge-cut
+   *  partition: a vertex has one owner and the edges between parts are cut.
+   */
+public:
+  static constexpr std::uint32_t kNoPart = UINT32_MAX;
+
+  VertexPartition() = default;
+
+  // part[i] is the part of vertex ids[i].
+  VertexPartition(const std::vector<index_t> &ids, const std::vector<std::uint32_t> &part, unsigned parts);
+
+  unsigned Parts() const noexcept;
+
+  // Part of a vertex, kNoPart for ids the partition doesn't cover.
+  std::uint32_t PartOf(index_t id) const noexcept;
+
+  // Vertices of every part, ascending.
+  const std::vector<index_t> &Members(unsigned part) const noexcept;
+
+private:
+  std::vector<std::uint32_t> parts_;
+  std::vector<std::vector<index_t>> members_;
+};
+
+/*  Split the vertices of graph into `parts` parts of about the same size with few edges between
+ *  them; edge directions are ignored and every edge counts once per direction stored.
+ */
+template <typename Container>
+void PartitionGraph(const Container &graph, unsigned parts, VertexPartition &res, const PartitionOptions &options = {}) noexcept;
+
+// Number of stored arcs whose ends are in different parts.
+template <typename Container>
+std::size_t EdgeCut(const Container &graph, const VertexPartition &partition) noexcept;
+
+struct PartitionLevel
+{
+  /*  One level of the multilevel partitioner: a symmetric CSR graph with vertex weights (the
+   *  vertices of the input merged into each) and edge weights (the arcs merged into each).
+   */
+  std::vector<std::size_t> offsets_;
+  std::vector<std::size_t> targets_;
+  std::vector<std::size_t> edge_weights_;
+  std::vector<std::size_t> vertex_weights_;
+
+  std::size_t VerticesSize() const noexcept;
+
+  // Merge the vertices matched by heavy-edge matching; coarse[v] receives the vertex v became.
+  void Coarsen(SplitMix64 &random, PartitionLevel &res, std::vector<std::size_t> &coarse) const;
+
+  /*  Move vertices of the boundary to the neighbouring part that cuts the fewest edges while
+   *  no part exceeds capacity, `passes` times or until no move helps.
+   */
+  void Refine(std::vector<std::uint32_t> &part, unsigned parts, std::size_t capacity, unsigned passes) const;
+};
+
+// Parts cut from a breadth-first order of the level, each taking its share of the vertex weight.
+void GrowParts(const PartitionLevel &level, unsigned parts, std::vector<std::uint32_t> &part);
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/partition.inl"
+#endif // PARTITION_HPP_
@@ -0,0 +1,130 @@
+#ifndef REORDER_HPP_
+#define REORDER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "compact_adjacency.hpp"
+#include "edge.hpp"
+#include "view_edges.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+enum class VertexOrder {
+  DEGREE,       // by descending degree, hubs first
+  BFS,          // breadth-first from the smallest id of every component
+  DFS,          // depth-first preorder, likewise
+  RCM,          // reverse Cuthill-McKee: breadth-first from a vertex of least degree, lighter neighbours first, reversed
+  COMMUNITY     // communities found by label propagation kept together, breadth-first within each
+};
+
+class VertexPermutation
+{
+  /*  VertexPermutation maps the ids of a graph to the dense ids [0, Size()) of a relabeled copy
+   *  and back. order[i] is the old id that becomes i; ids missing from it have no new id.
+   */
+public:
+  VertexPermutation() = default;
+
+  explicit VertexPermutation(std::vector<index_t> order);
+
+  std::size_t Size() const noexcept;
+
+  std::optional<index_t> NewId(index_t old_id) const noexcept;
+
+  index_t OldId(index_t new_id) const noexcept;
+
+  const std::vector<index_t> &Order() const noexcept;
+
+private:
+  static constexpr std::uint32_t kNoId = UINT32_MAX;
+
+  std::vector<index_t> order_;
+  std::vector<std::uint32_t> new_ids_;
+};
+
+/*  Positions of adjacency in breadth-first order, a new search starting from every root not reached
+ *  yet in turn. With by_degree the neighbours of a vertex are taken by ascending degree.
+ */
+void BreadthFirstOrder(const CompactAdjacency<false> &adjacency,
+                       const std::vector<std::size_t> &roots,
+                       bool by_degree,
+                       std::vector<std::size_t> &res);
+
+// Positions of adjacency in depth-first preorder from the unreached positions in ascending order.
+void DepthFirstOrder(const CompactAdjacency<false> &adjacency, std::vector<std::size_t> &res);
+
+/*  Community of every position by label propagation: each position takes the label most of its
+ *  neighbours hold, the smallest on ties, in rounds until none changes or 16 rounds have passed.
+ */
+void PropagateLabels(const CompactAdjacency<false> &adjacency, std::vector<std::size_t> &labels);
+
+/*  An order of the vertices of graph meant to put neighbours at nearby ids. Edge directions are
+ *  ignored; ties and the roots of the searches go to the smaller id, so the result is deterministic.
+ */
+template <typename Container>
+void OrderVertices(const Container &graph, VertexOrder order, VertexPermutation &res) noexcept;
+
+template <typename Container>
+class RelabeledView
+{
+  /*  RelabeledView is a container renumbered by a permutation, without a copy: vertex i is the
+   *  vertex Order()[i] of the container, if it has one, and edges to vertices the permutation
+   *  leaves out are dropped. Both must outlive the view; MakeRelabeled rebuilds a graph from it.
+   */
+public:
+  using ValueType = typename Container::ValueType;
+  using EdgeType = typename Container::EdgeType;
+
+  // What iterating yields, laid out like a map entry: first is the id.
+  struct Entry
+  {
+    index_t first;
+  };
+
+  RelabeledView(const Container &graph, const VertexPermutation &permutation);
+
+  const VertexPermutation &Permutation() const noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  std::optional<ValueType> At(index_t id) const;
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t OutDegree(index_t s) const noexcept;
+
+  std::size_t InDegree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  template <typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  template <typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  // The vertices in ascending new id order.
+  typename std::vector<Entry>::const_iterator begin() const noexcept;
+
+  typename std::vector<Entry>::const_iterator end() const noexcept;
+
+private:
+  const Container *graph_;
+  const VertexPermutation *permutation_;
+  std::vector<Entry> ids_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/reorder.inl"
+#endif // REORDER_HPP_
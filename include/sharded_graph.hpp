@@ -0,0 +1,90 @@
+#ifndef SHARDED_GRAPH_HPP_
+#define SHARDED_GRAPH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "bsp.hpp"
+#include "edge.hpp"
+#include "parallel.hpp"
+#include "partition.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+// Tentative distance of a vertex, sent to the shard owning it.
+struct DistanceMessage
+{
+  index_t vertex_;
+  distance_t distance_;
+};
+
+template <typename Local>
+class ShardedGraph
+{
+  /*  ShardedGraph splits a graph by a VertexPartition into shards, each a Local container holding
+   *  the vertices of one part, their out-edges, and the far ends of those edges that live in
+   *  other parts as ghost vertices with a copy of their value. A shard thus follows its own edges
+   *  without asking another one; searches run bulk-synchronously, each shard settling what it
+   *  can locally and telling the owners of its ghosts the distances it found for them.
+   */
+public:
+  using ValueType = typename Local::ValueType;
+  using EdgeType = typename Local::EdgeType;
+
+  struct Shard
+  {
+    Local local_;
+    std::vector<index_t> owned_;
+    std::vector<index_t> ghosts_;
+  };
+
+  // Shards are built in parallel; the partition must cover every vertex of graph.
+  template <typename Container>
+  ShardedGraph(const Container &graph, const VertexPartition &partition, unsigned threads = 0);
+
+  unsigned Shards() const noexcept;
+
+  const Shard &ShardAt(unsigned shard) const noexcept;
+
+  const VertexPartition &Partition() const noexcept;
+
+  // The shard holding a vertex as its own, VertexPartition::kNoPart if none does.
+  std::uint32_t OwnerOf(index_t id) const noexcept;
+
+  std::size_t VerticesSize() const noexcept;
+
+  // Ghost copies over all shards.
+  std::size_t GhostsSize() const noexcept;
+
+  /*  Distance from source to every vertex it reaches over out-edges, as ShortestPaths of a
+   *  single graph gives, with one thread per shard exchanging messages through transport.
+   */
+  template <typename Transport>
+  void ShortestPaths(index_t source, std::map<index_t, distance_t> &res, Transport &transport) const noexcept;
+
+  void ShortestPaths(index_t source, std::map<index_t, distance_t> &res) const noexcept;
+
+  // Edges on a shortest path from source to every vertex it reaches, as BreadthFirstLevels gives.
+  template <typename Transport>
+  void BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res, Transport &transport) const noexcept;
+
+  void BreadthFirstLevels(index_t source, std::map<index_t, distance_t> &res) const noexcept;
+
+private:
+  // Bulk-synchronous Dijkstra; unit counts every edge as 1.
+  template <typename Transport>
+  void Relaxation(index_t source, bool unit, std::map<index_t, distance_t> &res, Transport &transport) const noexcept;
+
+  VertexPartition partition_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/sharded_graph.inl"
+#endif // SHARDED_GRAPH_HPP_
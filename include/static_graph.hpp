@@ -0,0 +1,107 @@
+#ifndef STATIC_GRAPH_HPP_
+#define STATIC_GRAPH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <tuple>
+
+#include "edge.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <size_t Size,
+          bool Weighted = false,
+          bool Directed = false>
+class StaticGraph
+{
+  /*  StaticGraph is a graph of the vertices 0 .. Size - 1 kept in a std::array of Size x Size
+   *  cells, with no vertex map and no allocation, and every member constexpr. A topology fixed
+   *  in the source (a state machine, a pipeline of a few dozen stages) is built and queried by
+   *  the compiler, and tables derived from it are baked into the binary:
+   *
+   *    constexpr StaticGraph<4, false, true> kPipeline{{0, 1}, {1, 2}, {1, 3}};
+   *    constexpr auto kOrder = kPipeline.TopologicalOrder();
+   *    static_assert(kOrder && (*kOrder)[0] == 0);
+   *
+   *  The table builders take O(Size^3) steps, within the default limits of constant evaluation
+   *  up to a few dozen vertices.
+   */
+public:
+  using EdgeType = Edge<Weighted>;
+
+  template <typename T>
+  using Table = std::array<std::array<T, Size>, Size>;
+
+  constexpr StaticGraph() noexcept;
+
+  constexpr StaticGraph(std::initializer_list<EdgeType> edges) noexcept;
+
+  constexpr std::size_t VerticesSize() const noexcept;
+
+  constexpr std::size_t EdgeSize() const noexcept;
+
+  constexpr bool HasVertex(index_t s) const noexcept;
+
+  constexpr bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  constexpr weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  // false when an end is out of range; an existing edge takes the new weight.
+  constexpr bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight) noexcept;
+
+  constexpr bool InsertEdge(const EdgeType &edge) noexcept;
+
+  constexpr bool EraseEdge(index_t start, index_t dest) noexcept;
+
+  constexpr std::size_t OutDegree(index_t s) const noexcept;
+
+  constexpr std::size_t InDegree(index_t s) const noexcept;
+
+  constexpr std::size_t Degree(index_t s) const noexcept;
+
+  // Call visit(destination, weight) for every out-edge of start, in ascending destination order.
+  template <typename Visitor>
+  constexpr void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  template <typename Visitor>
+  constexpr void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  /*  The vertices with every edge going forward, the smallest ready id first so the order is
+   *  fixed by the edges alone; empty when there is a cycle.
+   */
+  constexpr std::optional<std::array<index_t, Size>> TopologicalOrder() const noexcept;
+
+  constexpr bool Reaches(index_t start, index_t dest) const noexcept;
+
+  // reach[s][d] when d can be reached from s over one edge or more, by Warshall on 64-bit rows.
+  constexpr Table<bool> Reachability() const noexcept;
+
+  // Distance from source to every vertex, kUnreachable where there is no path: Dijkstra in O(Size^2).
+  constexpr std::array<distance_t, Size> ShortestPaths(index_t source) const noexcept;
+
+  constexpr Table<distance_t> AllPairsShortestPaths() const noexcept;
+
+private:
+  using Cell = std::tuple_element_t<Weighted, std::tuple<bool, weight_t>>;
+
+  static constexpr std::size_t kWords = (Size + 63) / 64;
+
+  static constexpr std::size_t Index(index_t start, index_t dest) noexcept;
+
+  constexpr weight_t Weight(std::size_t cell) const noexcept;
+
+  constexpr void Set(index_t start, index_t dest, weight_t weight) noexcept;
+
+  std::array<Cell, static_cast<std::size_t>(Size) * Size> cells_{};
+  std::size_t edges_ = 0;     // arcs of a directed graph, edges of an undirected one
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/static_graph.inl"
+#endif // STATIC_GRAPH_HPP_
@@ -0,0 +1,91 @@
+#ifndef SUBGRAPH_HPP_
+#define SUBGRAPH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "delta.hpp"
+#include "edge.hpp"
+#include "parallel.hpp"
+#include "view_edges.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Container>
+class SubgraphView
+{
+  /*  SubgraphView is the subgraph of a container induced by a set of vertices, without a copy:
+   *  it keeps a bit per id and forwards every call to the container, dropping the edges that
+   *  leave the set. The container must outlive the view and not change while it is read.
+   *  CompactAdjacency and CompressedAdjacency can be built from a view like from a container.
+   */
+public:
+  using ValueType = typename Container::ValueType;
+  using EdgeType = typename Container::EdgeType;
+
+  // What iterating yields, laid out like a map entry: first is the id.
+  struct Entry
+  {
+    index_t first;
+  };
+
+  // The listed vertices of graph; ids that aren't vertices of it and repeats are ignored.
+  SubgraphView(const Container &graph, const std::vector<index_t> &vertices);
+
+  // The vertices of graph whose bit is set in members.
+  SubgraphView(const Container &graph, const std::vector<bool> &members);
+
+  const Container &Source() const noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  std::optional<ValueType> At(index_t id) const;
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t OutDegree(index_t s) const noexcept;
+
+  std::size_t InDegree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  template <typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  template <typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  // The vertices in ascending id order.
+  typename std::vector<Entry>::const_iterator begin() const noexcept;
+
+  typename std::vector<Entry>::const_iterator end() const noexcept;
+
+private:
+  void Collect() noexcept;
+
+  const Container *graph_;
+  std::vector<bool> members_;     // only ids of vertices of graph_
+  std::vector<Entry> ids_;
+};
+
+/*  Register the vertices of a view in result, an empty container, through add(result, id), then
+ *  insert the edges between them as one ApplyDelta batch. The edges are gathered by `threads`
+ *  workers, an undirected edge from its smaller end only.
+ */
+template <bool Directed, typename View, typename Result, typename Register>
+void CopySubgraph(const View &view, Result &result, Register&& add, unsigned threads = 0) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/subgraph.inl"
+#endif // SUBGRAPH_HPP_
@@ -0,0 +1,68 @@
+#ifndef TRANSPOSE_VIEW_HPP_
+#define TRANSPOSE_VIEW_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "edge.hpp"
+#include "view_edges.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Container>
+class TransposeView
+{
+  /*  TransposeView is a container with every edge reversed, without a copy: out-edges are read
+   *  from the in-edges of the container and the other way round, and an edge query swaps its
+   *  ends. It reads like a container, so it can be copied with CompactAdjacency, viewed with
+   *  SubgraphView or rebuilt into a graph with MakeTranspose. The container must outlive the
+   *  view and not change while it is read.
+   */
+public:
+  using ValueType = typename Container::ValueType;
+  using EdgeType = typename Container::EdgeType;
+
+  explicit TransposeView(const Container &graph) noexcept;
+
+  const Container &Source() const noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  std::optional<ValueType> At(index_t id) const;
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t OutDegree(index_t s) const noexcept;
+
+  std::size_t InDegree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  template <typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  template <typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  // The vertices of the container, in its order.
+  decltype(auto) begin() const noexcept;
+
+  decltype(auto) end() const noexcept;
+
+private:
+  const Container *graph_;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/transpose_view.inl"
+#endif // TRANSPOSE_VIEW_HPP_
@@ -0,0 +1,208 @@
+#ifndef VERSIONED_GRAPH_HPP_
+#define VERSIONED_GRAPH_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "adjacent_hybrid.hpp"
+#include "edge.hpp"
+#include "view_edges.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+struct GraphVersion
+{
+  /*  GraphVersion is the state of a VersionedGraph at one point, shared by every snapshot of it.
+   *  Vertices are grouped by id into chunks of kChunkSize, and a chunk holds a pointer per
+   *  vertex to its value and rows. Versions share the chunks and vertices neither has changed:
+   *  a write after a snapshot copies the table of chunks, then the chunk and the vertices it
+   *  touches, and leaves the rest to both.
+   */
+  static constexpr unsigned kChunkBits = 6;
+  static constexpr std::size_t kChunkSize = std::size_t{1} << kChunkBits;
+
+  struct Node
+  {
+    Ty value_;
+    HybridRow<Weighted> out_;
+    HybridRow<Weighted> in_;    // directed graphs only, undirected rows hold both directions
+  };
+
+  struct Chunk
+  {
+    std::array<std::shared_ptr<Node>, kChunkSize> nodes_;
+    std::size_t size_ = 0;
+  };
+
+  const Node *Find(index_t id) const noexcept;
+
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  std::size_t vertices_ = 0;
+  std::size_t arcs_ = 0;
+  std::uint64_t number_ = 0;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+class GraphSnapshot
+{
+  /*  GraphSnapshot is an immutable graph: the version of a VersionedGraph at the time Snapshot()
+   *  was called, which later writes to the graph don't change. Copying one is O(1), and the
+   *  version is released with its last snapshot. It reads like a container, so it can be copied
+   *  with CompactAdjacency, partitioned, sharded or viewed with SubgraphView. Snapshots can be
+   *  read from any thread while the graph is written.
+   */
+public:
+  using ValueType = Ty;
+  using EdgeType = Edge<Weighted>;
+  using Version = GraphVersion<Ty, Weighted, Directed>;
+
+  // What iterating yields, laid out like a map entry: first is the id.
+  struct Entry
+  {
+    index_t first;
+  };
+
+  // The vertices in ascending id order.
+  class Iterator
+  {
+  public:
+    Iterator(const Version *version, std::size_t id) noexcept;
+
+    const Entry &operator*() const noexcept;
+
+    const Entry *operator->() const noexcept;
+
+    Iterator &operator++() noexcept;
+
+    bool operator==(const Iterator &rhs) const noexcept;
+
+    bool operator!=(const Iterator &rhs) const noexcept;
+
+  private:
+    // Move to the first vertex at id or after it, skipping chunks without any.
+    void Settle() noexcept;
+
+    const Version *version_;
+    std::size_t id_;
+    Entry entry_;
+  };
+
+  GraphSnapshot();
+
+  /*  Goes up with every write to the graph, in place or copied on write, so snapshots of one
+   *  graph with equal numbers hold equal graphs.
+   */
+  std::uint64_t VersionNumber() const noexcept;
+
+  bool HasVertex(index_t s) const noexcept;
+
+  std::optional<Ty> At(index_t id) const;
+
+  std::size_t VerticesSize() const noexcept;
+
+  std::size_t EdgeSize() const noexcept;
+
+  std::size_t OutDegree(index_t s) const noexcept;
+
+  std::size_t InDegree(index_t s) const noexcept;
+
+  std::size_t Degree(index_t s) const noexcept;
+
+  bool HasEdge(index_t start, index_t dest) const noexcept;
+
+  weight_t WeightOfEdge(index_t start, index_t dest) const noexcept;
+
+  // Call visit(destination, weight) for every out-edge of start, in ascending destination order.
+  template <typename Visitor>
+  void ForEachOut(index_t start, Visitor&& visit) const noexcept;
+
+  template <typename Visitor>
+  void ForEachIn(index_t dest, Visitor&& visit) const noexcept;
+
+  bool GetEdgeOut(index_t start, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  bool GetEdgeIn(index_t destination, std::vector<EdgeType> &res, bool append = false) const noexcept;
+
+  Iterator begin() const noexcept;
+
+  Iterator end() const noexcept;
+
+protected:
+  explicit GraphSnapshot(std::shared_ptr<Version> version) noexcept;
+
+  template <typename, bool, bool>
+  friend class VersionedGraph;
+
+  std::shared_ptr<Version> version_;
+};
+
+template <typename Ty,
+          bool Weighted = false,
+          bool Directed = false>
+class VersionedGraph : public GraphSnapshot<Ty, Weighted, Directed>
+{
+  /*  VersionedGraph is a graph that hands out snapshots of itself. Snapshot() is O(1): the
+   *  snapshot keeps the current version, and the graph copies on write whatever it changes
+   *  next, the table of chunks, O(V / 64), then a chunk and a vertex at a time, O(degree) for a
+   *  vertex. Unchanged chunks and vertices stay shared between versions. The writes and
+   *  Snapshot() must come from one thread at a time. Reads of the graph see its latest state.
+   */
+  using Base = GraphSnapshot<Ty, Weighted, Directed>;
+  using Version = typename Base::Version;
+  using Node = typename Version::Node;
+  using Chunk = typename Version::Chunk;
+
+public:
+  using EdgeType = Edge<Weighted>;
+  using SnapshotType = GraphSnapshot<Ty, Weighted, Directed>;
+
+  VersionedGraph();
+
+  // Builds the first version from any container, e.g. a Graph.
+  template <typename Container>
+  explicit VersionedGraph(const Container &graph);
+
+  // The current version, unchanged by any later write.
+  SnapshotType Snapshot() const noexcept;
+
+  template <typename... Args>
+  bool RegisterVertex(index_t index, Args &&... args) noexcept;
+
+  bool EraseVertex(index_t index) noexcept;
+
+  // false when an end doesn't exist; an existing edge takes the new weight.
+  bool InsertEdge(index_t start, index_t dest, weight_t weight = kDefaultWeight) noexcept;
+
+  bool InsertEdge(const EdgeType &edge) noexcept;
+
+  // false when an end doesn't exist, true otherwise, as for the other containers.
+  bool EraseEdge(index_t start, index_t dest) noexcept;
+
+private:
+  // The current version, copied first if a snapshot shares it.
+  Version &Writable() noexcept;
+
+  // The vertex, copied with its chunk where another version shares them; nullptr if it doesn't exist.
+  Node *WritableNode(index_t id) noexcept;
+
+  // Whether this is the only owner, so writing in place can't be seen by a snapshot.
+  template <typename Shared>
+  static bool Unique(const std::shared_ptr<Shared> &pointer) noexcept;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/versioned_graph.inl"
+#endif // VERSIONED_GRAPH_HPP_
@@ -0,0 +1,105 @@
+#ifndef VERTEX_COLUMN_HPP_
+#define VERTEX_COLUMN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include "edge.hpp"
+#include "memory_usage.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+template <typename Ty>
+class VertexColumn
+{
+  /*  VertexColumn keeps the values of the vertices of a container apart from its topology: one
+   *  array indexed by id, and a bit per id telling which slots hold a vertex. Walking the edges
+   *  never loads a value, and reading or replacing one is an array access. Free slots hold no Ty,
+   *  so Ty need not be default constructible and growing the column constructs nothing.
+   */
+public:
+  // What iterating yields, laid out like a map entry: first is the id, second the value.
+  struct Entry
+  {
+    index_t first;
+    const Ty &second;
+  };
+
+  class Iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Entry *;
+    using reference = const Entry &;
+
+    Iterator(const VertexColumn *column, std::size_t id) noexcept;
+
+    reference operator*() const noexcept;
+
+    pointer operator->() const noexcept;
+
+    Iterator &operator++() noexcept;
+
+    bool operator==(const Iterator &rhs) const noexcept;
+
+    bool operator!=(const Iterator &rhs) const noexcept;
+
+  private:
+    void Settle() noexcept;
+
+    const VertexColumn *column_;
+    std::size_t id_;
+    std::optional<Entry> entry_;
+  };
+
+  bool Has(index_t id) const noexcept;
+
+  std::size_t Size() const noexcept;
+
+  // The value of id, nullptr when there is no such vertex.
+  const Ty *Find(index_t id) const noexcept;
+
+  // Construct the value of a new vertex; false, leaving the value alone, if id is taken.
+  template <typename... Args>
+  bool Emplace(index_t id, Args&&... args);
+
+  // Replace the value of an existing vertex.
+  template <typename Arg>
+  bool Assign(index_t id, Arg&& value);
+
+  bool Erase(index_t id) noexcept;
+
+  void Clear() noexcept;
+
+  // Values as payloads_, free slots as slack_, the bits in vertex_table_.
+  void Account(MemoryFootprint &usage) const noexcept;
+
+  // Vertices in ascending id order.
+  Iterator begin() const noexcept;
+
+  Iterator end() const noexcept;
+
+private:
+  static constexpr std::size_t kWordBits = 64;
+
+  // First id at or after id holding a vertex, Capacity() if there is none.
+  std::size_t Next(std::size_t id) const noexcept;
+
+  std::size_t Capacity() const noexcept;
+
+  std::vector<std::optional<Ty>> values_;
+  std::vector<std::uint64_t> present_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/vertex_column.inl"
+#endif // VERTEX_COLUMN_HPP_
@@ -0,0 +1,25 @@
+#ifndef VIEW_EDGES_HPP_
+#define VIEW_EDGES_HPP_
+
+#include <vector>
+
+#include "edge.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+/*  GetEdgeOut and GetEdgeIn of the views and snapshots, which hold no Edge values to copy: the
+ *  edges of a vertex built from view.ForEachOut / view.ForEachIn, in their order. false if the
+ *  vertex isn't in the view; res is cleared first unless append.
+ */
+template <typename View, bool Weighted>
+bool CollectEdgeOut(const View &view, index_t start, std::vector<Edge<Weighted>> &res, bool append) noexcept;
+
+template <typename View, bool Weighted>
+bool CollectEdgeIn(const View &view, index_t destination, std::vector<Edge<Weighted>> &res, bool append) noexcept;
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/view_edges.inl"
+#endif // VIEW_EDGES_HPP_
@@ -0,0 +1,131 @@
+#ifndef WEIGHT_INDEX_HPP_
+#define WEIGHT_INDEX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "compact_adjacency.hpp"
+#include "edge.hpp"
+#include "memory_usage.hpp"
+
+namespace smart_graph {
+namespace smart_graph_impl {
+
+struct WeightedNeighbor
+{
+  weight_t weight_;
+  index_t neighbor_;
+
+  // By weight, then by neighbour.
+  bool operator<(const WeightedNeighbor &rhs) const noexcept;
+};
+
+template <bool Directed>
+class WeightIndex
+{
+  /*  WeightIndex is an optional secondary index of a container keeping the arcs of every vertex
+   *  sorted by weight, then by neighbour, so the lightest arc is the front of a row, the heaviest
+   *  the back and k of either the k entries next to it. Out-rows hold the out-edges; in-rows the
+   *  in-edges of a directed graph, an undirected graph uses its out-rows both ways.
+   *  A container keeps its index up to date by calling a Track function before each change: the
+   *  Update it returns re-reads the arcs the change may touch once it goes out of scope, after the
+   *  change, and does nothing while the index is off.
+   */
+public:
+  using Row = std::vector<WeightedNeighbor>;
+
+  template <typename Container>
+  class Update
+  {
+  public:
+    Update(WeightIndex *index, const Container &graph) noexcept;
+
+    Update(Update &&rhs) noexcept;
+
+    Update(const Update &) = delete;
+
+    ~Update();
+
+  private:
+    friend class WeightIndex;
+
+    WeightIndex *index_;    // nullptr when there is nothing to do
+    const Container &graph_;
+    index_t start_ = 0;
+    index_t dest_ = 0;
+    std::optional<weight_t> old_;
+    bool arc_ = false;       // one arc, start_ -> dest_, weighing old_ before the change
+    bool all_ = false;       // every row
+    std::vector<index_t> rows_;
+  };
+
+  bool Enabled() const noexcept;
+
+  // Turn the index on, sorting the arcs of every vertex of graph: O(E log degree).
+  template <typename Container>
+  void Build(const Container &graph);
+
+  // Turn the index off and release it.
+  void Clear() noexcept;
+
+  // The row of a vertex, nullptr while the index is off. Ids without arcs have an empty row.
+  const Row *RowOf(EdgeDirection direction, index_t v) const noexcept;
+
+  void Account(MemoryFootprint &usage) const noexcept;
+
+  // What GetEdgeOut(start, type) picks: the lightest arc, or the heaviest with the smallest neighbour.
+  static const WeightedNeighbor *Extreme(const Row &row, EdgeWeight type) noexcept;
+
+  /*  Call visit(neighbor, weight) for the k lightest (MIN) or heaviest (MAX) arcs of a row, in
+   *  that order, equal weights by ascending neighbour: O(k) on a row without ties.
+   */
+  template <typename Visitor>
+  static void Select(const Row &row, EdgeWeight type, std::size_t k, Visitor&& visit);
+
+  // The same over the arcs for_each(emit) passes to emit(neighbor, weight), O(degree log k).
+  template <typename ForEach, typename Visitor>
+  static void SelectScan(ForEach&& for_each, EdgeWeight type, std::size_t k, Visitor&& visit);
+
+  // Before a change of the arc start -> dest.
+  template <typename Container>
+  Update<Container> TrackArc(const Container &graph, index_t start, index_t dest);
+
+  // Before a change of the arcs named by the start_ and destination_ of edges or deltas.
+  template <typename Container, typename Changes>
+  Update<Container> TrackArcs(const Container &graph, const Changes &changes);
+
+  // Before erasing a vertex with its arcs.
+  template <typename Container>
+  Update<Container> TrackVertex(const Container &graph, index_t v);
+
+  // Before a change that may touch any arc.
+  template <typename Container>
+  Update<Container> TrackAll(const Container &graph);
+
+private:
+  Row &Grow(std::vector<Row> &rows, index_t v);
+
+  // Sort the arcs of v again from graph, empty when v is gone.
+  template <typename Container>
+  void Refresh(const Container &graph, index_t v);
+
+  // Move the entry of neighbor in a row from weight old to weight now, either may be absent.
+  static void Replace(Row &row, index_t neighbor, std::optional<weight_t> old, std::optional<weight_t> now);
+
+  // Weight of the arc start -> dest, nullopt if there is none.
+  template <typename Container>
+  static std::optional<weight_t> ArcWeight(const Container &graph, index_t start, index_t dest) noexcept;
+
+  bool enabled_ = false;
+  std::vector<Row> out_;
+  std::vector<Row> in_;     // directed graphs only
+};
+
+}  // namespace smart_graph_impl
+}  // namespace smart_graph
+
+#include "detail/weight_index.inl"
+#endif // WEIGHT_INDEX_HPP_